@@ -53,7 +53,7 @@ static CliResult DebugCompile(
 
         try {
             CommonResources common_resources;
-            CompilerFileSource file_source(file_names[i]);
+            CompilerMappedFileSource file_source(file_names[i]);
             Compiler compiler(common_resources);
 
 #ifdef NJ_VERBOSE
@@ -150,7 +150,7 @@ static CliResult RunFiles(int file_count, const char** file_names) {
 
         try {
             CommonResources common_resources;
-            CompilerFileSource file_source(file_names[i]);
+            CompilerMappedFileSource file_source(file_names[i]);
             Compiler compiler(common_resources);
             Module module;
 
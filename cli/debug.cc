@@ -30,7 +30,8 @@ void DebugPrintLexerToken(const LexerToken& token) {
         break;
     case LexerTokenType::NAME:
     case LexerTokenType::STRING:
-        snprintf(value, kMaxValueLen, "\"%s\"", token.string_const->c_str());
+        snprintf(value, kMaxValueLen, "\"%.*s\"",
+            (int)token.string_const.length, token.string_const.data);
         break;
     default:
         // Indicative of a bug.
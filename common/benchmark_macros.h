@@ -0,0 +1,42 @@
+// Gunderscript-2 Benchmarking Macros
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_BENCHMARK_MACROS__H__
+#define GUNDERSCRIPT_BENCHMARK_MACROS__H__
+
+#include <chrono>
+#include <iostream>
+
+#include "gtest/gtest.h"
+
+// Benchmarks are written as GoogleTest tests so that they share the test
+// runner and can still assert that the work they time produced the right
+// answer. They are built only when the gunderscript_compiler_benchmarks
+// option is enabled and are never part of the regular test runs.
+
+// Runs the statement(s) given as the trailing arguments iterations times,
+// prints the mean wall clock time of a single run, and evaluates to that
+// time in microseconds.
+// name: label printed alongside the result.
+// iterations: number of times to run the statement.
+#define BENCHMARK_RUN(name, iterations, ...)                                \
+([&]() {                                                                    \
+    std::chrono::steady_clock::time_point benchmark_start                   \
+        = std::chrono::steady_clock::now();                                 \
+    for (int benchmark_i = 0; benchmark_i < (iterations); benchmark_i++) {  \
+        __VA_ARGS__;                                                        \
+    }                                                                       \
+    double benchmark_us = std::chrono::duration<double, std::micro>(        \
+        std::chrono::steady_clock::now() - benchmark_start).count()         \
+        / (iterations);                                                     \
+    std::cout << "[ BENCH    ] " << (name) << ": "                         \
+        << benchmark_us << " us/iter" << std::endl;                         \
+    return benchmark_us;                                                    \
+})()
+
+// Prints the ratio between a baseline and an optimized timing.
+#define BENCHMARK_REPORT_SPEEDUP(baseline_us, optimized_us)                 \
+    std::cout << "[ BENCH    ] speedup: "                                   \
+        << ((baseline_us) / (optimized_us)) << "x" << std::endl;
+
+#endif // GUNDERSCRIPT_BENCHMARK_MACROS__H__
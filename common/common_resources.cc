@@ -21,4 +21,28 @@ void CommonResources::set_verbose_asm(bool verbose_asm) {
 }
 #endif // NJ_VERBOSE
 
+bool CommonResources::lazy_parsing() {
+    return this->pimpl().lazy_parsing();
+}
+
+void CommonResources::set_lazy_parsing(bool lazy_parsing) {
+    this->pimpl().set_lazy_parsing(lazy_parsing);
+}
+
+const std::string& CommonResources::entry_point() {
+    return this->pimpl().entry_point();
+}
+
+void CommonResources::set_entry_point(const std::string& entry_point) {
+    this->pimpl().set_entry_point(entry_point);
+}
+
+unsigned int CommonResources::compile_threads() {
+    return this->pimpl().compile_threads();
+}
+
+void CommonResources::set_compile_threads(unsigned int compile_threads) {
+    this->pimpl().set_compile_threads(compile_threads);
+}
+
 } // namespace gunderscript
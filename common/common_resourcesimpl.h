@@ -4,6 +4,8 @@
 #ifndef GUNDERSCRIPT_COMMON_RESOURCESIMPL__H__
 #define GUNDERSCRIPT_COMMON_RESOURCESIMPL__H__
 
+#include <string>
+
 #include "nanojit.h"
 
 #include "gunderscript/common_resources.h"
@@ -19,6 +21,23 @@ public:
     Allocator& alloc() { return alloc_; }
     Config& config() { return config_; }
 
+    // If true, the compiler only parses the bodies of the functions that can
+    // be reached from the script's entry point. The others are still declared
+    // and checked, but running one of them from the host throws
+    // STATUS_UNPARSED_FUNCTION.
+    bool lazy_parsing() { return lazy_parsing_; }
+    void set_lazy_parsing(bool lazy_parsing) { this->lazy_parsing_ = lazy_parsing; }
+
+    // Name of the function that scripts start executing from. Defaults to
+    // "main".
+    const std::string& entry_point() { return entry_point_; }
+    void set_entry_point(const std::string& entry_point) { this->entry_point_ = entry_point; }
+
+    // Number of threads the compiler may use, or 0 for one per hardware
+    // thread. Defaults to 1, which compiles serially on the calling thread.
+    unsigned int compile_threads() { return compile_threads_; }
+    void set_compile_threads(unsigned int compile_threads) { this->compile_threads_ = compile_threads; }
+
 #ifdef NJ_VERBOSE
     bool verbose_asm() { return verbose_asm_; }
     void set_verbose_asm(bool verbose_asm) { this->verbose_asm_ = verbose_asm; }
@@ -27,6 +46,9 @@ public:
 private:
     Allocator alloc_;
     Config config_;
+    bool lazy_parsing_ = false;
+    std::string entry_point_ = "main";
+    unsigned int compile_threads_ = 1;
 
 #ifdef NJ_VERBOSE
     bool verbose_asm_ = false;
@@ -41,4 +41,19 @@ ModuleImpl::ModuleImpl()
     symbols_vector_(new std::vector<ModuleImplSymbol>(), std::default_delete<std::vector<ModuleImplSymbol>>()) {
 }
 
+// Discards everything that was compiled into the module so far, leaving it
+// as it was when it was created so that it may be compiled again.
+void ModuleImpl::Reset() {
+    this->compiled_ = false;
+    this->assembled_ = false;
+    this->module_name_.clear();
+
+    // The symbols' fragments go before the Allocators holding their LIR and
+    // the CodeAlloc holding their code.
+    this->symbols_vector_->clear();
+    this->allocs_.clear();
+    this->code_alloc_.reset();
+    this->func_table_.reset();
+}
+
 } // namespace gunderscript
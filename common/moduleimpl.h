@@ -24,17 +24,22 @@ typedef void(*ModuleFunc)();
 // and the NanoJIT code fragment implementing it.
 class ModuleImplSymbol {
 public:
-    ModuleImplSymbol(const std::string& symbol_name, const SymbolBase* symbol, Fragment* fragment)
-        : symbol_name_(symbol_name), symbol_(symbol), fragment_(fragment) { }
+    ModuleImplSymbol(const std::string& symbol_name, const SymbolBase* symbol, Fragment* fragment, bool parsed)
+        : symbol_name_(symbol_name), symbol_(symbol), fragment_(fragment), parsed_(parsed) { }
 
     const std::string& symbol_name() const { return symbol_name_; }
     const SymbolBase* symbol() const { return symbol_.get(); }
     Fragment* fragment() { return fragment_.get(); }
 
+    // False if the function's body was skipped by lazy parsing, in which case
+    // its fragment is an empty body that must never be run.
+    bool parsed() const { return parsed_; }
+
 private:
     const std::string symbol_name_;
     std::unique_ptr<const SymbolBase> symbol_;
     std::unique_ptr<Fragment> fragment_;
+    bool parsed_;
 };
 
 // Module Private Implementation.
@@ -50,14 +55,28 @@ public:
     void set_module_name(const std::string& module_name) { module_name_ = module_name; }
     std::vector<ModuleImplSymbol>& symbols_vector() const { return *symbols_vector_.get(); }
     ModuleFunc* func_table() { return func_table_.get(); }
-    void set_func_table(ModuleFunc* func_table) { func_table_ = std::unique_ptr<ModuleFunc>(func_table); }
+    void set_func_table(ModuleFunc* func_table) { func_table_.reset(func_table); }
+
+    // Takes ownership of an Allocator holding the LIR of some of the module's
+    // functions, which must live until the module is assembled.
+    void AdoptAlloc(Allocator* alloc) { allocs_.push_back(std::unique_ptr<Allocator>(alloc)); }
+
+    // Takes ownership of a CodeAlloc holding the native code of the module's
+    // functions. Modules that a VM assembles keep their code in the VM's.
+    void AdoptCodeAlloc(CodeAlloc* code_alloc) { code_alloc_.reset(code_alloc); }
+
+    void Reset();
 
 private:
     bool compiled_;
     bool assembled_;
     std::string module_name_;
+
+    // Declared before the symbols so that their fragments go first.
+    std::unique_ptr<CodeAlloc> code_alloc_;
+    std::vector<std::unique_ptr<Allocator>> allocs_;
     std::unique_ptr<std::vector<ModuleImplSymbol>> symbols_vector_;
-    std::unique_ptr<ModuleFunc> func_table_;
+    std::unique_ptr<ModuleFunc[]> func_table_;
 };
 
 } // namespace gunderscript
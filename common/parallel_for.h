@@ -0,0 +1,60 @@
+// Gunderscript-2 Parallel For Loop
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_PARALLEL_FOR__H__
+#define GUNDERSCRIPT_PARALLEL_FOR__H__
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace gunderscript {
+
+// Gets the number of threads to use for a requested thread count.
+// thread_count: the number of threads, or 0 for one per hardware thread.
+inline unsigned int ParallelThreadCount(unsigned int thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+    }
+
+    return thread_count == 0 ? 1 : thread_count;
+}
+
+// Calls func(worker, index) once for every index in [0, count), spread over
+// up to thread_count worker threads. The calling thread is worker 0, so with
+// one thread everything runs serially in index order. Workers take the next
+// index as they finish the last one, so uneven items balance out, and worker
+// is always less than the thread count so that callers can keep per worker
+// state (e.g.: an arena) in an array. func must not throw. Callers that can
+// fail should catch everything, save a std::exception_ptr for each index, and
+// rethrow them once this returns.
+template <typename Func>
+void ParallelFor(size_t count, unsigned int thread_count, Func func) {
+    std::atomic<size_t> next_index(0);
+    auto worker_loop = [&](unsigned int worker) {
+        for (size_t i = next_index++; i < count; i = next_index++) {
+            func(worker, i);
+        }
+    };
+
+    // Don't start threads that would have nothing to do.
+    if (thread_count > count) {
+        thread_count = count == 0 ? 1 : (unsigned int)count;
+    }
+
+    std::vector<std::thread> threads;
+    for (unsigned int worker = 1; worker < thread_count; worker++) {
+        threads.push_back(std::thread(worker_loop, worker));
+    }
+
+    worker_loop(0);
+
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+}
+
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_PARALLEL_FOR__H__
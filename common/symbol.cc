@@ -0,0 +1,28 @@
+// Gunderscript-2 Symbol Table Symbol
+// (C) 2016 Christian Gunderman
+
+#include "gunderscript/symbol.h"
+
+namespace gunderscript {
+
+// Built in types.
+const TypeSymbol TYPE_NONE(LexerSymbol::PUBLIC, "none"); // TODO: kill this.
+const TypeSymbol TYPE_VOID(SymbolType::TYPE, LexerSymbol::PUBLIC, "void", TypeFormat::FVOID, 0);
+const TypeSymbol TYPE_FUNCTION(LexerSymbol::PUBLIC, "function");
+const TypeSymbol TYPE_BOOL(SymbolType::TYPE, LexerSymbol::PUBLIC, "bool", TypeFormat::BOOL, 4);
+const TypeSymbol TYPE_INT(SymbolType::TYPE, LexerSymbol::PUBLIC, "int32", TypeFormat::INT, 4);
+const TypeSymbol TYPE_FLOAT(SymbolType::TYPE, LexerSymbol::PUBLIC, "float32", TypeFormat::FLOAT, 4);
+const TypeSymbol TYPE_STRING(LexerSymbol::PUBLIC, "string");
+const TypeSymbol TYPE_INT8(SymbolType::TYPE, LexerSymbol::PUBLIC, "int8", TypeFormat::INT, 1);
+
+// Vector of all builtin types.
+const std::vector<const TypeSymbol*> BUILTIN_TYPES = {
+    &TYPE_VOID,
+    &TYPE_BOOL,
+    &TYPE_INT,
+    &TYPE_FLOAT,
+    &TYPE_STRING,
+    &TYPE_INT8
+};
+
+} // namespace gunderscript
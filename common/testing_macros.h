@@ -98,4 +98,38 @@ compiler.Compile(string_source, module);                        \
 VirtualMachine vm(common_resources);                            \
 return vm.HackyRunScriptMainChar(module);                       \
 })()
+
+// Ways of compiling a script that end-to-end tests can check against each other.
+enum class TestCompileMode {
+    // Compile() with the default CommonResources.
+    SERIAL,
+
+    // Compile() with four compile threads.
+    PARALLEL,
+
+    // CompileAndAssemble() into the VirtualMachine that runs the script.
+    COMPILE_AND_ASSEMBLE
+};
+
+// Compiles a whole script in the given mode and runs its main() method that
+// returns INT32 with no arguments.
+inline int CompileAndRunInMode(const std::string& input, TestCompileMode mode) {
+    CommonResources common_resources;
+    common_resources.set_compile_threads(mode == TestCompileMode::PARALLEL ? 4 : 1);
+    std::string source_input(input);
+    CompilerStringSource string_source(source_input);
+    Compiler compiler(common_resources);
+    Module module;
+    VirtualMachine vm(common_resources);
+
+    if (mode == TestCompileMode::COMPILE_AND_ASSEMBLE) {
+        compiler.CompileAndAssemble(string_source, module, vm);
+        EXPECT_TRUE(module.assembled());
+    }
+    else {
+        compiler.Compile(string_source, module);
+    }
+
+    return vm.HackyRunScriptMainInt(module);
+}
 #endif // GUNDERSCRIPT_TESTING_MACROS__H__
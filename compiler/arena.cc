@@ -0,0 +1,78 @@
+// Gunderscript-2 Arena Allocator
+// (C) 2016 Christian Gunderman
+
+#include <cstdint>
+#include <cstring>
+
+#include "gs_assert.h"
+
+#include "arena.h"
+
+namespace gunderscript {
+namespace compiler {
+
+// Constructs an empty arena. No memory is requested until the first
+// allocation.
+// block_size: the size of each block requested from the heap. Allocations
+// larger than this get a block of their own.
+Arena::Arena(size_t block_size)
+    : cursor_(NULL),
+    end_(NULL),
+    block_size_(block_size),
+    bytes_allocated_(0) { }
+
+// Frees every block, and with them every allocation, in one go.
+Arena::~Arena() {
+    Release();
+}
+
+// Frees every block, and with them every allocation, leaving the arena empty
+// and ready to be allocated from again.
+void Arena::Release() {
+    for (size_t i = 0; i < this->blocks_.size(); i++) {
+        delete[] this->blocks_[i];
+    }
+
+    this->blocks_.clear();
+    this->cursor_ = NULL;
+    this->end_ = NULL;
+    this->bytes_allocated_ = 0;
+}
+
+// Allocates size bytes aligned to alignment from the arena.
+// Returns: the allocated memory. It is valid until the arena is destroyed or
+// released.
+void* Arena::Allocate(size_t size, size_t alignment) {
+    GS_ASSERT_TRUE((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+    uintptr_t aligned = ((uintptr_t)this->cursor_ + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+    // Not enough space in the current block. Start a new one large enough
+    // for this allocation, including worst case alignment padding.
+    if (this->cursor_ == NULL || aligned + size > (uintptr_t)this->end_) {
+        size_t new_block_size = size + alignment > this->block_size_ ?
+            size + alignment : this->block_size_;
+        char* block = new char[new_block_size];
+
+        this->blocks_.push_back(block);
+        this->cursor_ = block;
+        this->end_ = block + new_block_size;
+
+        aligned = ((uintptr_t)this->cursor_ + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+
+    this->cursor_ = reinterpret_cast<char*>(aligned + size);
+    this->bytes_allocated_ += size;
+    return reinterpret_cast<void*>(aligned);
+}
+
+// Copies length chars from data into the arena.
+// Returns: the arena copy of the chars. It is NOT null terminated.
+const char* Arena::CopyString(const char* data, size_t length) {
+    char* copy = static_cast<char*>(this->Allocate(length, 1));
+    memcpy(copy, data, length);
+    return copy;
+}
+
+} // namespace compiler
+} // namespace gunderscript
@@ -0,0 +1,45 @@
+// Gunderscript-2 Arena Allocator
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_ARENA__H__
+#define GUNDERSCRIPT_ARENA__H__
+
+#include <cstddef>
+#include <vector>
+
+namespace gunderscript {
+namespace compiler {
+
+// Default size of each block of memory requested by an Arena.
+const size_t kArenaDefaultBlockSize = 64 * 1024;
+
+// Bump pointer allocator for compiler data structures that all share the
+// lifetime of a compilation. Allocations are carved out of large blocks and
+// are never freed individually. Everything is released at once when the
+// Arena is destroyed or Release() is called.
+class Arena {
+public:
+    Arena(size_t block_size = kArenaDefaultBlockSize);
+    ~Arena();
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    const char* CopyString(const char* data, size_t length);
+    void Release();
+    size_t bytes_allocated() const { return this->bytes_allocated_; }
+
+private:
+    std::vector<char*> blocks_;
+    char* cursor_;
+    char* end_;
+    const size_t block_size_;
+    size_t bytes_allocated_;
+
+    // Arenas own raw memory and must not be copied.
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+};
+
+} // namespace compiler
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_ARENA__H__
@@ -0,0 +1,70 @@
+// Gunderscript-2 Reusable Argument Vector Stack
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_ARGUMENT_STACK__H__
+#define GUNDERSCRIPT_ARGUMENT_STACK__H__
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace gunderscript {
+namespace compiler {
+
+// Stack of argument vectors that are reused from one call expression to the
+// next. Each nested call borrows the vector one level above its caller's for
+// as long as an ArgumentStack::Frame is in scope, and leaves its capacity
+// behind for the next call at that depth, so walking calls only allocates
+// when one has more arguments or is nested deeper than any call before it.
+// Not thread safe.
+template <typename T>
+class ArgumentStack {
+public:
+    ArgumentStack() : depth_(0) { }
+
+    // Borrows an empty vector from the top of the stack and returns it when
+    // it goes out of scope, even if an exception is thrown.
+    class Frame {
+    public:
+        explicit Frame(ArgumentStack& stack) : stack_(stack), arguments_(stack.Push()) { }
+        ~Frame() { this->stack_.Pop(); }
+
+        std::vector<T>& arguments() const { return this->arguments_; }
+
+    private:
+        ArgumentStack& stack_;
+        std::vector<T>& arguments_;
+
+        Frame(const Frame&);
+        Frame& operator=(const Frame&);
+    };
+
+    size_t depth() const { return this->depth_; }
+
+private:
+    // A deque never moves its elements when it grows, so a vector stays put
+    // while deeper frames are pushed.
+    std::deque<std::vector<T>> vectors_;
+    size_t depth_;
+
+    std::vector<T>& Push() {
+        if (this->depth_ == this->vectors_.size()) {
+            this->vectors_.emplace_back();
+        }
+
+        std::vector<T>& arguments = this->vectors_[this->depth_++];
+        arguments.clear();
+        return arguments;
+    }
+
+    void Pop() { this->depth_--; }
+
+    // Frames hold references into the stack, so it must not be copied.
+    ArgumentStack(const ArgumentStack&);
+    ArgumentStack& operator=(const ArgumentStack&);
+};
+
+} // namespace compiler
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_ARGUMENT_STACK__H__
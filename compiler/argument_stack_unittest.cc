@@ -0,0 +1,57 @@
+// Gunderscript 2 Argument Stack Unit Test
+// (C) 2016 Christian Gunderman
+
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "argument_stack.h"
+
+using gunderscript::compiler::ArgumentStack;
+
+// Checks that nested frames get distinct vectors that stay put while deeper
+// frames are pushed, and that a frame's vector is reused empty at its depth.
+TEST(ArgumentStack, NestedFrames) {
+    ArgumentStack<int> stack;
+    ASSERT_EQ(0, stack.depth());
+
+    {
+        ArgumentStack<int>::Frame outer(stack);
+        outer.arguments().push_back(1);
+        ASSERT_EQ(1, stack.depth());
+
+        for (int i = 0; i < 100; i++) {
+            ArgumentStack<int>::Frame inner(stack);
+            ASSERT_EQ(2, stack.depth());
+            ASSERT_TRUE(inner.arguments().empty());
+            ASSERT_NE(&outer.arguments(), &inner.arguments());
+
+            inner.arguments().push_back(i);
+            inner.arguments().push_back(i);
+        }
+
+        ASSERT_EQ(1, outer.arguments().size());
+        ASSERT_EQ(1, outer.arguments()[0]);
+    }
+
+    ASSERT_EQ(0, stack.depth());
+
+    ArgumentStack<int>::Frame reused(stack);
+    ASSERT_TRUE(reused.arguments().empty());
+    ASSERT_LE(1, reused.arguments().capacity());
+}
+
+// Checks that a frame is popped when an exception unwinds through it.
+TEST(ArgumentStack, FramePoppedByException) {
+    ArgumentStack<int> stack;
+
+    try {
+        ArgumentStack<int>::Frame frame(stack);
+        frame.arguments().push_back(1);
+        throw std::runtime_error("unwind");
+    }
+    catch (const std::runtime_error&) {
+    }
+
+    ASSERT_EQ(0, stack.depth());
+}
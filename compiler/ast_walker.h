@@ -7,9 +7,14 @@
 #include <string>
 #include <vector>
 
+#include "gunderscript/exceptions.h"
 #include "gunderscript/node.h"
 #include "gunderscript/symbol.h"
 
+#include "argument_stack.h"
+#include "gs_assert.h"
+#include "parser.h"
+
 namespace gunderscript {
 namespace compiler {
 
@@ -26,29 +31,43 @@ enum class PrescanMode {
 };
 
 // Class for walking through the Abstract Syntax Tree Structure.
-template<typename ReturnType>
+// Subclasses pass themselves as Derived (CRTP) and AstWalker calls their Walk
+// methods through a Derived reference, so every node is dispatched with a
+// direct call instead of through a vtable. Subclasses that keep their Walk
+// methods protected must befriend their AstWalker.
+template<typename Derived, typename ReturnType>
 class AstWalker {
 public:
     AstWalker(Node& root) : root_(root) { }
-    virtual ~AstWalker() { }
+    ~AstWalker() { }
 
     void Walk() { WalkModuleChildren(); }
 
+    // Walks the module like Walk(), a piece at a time: first the declarations,
+    // then each of the ImplementationNodes(), in order.
+    void WalkDeclarations() { WalkModuleDeclarationsChildren(); }
+    void WalkImplementation(Node* impl_node);
+    std::vector<Node*> ImplementationNodes() const;
+
 protected:
     Node& root() const { return this->root_; }
 
-    // Mandatory Pure-Virtual (Abstract) methods that MUST be implemented
-    // by child classes:
+    // Walks the module header and the declarations of every spec, function,
+    // and property, but none of the implementations.
+    void WalkModuleDeclarationsChildren();
+
+    // Mandatory methods that MUST be implemented by child classes. These are
+    // never defined, so a subclass that doesn't hide one fails to link:
 
-    virtual void WalkModule(Node* module_node) = 0;
-    virtual void WalkModuleName(Node* name_node) = 0;
-    virtual void WalkModuleDependsName(Node* name_node) = 0;
-    virtual void WalkSpecDeclaration(
+    void WalkModule(Node* module_node);
+    void WalkModuleName(Node* name_node);
+    void WalkModuleDependsName(Node* name_node);
+    void WalkSpecDeclaration(
         Node* spec_node,
         Node* access_modifier_node,
         Node* type_node,
-        bool prescan) = 0;
-    virtual void WalkFunctionDeclaration(
+        bool prescan);
+    void WalkFunctionDeclaration(
         Node* spec_node,
         Node* function_node,
         Node* access_modifier_node,
@@ -56,15 +75,15 @@ protected:
         Node* name_node,
         Node* block_node,
         std::vector<ReturnType>& argument_result,
-        bool prescan) = 0;
-    virtual ReturnType WalkSpecFunctionDeclarationParameter(
+        bool prescan);
+    ReturnType WalkSpecFunctionDeclarationParameter(
         Node* spec_node,
         Node* function_node,
         Node* type_node,
         Node* function_param_node,
         Node* name_node,
-        bool prescan) = 0;
-    virtual void WalkSpecPropertyDeclaration(
+        bool prescan);
+    void WalkSpecPropertyDeclaration(
         Node* spec_node,
         Node* type_node,
         Node* name_node,
@@ -72,236 +91,241 @@ protected:
         Node* set_property_function_node,
         Node* get_access_modifier_node,
         Node* set_access_modifier_node,
-        bool prescan) = 0;
-    virtual ReturnType WalkFunctionCall(
+        bool prescan);
+    ReturnType WalkFunctionCall(
         Node* spec_node,
         Node* name_node,
         Node* call_node,
-        std::vector<ReturnType>& arguments_result) = 0;
-    virtual ReturnType WalkMemberFunctionCall(
+        std::vector<ReturnType>& arguments_result);
+    ReturnType WalkMemberFunctionCall(
         Node* spec_node,
         Node* member_node,
         ReturnType left_result,
         Node* right_node,
-        std::vector<ReturnType>& arguments_result) = 0;
-    virtual ReturnType WalkMemberPropertyGet(
+        std::vector<ReturnType>& arguments_result);
+    ReturnType WalkMemberPropertyGet(
         Node* spec_node,
         Node* member_node,
         ReturnType left_result,
-        Node* right_node) = 0;
-    virtual ReturnType WalkMemberPropertySet(
+        Node* right_node);
+    ReturnType WalkMemberPropertySet(
         Node* spec_node,
         Node* member_node,
         ReturnType left_result,
         Node* right_node,
-        ReturnType value_result) = 0;
-    virtual void WalkIfStatement(
+        ReturnType value_result);
+    void WalkIfStatement(
         Node* spec_node,
         Node* if_node,
-        ReturnType condition_result) = 0;
-    virtual void WalkForStatement(
+        ReturnType condition_result);
+    void WalkForStatement(
         Node* spec_node,
         Node* for_node,
-        ReturnType condition_result) = 0;
-    virtual ReturnType WalkAssign(
+        ReturnType condition_result);
+    ReturnType WalkAssign(
         Node* spec_node,
         Node* name_node,
         Node* symbol_node,
         Node* assign_node,
-        ReturnType operations_result) = 0;
-    virtual ReturnType WalkReturn(
+        ReturnType operations_result);
+    ReturnType WalkReturn(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
         ReturnType* expression_result,
-        std::vector<ReturnType>* arguments_result) = 0;
-    virtual ReturnType WalkAdd(
+        std::vector<ReturnType>* arguments_result);
+    ReturnType WalkAdd(
         Node* spec_node,
         Node* add_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkSub(
+        ReturnType right_result);
+    ReturnType WalkSub(
         Node* spec_node,
         Node* sub_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkMul(
+        ReturnType right_result);
+    ReturnType WalkMul(
         Node* spec_node,
         Node* mul_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkDiv(
+        ReturnType right_result);
+    ReturnType WalkDiv(
         Node* spec_node,
         Node* div_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkMod(
+        ReturnType right_result);
+    ReturnType WalkMod(
         Node* spec_node,
         Node* mod_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkLogAnd(
+        ReturnType right_result);
+    ReturnType WalkLogAnd(
         Node* spec_node,
         Node* log_and_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkLogOr(
+        ReturnType right_result);
+    ReturnType WalkLogOr(
         Node* spec_node,
         Node* log_or_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkLogNot(
+        ReturnType right_result);
+    ReturnType WalkLogNot(
         Node* spec_node,
         Node* log_not_node,
         Node* child_node,
-        ReturnType child_result) = 0;
-    virtual ReturnType WalkGreater(
+        ReturnType child_result);
+    ReturnType WalkGreater(
         Node* spec_node,
         Node* greater_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkEquals(
+        ReturnType right_result);
+    ReturnType WalkEquals(
         Node* spec_node,
         Node* equals_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkNotEquals(
+        ReturnType right_result);
+    ReturnType WalkNotEquals(
         Node* spec_node,
         Node* not_equals_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkLess(
+        ReturnType right_result);
+    ReturnType WalkLess(
         Node* spec_node,
         Node* less_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkGreaterEquals(
+        ReturnType right_result);
+    ReturnType WalkGreaterEquals(
         Node* spec_node,
         Node* greater_equals_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkLessEquals(
+        ReturnType right_result);
+    ReturnType WalkLessEquals(
         Node* spec_node,
         Node* less_equals_node,
         Node* left_node,
         Node* right_node,
         ReturnType left_result,
-        ReturnType right_result) = 0;
-    virtual ReturnType WalkBool(
+        ReturnType right_result);
+    ReturnType WalkBool(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
-        Node* bool_node) = 0;
-    virtual ReturnType WalkInt(
+        Node* bool_node);
+    ReturnType WalkInt(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
-        Node* int_node) = 0;
-    virtual ReturnType WalkFloat(
+        Node* int_node);
+    ReturnType WalkFloat(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
-        Node* float_node) = 0;
-    virtual ReturnType WalkString(
+        Node* float_node);
+    ReturnType WalkString(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
-        Node* string_node) = 0;    
-    virtual ReturnType WalkChar(
+        Node* string_node);
+    ReturnType WalkChar(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
-        Node* char_node) = 0;
-    virtual ReturnType WalkVariable(
+        Node* char_node);
+    ReturnType WalkVariable(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
         Node* variable_node,
-        Node* name_node) = 0;
-    virtual ReturnType WalkAnyType(
+        Node* name_node);
+    ReturnType WalkAnyType(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
-        Node* any_type_node) = 0;
+        Node* any_type_node);
 
     // Optional Implementation methods that are critical for proper operation
-    // of ASTWalker that MAY be optionally overridden by subclasses for increased
+    // of ASTWalker that MAY be optionally hidden by subclasses for increased
     // customization.
-    virtual void WalkSpec(Node* spec_node, PrescanMode scan_mode);
-    virtual void WalkFunctionChildren(
+    void WalkSpec(Node* spec_node, PrescanMode scan_mode);
+    void WalkFunctionChildren(
         Node* spec_node,
         Node* function_node,
         bool prescan);
-    virtual void WalkBlockChildren(
+    void WalkBlockChildren(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
         Node* block,
         std::vector<ReturnType>* arguments_result);
-    virtual ReturnType WalkExpressionChildren(
+    ReturnType WalkExpressionChildren(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
         Node* expression_node);
-    virtual void WalkIfStatementChildren(
+    void WalkIfStatementChildren(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
         Node* if_node,
         std::vector<ReturnType>* arguments_result);
-    virtual void WalkForStatementChildren(
+    void WalkForStatementChildren(
         Node* spec_node,
         Node* function_node,
         Node* property_node,
         PropertyFunction property_function,
         Node* for_node,
         std::vector<ReturnType>* arguments_result);
-    virtual ReturnType WalkNewExpression(
+    ReturnType WalkNewExpression(
         Node* new_node,
         Node* type_node,
-        std::vector<ReturnType>& arguments_result) = 0;
-    virtual ReturnType WalkDefaultExpression(
+        std::vector<ReturnType>& arguments_result);
+    ReturnType WalkDefaultExpression(
         Node* default_node,
-        Node* type_node) = 0;
+        Node* type_node);
 
 private:
     Node& root_;
 
+    // Argument vectors of the calls being walked.
+    ArgumentStack<ReturnType> arguments_;
+
+    Derived& derived() { return static_cast<Derived&>(*this); }
+
     void WalkModuleChildren();
     void WalkModuleDependsChildren(Node* depends_node);
     void WalkModuleSpecsChildren(Node* specs_node, PrescanMode scan_mode);
@@ -374,6 +398,1186 @@ private:
         Node* atomic_node);
 };
 
+// The walk templates are defined here rather than explicitly instantiated
+// in a .cc so that each walker's translation unit sees them and the
+// compiler can inline its Walk methods into the dispatch.
+
+// Walks through all expected children of the MODULE
+// AST node (the root of the AST). Expected children of this
+// node are walked recursively. Unexpected children cause an
+// IllegalStateException indicating that there is a bug.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkModuleChildren() {
+    WalkModuleDeclarationsChildren();
+
+    // Walk implementations.
+    WalkFunctionsChildren(NULL, this->root().child(3));
+    WalkModuleSpecsChildren(this->root().child(2), PrescanMode::SCAN_IMPL_DEF);
+}
+
+// Walks the MODULE node and the declarations of its specs, functions, and
+// properties, leaving the implementations to be walked afterwards.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkModuleDeclarationsChildren() {
+    // We can't have a non-module node as the root.
+    GS_ASSERT_NODE_RULE(&this->root(), NodeRule::MODULE);
+    GS_ASSERT_TRUE(this->root().child_count() == 4, "AstWalker expected 4 nodes in AST root");
+
+    // Call public pure virtual function implemented by child class
+    // to give them a chance to walk/modify the AST.
+    derived().WalkModule(&this->root());
+
+    Node* name_node = this->root().child(0);
+    Node* depends_node = this->root().child(1);
+    Node* specs_node = this->root().child(2);
+    Node* functions_node = this->root().child(3);
+
+    // Check child node types.
+    GS_ASSERT_NODE_RULE(name_node, NodeRule::NAME);
+    GS_ASSERT_NODE_RULE(depends_node, NodeRule::DEPENDS);
+    GS_ASSERT_NODE_RULE(specs_node, NodeRule::SPECS);
+    GS_ASSERT_NODE_RULE(functions_node, NodeRule::FUNCTIONS);
+
+    // Walk children.
+    // In order to allow for circular dependencies between class types, out of order
+    // class dependencies, and calling functions that appear later in the code, the
+    // following calls for functions, properties, and specs must come in a very
+    // particular order.
+    // NOTE: portions of the code generator are heavily dependent upon the assumption
+    // that regardless of the order of prescan, that the actual code gen occurs in
+    // EXACTLY the same order.
+    derived().WalkModuleName(name_node);
+    WalkModuleDependsChildren(depends_node);
+
+    // Prescan spec name/types.
+    WalkModuleSpecsChildren(specs_node, PrescanMode::SCAN_SPEC_DEF);
+
+    // Prescan function name/types.
+    WalkPropertiesFunctionsPrescanChildren(NULL, functions_node, NULL);
+    WalkModuleSpecsChildren(specs_node, PrescanMode::SCAN_PROP_FUNC_DEF);
+}
+
+// Walks all child nodes of the DEPENDS node (nodes that indicate
+// which files this script depends on). Children will all be NAME nodes
+// with the name of another script file.
+// Lists the FUNCTION nodes of the module's functions and then its SPEC
+// nodes, in the order that Walk() walks their implementations.
+template <typename Derived, typename ReturnType>
+std::vector<Node*> AstWalker<Derived, ReturnType>::ImplementationNodes() const {
+    Node* specs_node = this->root().child(2);
+    Node* functions_node = this->root().child(3);
+    std::vector<Node*> impl_nodes;
+
+    impl_nodes.reserve(functions_node->child_count() + specs_node->child_count());
+    for (size_t i = 0; i < functions_node->child_count(); i++) {
+        impl_nodes.push_back(functions_node->child(i));
+    }
+    for (size_t i = 0; i < specs_node->child_count(); i++) {
+        impl_nodes.push_back(specs_node->child(i));
+    }
+
+    return impl_nodes;
+}
+
+// Walks the implementation of a function, or of all of a spec's functions
+// and properties. The declarations must have been walked first.
+// impl_node: one of the nodes listed by ImplementationNodes().
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkImplementation(Node* impl_node) {
+    if (impl_node->rule() == NodeRule::SPEC) {
+        derived().WalkSpec(impl_node, PrescanMode::SCAN_IMPL_DEF);
+    }
+    else {
+        derived().WalkFunctionChildren(NULL, impl_node, false);
+    }
+}
+
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkModuleDependsChildren(Node* depends_node) {
+    GS_ASSERT_NODE_RULE(depends_node, NodeRule::DEPENDS);
+
+    // Iterate through all modules that this modules depends on.
+    for (size_t i = 0; i < depends_node->child_count(); i++) {
+
+        // Check that each node is a NAME node and then walk it.
+        GS_ASSERT_NODE_RULE(depends_node->child(i), NodeRule::NAME);
+        derived().WalkModuleDependsName(depends_node->child(i));
+    }
+}
+
+// Walks all child nodes of the SPECS node (nodes defining the specs/classes
+// defined in this module. This function is a two step process. The first time
+// you call this function, prescan should be true. During prescan, we only
+// evaluate each spec name, not the spec body. Then, call a second time and
+// set prescan to false and we'll only evaluate the body.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkModuleSpecsChildren(Node* specs_node, PrescanMode scan_mode) {
+    GS_ASSERT_NODE_RULE(specs_node, NodeRule::SPECS);
+
+    // Iterate through all specs defined by this module.
+    for (size_t i = 0; i < specs_node->child_count(); i++) {
+
+        // Check that each node is a SPEC node and then walk it.
+        GS_ASSERT_NODE_RULE(specs_node->child(i), NodeRule::SPEC);
+        derived().WalkSpec(specs_node->child(i), scan_mode);
+    }
+}
+
+// Walks a SPEC node and its children recursively defining a 
+// spec.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkSpec(Node* spec_node, PrescanMode scan_mode) {
+
+    GS_ASSERT_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_TRUE(spec_node->child_count() == 4, "AstWalker expects SPEC node to have 4 children");
+
+    Node* access_modifier_node = spec_node->child(0);
+    Node* type_node = spec_node->child(1);
+    Node* functions_node = spec_node->child(2);
+    Node* properties_node = spec_node->child(3);
+
+    GS_ASSERT_NODE_RULE(access_modifier_node, NodeRule::ACCESS_MODIFIER);
+    GS_ASSERT_NODE_RULE(type_node, NodeRule::TYPE);
+    GS_ASSERT_NODE_RULE(functions_node, NodeRule::FUNCTIONS);
+    GS_ASSERT_NODE_RULE(properties_node, NodeRule::PROPERTIES);
+
+    // Spec names are prescanned to allow for out of order and circular dependencies.
+    switch (scan_mode) {
+    case PrescanMode::SCAN_SPEC_DEF:
+        derived().WalkSpecDeclaration(spec_node, access_modifier_node, type_node, true);
+        break;
+    case PrescanMode::SCAN_IMPL_DEF:
+        derived().WalkSpecDeclaration(spec_node, access_modifier_node, type_node, false);
+        WalkFunctionsChildren(spec_node, functions_node);
+        WalkSpecPropertiesChildren(spec_node, properties_node);
+        break;
+    case PrescanMode::SCAN_PROP_FUNC_DEF:
+        derived().WalkSpecDeclaration(spec_node, access_modifier_node, type_node, false);
+        WalkPropertiesFunctionsPrescanChildren(spec_node, functions_node, properties_node);
+        break;
+    default:
+        GS_ASSERT_FAIL("Unhandled case.");
+    }
+}
+
+// Walks the children of the FUNCTION nodes.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkFunctionsChildren(Node* spec_node, Node* functions_node) {
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_NODE_RULE(functions_node, NodeRule::FUNCTIONS);
+
+    // Iterates through all function declarations in the spec,
+    // this time looking only at the function implentation.
+    for (size_t i = 0; i < functions_node->child_count(); i++) {
+        Node* function_node = functions_node->child(i);
+
+        derived().WalkFunctionChildren(spec_node, function_node, false);
+    }
+}
+
+// Walks the children of a FUNCTION node.
+// This function is a two step process: step one has prescan set to true
+// indicating that we wish to only read the function header and declaration.
+// Step two has prescan set to false, indicating that this time we will look
+// at just the implementation. Breaking this process into two steps allows
+// for us to call functions out of the order that they appear in the AST.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkFunctionChildren(
+    Node* spec_node,
+    Node* function_node, 
+    bool prescan) {
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_TRUE(function_node->child_count() == 5, "AstWalker expects FUNCTION to have 5 children");
+
+    // Get function attribute objects.
+    Node* access_modifier_node = function_node->child(0);
+    Node* type_node = function_node->child(1);
+    Node* name_node = function_node->child(2);
+    Node* function_params_node = function_node->child(3);
+    Node* block_node = function_node->child(4);
+
+    // Naively check the node rules for basic troubleshooting.
+    GS_ASSERT_NODE_RULE(access_modifier_node, NodeRule::ACCESS_MODIFIER);
+    GS_ASSERT_NODE_RULE(type_node, NodeRule::TYPE);
+    GS_ASSERT_NODE_RULE(name_node, NodeRule::NAME);
+    GS_ASSERT_NODE_RULE(function_params_node, NodeRule::FUNCTION_PARAMETERS);
+    GS_ASSERT_NODE_RULE(block_node, NodeRule::BLOCK);
+
+    // Dispatch the arguments walker to subclass.
+    typename ArgumentStack<ReturnType>::Frame arguments_frame(this->arguments_);
+    std::vector<ReturnType>& arguments_result = arguments_frame.arguments();
+    WalkFunctionDeclarationParametersChildren(
+        spec_node,
+        function_node,
+        function_params_node,
+        arguments_result,
+        prescan);
+
+    // Dispatch to subclass.
+    derived().WalkFunctionDeclaration(
+        spec_node,
+        function_node,
+        access_modifier_node,
+        type_node,
+        name_node,
+        block_node,
+        arguments_result,
+        prescan);
+
+    // This is the prescan iteration, return without iterating the function body.
+    if (prescan) {
+        return;
+    }
+
+    // Walk the BLOCK node and its children in the block.
+    derived().WalkBlockChildren(
+        spec_node,
+        function_node,
+        NULL,
+        PropertyFunction::NONE,
+        block_node,
+        &arguments_result);
+}
+
+// Walks the Functions and Properties and prescans them so that subclasses
+// that inherit from ASTWalker will have an opportunity to define symbols for
+// functions and properties before walking the function and property bodies.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkPropertiesFunctionsPrescanChildren(
+    Node* spec_node,
+    Node* functions_node,
+    Node* properties_node) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_NODE_RULE(functions_node, NodeRule::FUNCTIONS);
+    GS_ASSERT_OPTIONAL_NODE_RULE(properties_node, NodeRule::PROPERTIES);
+
+    // Iterates through all function declarations in the spec
+    // reading only the function headers and definitions.
+    for (size_t i = 0; i < functions_node->child_count(); i++) {
+        Node* function_node = functions_node->child(i);
+
+        derived().WalkFunctionChildren(spec_node, function_node, true);
+    }
+
+    // Null if we are looking at static functions.
+    if (properties_node != NULL) {
+
+        // Iterate through all properties in the SPEC's PROPERTIES node.
+        for (size_t i = 0; i < properties_node->child_count(); i++) {
+            Node* property_node = properties_node->child(i);
+
+            WalkSpecPropertyChildren(spec_node, property_node, true);
+        }
+    }
+}
+
+// Walks the children of the the FUNCTION_PARAMS node.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkFunctionDeclarationParametersChildren(
+    Node* spec_node,
+    Node* function_node, 
+    Node* function_params_node,
+    std::vector<ReturnType>& argument_result,
+    bool prescan) {
+    
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_NODE_RULE(function_params_node, NodeRule::FUNCTION_PARAMETERS); 
+
+    // Iterate all FUNCTION_PARAMETER nodes in the FUNCTION_PARAMETERS node
+    // and dispatch to subclass function.
+    for (size_t i = 0; i < function_params_node->child_count(); i++) {
+        Node* function_param_node = function_params_node->child(i);
+
+        GS_ASSERT_NODE_RULE(function_param_node, NodeRule::FUNCTION_PARAMETER);
+        GS_ASSERT_TRUE(function_param_node->child_count() == 2,
+            "AstWalker expected FUNCTION to have to children");
+
+        Node* type_node = function_param_node->child(0);
+        Node* name_node = function_param_node->child(1);
+
+        GS_ASSERT_NODE_RULE(type_node, NodeRule::TYPE);
+        GS_ASSERT_NODE_RULE(name_node, NodeRule::NAME);
+
+        argument_result.push_back(
+            derived().WalkSpecFunctionDeclarationParameter(
+                spec_node,
+                function_node, 
+                type_node,
+                function_param_node,
+                name_node,
+                prescan));
+    }
+}
+
+// Walks the children of the PROPERTIES node child of the SPEC node.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkSpecPropertiesChildren(Node* spec_node, Node* properties_node) {
+    GS_ASSERT_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_NODE_RULE(properties_node, NodeRule::PROPERTIES);
+
+    // Iterate through all properties in the SPEC's PROPERTIES node.
+    for (size_t i = 0; i < properties_node->child_count(); i++) {
+        Node* property_node = properties_node->child(i);
+
+        WalkSpecPropertyChildren(spec_node, property_node, false);
+    }
+}
+
+// Walks the children of a single PROPERTY node that represents a SPEC property.
+// This is a two step process: step one, prescan is true, indicating that we are
+// doing an initial run through of the properties, just defining them based upon
+// their signatures. Step two, prescan is false and we walk the property function
+// bodies too. This multistep process allows us to declare symbols for all properties
+// before type checking the bodies, imbuing the properties with awareness of one
+// another regardless of their order in the AST.
+// TODO: complete this.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkSpecPropertyChildren(
+    Node* spec_node,
+    Node* property_node,
+    bool prescan) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
+    GS_ASSERT_TRUE(property_node->child_count() == 4,
+        "AstWalker expects PROPERTY to have 4 children");
+
+    // Get all mandatory child nodes.
+    Node* type_node = property_node->child(0);
+    Node* name_node = property_node->child(1);
+    Node* get_property_function_node = property_node->child(2);
+    Node* set_property_function_node = property_node->child(3);
+    Node* get_access_modifier_node = get_property_function_node->child(0);
+    Node* set_access_modifier_node = set_property_function_node->child(0);
+
+    // Check mandatory child node types.
+    GS_ASSERT_NODE_RULE(type_node, NodeRule::TYPE);
+    GS_ASSERT_NODE_RULE(name_node, NodeRule::NAME);
+    GS_ASSERT_NODE_RULE(get_property_function_node, NodeRule::PROPERTY_FUNCTION);
+    GS_ASSERT_NODE_RULE(set_property_function_node, NodeRule::PROPERTY_FUNCTION);
+    GS_ASSERT_NODE_RULE(get_access_modifier_node, NodeRule::ACCESS_MODIFIER);
+    GS_ASSERT_NODE_RULE(set_access_modifier_node, NodeRule::ACCESS_MODIFIER);
+
+    // Get the property function block nodes if they were provided.
+    // These nodes are optional. If they are not present it implies that the
+    // property is an auto (as opposed to explicit) property.
+    Node* get_block_node = NULL;
+    Node* set_block_node = NULL;
+    if (get_property_function_node->child_count() >= 2) {
+        get_block_node = get_property_function_node->child(1);
+        GS_ASSERT_NODE_RULE(get_block_node, NodeRule::BLOCK);
+    }
+    if (set_property_function_node->child_count() >= 2) {
+        set_block_node = set_property_function_node->child(1);
+        GS_ASSERT_NODE_RULE(set_block_node, NodeRule::BLOCK);
+    }
+
+    // Dispatch to subclass function.
+    derived().WalkSpecPropertyDeclaration(
+        spec_node,
+        type_node,
+        name_node,
+        get_property_function_node,
+        set_property_function_node,
+        get_access_modifier_node,
+        set_access_modifier_node,
+        prescan);
+
+    // This is a prescan, stop after the property declaration.
+    if (prescan) {
+        return;
+    }
+
+    // Walk property function blocks.
+    if (get_block_node != NULL) {
+        derived().WalkBlockChildren(spec_node, NULL, property_node,
+            PropertyFunction::GET, get_block_node, NULL);
+    }
+    if (set_block_node != NULL) {
+        derived().WalkBlockChildren(spec_node, NULL, property_node,
+            PropertyFunction::SET, set_block_node, NULL);
+    }
+}
+
+// Walks the Children of the BLOCK AST nodes.
+// property_function_node can be either a property or a function node.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkBlockChildren(
+    Node* spec_node, 
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* block_node,
+    std::vector<ReturnType>* arguments_result) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
+    GS_ASSERT_NODE_RULE(block_node, NodeRule::BLOCK);
+
+    // Iterate through all statements in the block.
+    for (size_t i = 0; i < block_node->child_count(); i++) {
+        Node* statement_node = block_node->child(i);
+        switch (statement_node->rule())
+        {
+        case NodeRule::CALL:
+            WalkFunctionCallChildren(spec_node, function_node, statement_node);
+            break;
+        case NodeRule::IF:
+            derived().WalkIfStatementChildren(
+                spec_node,
+                function_node,
+                property_node,
+                property_function,
+                statement_node,
+                arguments_result);
+            break;
+        case NodeRule::FOR:
+            derived().WalkForStatementChildren(
+                spec_node,
+                function_node,
+                property_node,
+                property_function,
+                statement_node,
+                arguments_result);
+            break;
+        case NodeRule::ASSIGN:
+            WalkAssignChildren(spec_node, function_node, property_node, property_function, statement_node);
+            break;
+        case NodeRule::RETURN:
+            WalkReturnChildren(
+                spec_node,
+                function_node,
+                property_node,
+                property_function,
+                statement_node,
+                arguments_result);
+            break;
+        case NodeRule::MEMBER:
+            WalkMemberChildren(
+                spec_node,
+                function_node,
+                property_node,
+                property_function,
+                statement_node);
+            break;
+        case NodeRule::BLOCK:
+            derived().WalkBlockChildren(
+                spec_node,
+                function_node,
+                property_node,
+                property_function,
+                statement_node,
+                arguments_result);
+            break;
+        default:
+            GS_ASSERT_FAIL("Unhandled case");
+        }
+    }
+}
+
+// Walks children of Member.Member expressions.
+// e.g.: this.x
+//       this.y()
+template <typename Derived, typename ReturnType>
+ReturnType AstWalker<Derived, ReturnType>::WalkMemberChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* member_node) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_NODE_RULE(member_node, NodeRule::MEMBER);
+
+    ReturnType left_result = WalkSubExpressionChildren(
+        spec_node,
+        function_node,
+        property_node,
+        property_function,
+        member_node->child(0));
+
+    // Dispatch calls to WalkMemberFunctionCall() function, which is analogous to
+    // normal WalkFunctionCall but it changes the name mangling scheme to
+    // map to member functions of the class type stored in the left side
+    // of the expression.
+    switch (member_node->child(1)->rule())
+    {
+    case NodeRule::CALL:
+    {
+        Node* call_node = member_node->child(1);
+        Node* arguments_node = call_node->child(1);
+
+        GS_ASSERT_NODE_RULE(arguments_node, NodeRule::CALL_PARAMETERS);
+
+        typename ArgumentStack<ReturnType>::Frame arguments_frame(this->arguments_);
+        std::vector<ReturnType>& arguments_result = arguments_frame.arguments();
+
+        WalkFunctionCallParametersChildren(
+            spec_node,
+            function_node,
+            arguments_node,
+            arguments_result);
+
+        return derived().WalkMemberFunctionCall(
+            spec_node,
+            member_node,
+            left_result,
+            member_node->child(1),
+            arguments_result);
+    }
+    case NodeRule::SYMBOL:
+        return derived().WalkMemberPropertyGet(
+            spec_node,
+            member_node,
+            left_result,
+            member_node->child(1));
+    }
+
+    GS_ASSERT_FAIL("Unhandled case");
+}
+
+// Populates the arguments_result vector with the results of evaluating
+// a function's arguments.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkFunctionCallParametersChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* arguments_node,
+    std::vector<ReturnType>& arguments_result) {
+
+    GS_ASSERT_NODE_RULE(arguments_node, NodeRule::CALL_PARAMETERS);
+
+    // Iterate through all call param expressions and evaluate their
+    // types.
+    for (size_t i = 0; i < arguments_node->child_count(); i++) {
+        Node* expression_node = arguments_node->child(i);
+
+        // Walk the parameter expressions and add the results
+        // to the params vector.
+        arguments_result.push_back(
+            derived().WalkExpressionChildren(
+                spec_node,
+                function_node,
+                NULL,
+                PropertyFunction::NONE,
+                expression_node));
+    }
+}
+
+// Walks through a CALL Node's children.
+template <typename Derived, typename ReturnType>
+ReturnType AstWalker<Derived, ReturnType>::WalkFunctionCallChildren(
+    Node* spec_node, 
+    Node* function_node, 
+    Node* call_node) {
+    
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_NODE_RULE(call_node, NodeRule::CALL);
+
+    Node* name_node = call_node->child(0);
+    Node* arguments_node = call_node->child(1);
+
+    GS_ASSERT_NODE_RULE(name_node, NodeRule::NAME);
+    GS_ASSERT_NODE_RULE(arguments_node, NodeRule::CALL_PARAMETERS);
+
+    typename ArgumentStack<ReturnType>::Frame arguments_frame(this->arguments_);
+    std::vector<ReturnType>& arguments_result = arguments_frame.arguments();
+
+    WalkFunctionCallParametersChildren(
+        spec_node,
+        function_node,
+        arguments_node,
+        arguments_result);
+
+    // Walk the function call and provide it with the results of our
+    // walk of the arguments.
+    return derived().WalkFunctionCall(spec_node, name_node, call_node, arguments_result);
+}
+
+// Walks through a NEW Node's children.
+template <typename Derived, typename ReturnType>
+ReturnType AstWalker<Derived, ReturnType>::WalkNewExpressionChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* new_node) {
+    GS_ASSERT_NODE_RULE(new_node, NodeRule::NEW);
+
+    Node* type_node = new_node->child(0);
+    Node* arguments_node = new_node->child(1);
+
+    GS_ASSERT_NODE_RULE(type_node, NodeRule::TYPE);
+    GS_ASSERT_NODE_RULE(arguments_node, NodeRule::CALL_PARAMETERS);
+
+    typename ArgumentStack<ReturnType>::Frame arguments_frame(this->arguments_);
+    std::vector<ReturnType>& arguments_result = arguments_frame.arguments();
+
+    WalkFunctionCallParametersChildren(
+        spec_node,
+        function_node,
+        arguments_node,
+        arguments_result);
+
+    // Dispatch to subclass.
+    return derived().WalkNewExpression(new_node, type_node, arguments_result);
+}
+
+// Walks through a DEFAULT Node's children.
+template <typename Derived, typename ReturnType>
+ReturnType AstWalker<Derived, ReturnType>::WalkDefaultExpressionChildren(Node* default_node) {
+    GS_ASSERT_NODE_RULE(default_node, NodeRule::DEFAULT);
+
+    // Type node is required.
+    GS_ASSERT_TRUE(default_node->child_count() == 1, "Missing type node");
+    Node* type_node = default_node->child(0);
+   
+    GS_ASSERT_NODE_RULE(type_node, NodeRule::TYPE);
+
+    // Dispatch to subclass.
+    return derived().WalkDefaultExpression(default_node, type_node);
+}
+
+// Walks through an IF Node's children.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkIfStatementChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* if_node,
+    std::vector<ReturnType>* arguments_result) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
+    GS_ASSERT_NODE_RULE(if_node, NodeRule::IF);
+
+    // Walk condition expression.
+    ReturnType condition_result = derived().WalkExpressionChildren(
+        spec_node,
+        function_node,
+        property_node,
+        property_function,
+        if_node->child(0));
+
+    // Walk true block.
+    // TODO: why is arguments_result passed to this and other block children?????
+    derived().WalkBlockChildren(
+        spec_node,
+        function_node,
+        property_node,
+        property_function,
+        if_node->child(1),
+        arguments_result);
+
+    // Walk false block.
+    derived().WalkBlockChildren(
+        spec_node,
+        function_node,
+        property_node,
+        property_function,
+        if_node->child(2),
+        arguments_result);
+
+    // Dispatch to subclass.
+    derived().WalkIfStatement(spec_node, if_node, condition_result);
+}
+
+// Walks through a FOR Node's children.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkForStatementChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* for_node,
+    std::vector<ReturnType>* arguments_result) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
+    GS_ASSERT_NODE_RULE(for_node, NodeRule::FOR);
+    GS_ASSERT_TRUE(for_node->child_count() == 4, "AstWalker expects FOR to have 4 children");
+
+    // Walk initialize expression.
+    Node* init_node = for_node->child(0);
+    GS_ASSERT_NODE_RULE(init_node, NodeRule::LOOP_INITIALIZE);
+
+    // Init expression is optional.
+    if (init_node->child_count() > 0) {
+        derived().WalkExpressionChildren(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            init_node->child(0));
+    }
+
+    // Walk condition expression.
+    Node* cond_node = for_node->child(1);
+    GS_ASSERT_NODE_RULE(cond_node, NodeRule::LOOP_CONDITION);
+
+    if (cond_node->child_count() > 0) {
+        ReturnType cond_result = derived().WalkExpressionChildren(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            cond_node->child(0));
+
+        // Dispatch to child class.
+        derived().WalkForStatement(
+            spec_node,
+            for_node,
+            cond_result);
+    }
+
+    // Walk update expression.
+    Node* update_node = for_node->child(2);
+    GS_ASSERT_NODE_RULE(update_node, NodeRule::LOOP_UPDATE);
+
+    if (update_node->child_count() > 0) {
+        derived().WalkExpressionChildren(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            update_node->child(0));
+    }
+
+    // Walk for loop condition true block.
+    derived().WalkBlockChildren(
+        spec_node,
+        function_node,
+        property_node,
+        property_function,
+        for_node->child(3),
+        arguments_result);
+}
+
+// Walks through an ASSIGN Node's children.
+template <typename Derived, typename ReturnType>
+ReturnType AstWalker<Derived, ReturnType>::WalkAssignChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* assign_node) {
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_NODE_RULE(assign_node, NodeRule::ASSIGN);
+    GS_ASSERT_TRUE(assign_node->child_count() == 2,
+        "AstWalker expects ASSIGN to have 2 children");
+
+    Node* symbol_node = assign_node->child(0);
+
+    Node* binary_operation_node = assign_node->child(1);
+
+    // Walk the binary operation and obtain the result.
+    ReturnType binary_operation_result = WalkSubExpressionChildren(
+        spec_node,
+        function_node,
+        property_node,
+        property_function,
+        binary_operation_node);
+
+    // Check for and special-case assignment to spec properties.
+    if (symbol_node->rule() == NodeRule::MEMBER) {
+        return derived().WalkMemberPropertySet(
+            spec_node,
+            symbol_node,
+            WalkSubExpressionChildren(
+                spec_node,
+                function_node,
+                property_node,
+                property_function,
+                symbol_node->child(0)),
+            symbol_node->child(1),
+            binary_operation_result);
+    }
+    
+    GS_ASSERT_NODE_RULE(symbol_node, NodeRule::SYMBOL);
+    GS_ASSERT_TRUE(symbol_node->child_count() == 1,
+        "AstWalker expects SYMBOL to have 1 child");
+
+    // OK, so, binary_operation_node is a bit weird. When ASSIGN is used as
+    // a statement you would expect the value being assigned to be an
+    // EXPRESSION node, but expressions are top level and assigns can
+    // be embedded in an EXPRESSION, so instead the value being assigned
+    // is simply any binary operation and has no specific NodeRule to check.
+    Node* name_node = symbol_node->child(0);
+
+    GS_ASSERT_NODE_RULE(name_node, NodeRule::NAME);
+    
+    // Dispatch assignment walker to child class and feed in result of
+    // of the binary operation walk.
+    return derived().WalkAssign(
+        spec_node,
+        name_node,
+        symbol_node,
+        assign_node,
+        binary_operation_result);
+}
+
+// Walks through a RETURN statement Node's children.
+template <typename Derived, typename ReturnType>
+void AstWalker<Derived, ReturnType>::WalkReturnChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* return_node,
+    std::vector<ReturnType>* arguments_result) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
+    GS_ASSERT_NODE_RULE(return_node, NodeRule::RETURN);
+
+    // Handle expression and expression-less differently.
+    if (return_node->child_count() > 0) {
+        Node* expression_node = return_node->child(0);
+        GS_ASSERT_NODE_RULE(expression_node, NodeRule::EXPRESSION);
+
+        // Walk the return expression.
+        ReturnType expression_result = derived().WalkExpressionChildren(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            expression_node);
+
+        // Dispatch the results of walking the expression to the child class.
+        derived().WalkReturn(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            &expression_result,
+            arguments_result);
+    }
+    else {
+        derived().WalkReturn(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            NULL,
+            arguments_result);
+    }
+}
+
+// Walks all children of the EXPRESSION node.
+template <typename Derived, typename ReturnType>
+ReturnType AstWalker<Derived, ReturnType>::WalkExpressionChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* expression_node) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
+    GS_ASSERT_NODE_RULE(expression_node, NodeRule::EXPRESSION);
+
+    return WalkSubExpressionChildren(
+        spec_node,
+        function_node,
+        property_node,
+        property_function,
+        expression_node->child(0));
+}
+
+// Walks top level subexpressions.
+template <typename Derived, typename ReturnType>
+ReturnType AstWalker<Derived, ReturnType>::WalkSubExpressionChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* subexpression_node) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
+
+    switch (subexpression_node->rule()) {
+    case NodeRule::CALL:
+        return WalkFunctionCallChildren(
+            spec_node,
+            function_node,
+            subexpression_node);
+    case NodeRule::ASSIGN:
+        return WalkAssignChildren(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            subexpression_node);
+    case NodeRule::NEW:
+        return WalkNewExpressionChildren(
+            spec_node,
+            function_node,
+            subexpression_node);
+    case NodeRule::MEMBER:
+        // Technically a binary (2 operand) operator, but WalkBinaryOp does stuff that
+        // is inapproprop for this case.
+        return WalkMemberChildren(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            subexpression_node);
+    case NodeRule::DEFAULT:
+        return WalkDefaultExpressionChildren(subexpression_node);
+    default:
+        return WalkBinaryOperationChildren(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            subexpression_node);
+    }
+}
+
+// Walks all children of binary expressions.
+template <typename Derived, typename ReturnType>
+ReturnType AstWalker<Derived, ReturnType>::WalkBinaryOperationChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* binary_operation_node) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
+
+    // This node has children, treat it as a binary operation.
+    if (binary_operation_node->child_count() == 2) {
+
+        Node* left_node = binary_operation_node->child(0);
+        Node* right_node = binary_operation_node->child(1);
+
+        ReturnType left_result = WalkSubExpressionChildren(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            left_node);
+
+        ReturnType right_result = WalkSubExpressionChildren(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            right_node);
+
+        // Switch all binary operations.
+        switch (binary_operation_node->rule()) {
+        case NodeRule::ADD:
+            return derived().WalkAdd(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::SUB:
+            return derived().WalkSub(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::MUL:
+            return derived().WalkMul(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::DIV:
+            return derived().WalkDiv(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::MOD:
+            return derived().WalkMod(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::LOGAND:
+            return derived().WalkLogAnd(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::LOGOR:
+            return derived().WalkLogOr(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::GREATER:
+            return derived().WalkGreater(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::EQUALS:
+            return derived().WalkEquals(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::NOT_EQUALS:
+            return derived().WalkNotEquals(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::LESS:
+            return derived().WalkLess(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::GREATER_EQUALS:
+            return derived().WalkGreaterEquals(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        case NodeRule::LESS_EQUALS:
+            return derived().WalkLessEquals(
+                spec_node,
+                binary_operation_node,
+                left_node,
+                right_node,
+                left_result,
+                right_result);
+        default:
+            THROW_NOT_IMPLEMENTED();
+        }
+    }
+
+    // Not a binary operation, it's an atomic expression.
+    return WalkAtomicExpressionChildren(
+        spec_node,
+        function_node,
+        property_node,
+        property_function,
+        binary_operation_node);
+}
+
+// Parses any atomic expression such as STRING, BOOL, INT, and FLOAT.
+template <typename Derived, typename ReturnType>
+ReturnType AstWalker<Derived, ReturnType>::WalkAtomicExpressionChildren(
+    Node* spec_node,
+    Node* function_node,
+    Node* property_node,
+    PropertyFunction property_function,
+    Node* atomic_node) {
+
+    GS_ASSERT_OPTIONAL_NODE_RULE(spec_node, NodeRule::SPEC);
+    GS_ASSERT_OPTIONAL_NODE_RULE(function_node, NodeRule::FUNCTION);
+    GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
+
+    switch (atomic_node->rule()) {
+    case NodeRule::LOGNOT:
+        return derived().WalkLogNot(
+            spec_node,
+            atomic_node,
+            atomic_node->child(0),
+            WalkSubExpressionChildren(
+                spec_node,
+                function_node,
+                property_node,
+                property_function,
+                atomic_node->child(0)));
+    case NodeRule::BOOL:
+        return derived().WalkBool(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            atomic_node);
+    case NodeRule::INT:
+        return derived().WalkInt(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            atomic_node);
+    case NodeRule::FLOAT:
+        return derived().WalkFloat(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            atomic_node);
+    case NodeRule::STRING:
+        return derived().WalkString(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            atomic_node);
+    case NodeRule::CHAR:
+        return derived().WalkChar(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            atomic_node);
+    case NodeRule::SYMBOL:
+        return derived().WalkVariable(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            atomic_node,
+            atomic_node->child(0));
+    case NodeRule::ANY_TYPE:
+        return derived().WalkAnyType(
+            spec_node,
+            function_node,
+            property_node,
+            property_function,
+            atomic_node);
+    default:
+        THROW_NOT_IMPLEMENTED();
+    }
+}
+
 } // namespace library
 } // namespace gunderscript
 
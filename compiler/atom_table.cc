@@ -0,0 +1,134 @@
+// Gunderscript-2 Identifier Atom Table
+// (C) 2016 Christian Gunderman
+
+#include <cstring>
+
+#include "gunderscript/atom_table.h"
+
+namespace gunderscript {
+
+// Initial number of slots in the table. Must be a power of two.
+static const size_t kAtomTableInitialSlots = 256;
+
+// Computes the FNV-1a hash of a string.
+static size_t HashString(const char* data, size_t length) {
+    size_t hash = 2166136261u;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+// Constructs an empty AtomTable.
+AtomTable::AtomTable() : parent_(NULL), first_id_(0), slots_(kAtomTableInitialSlots, NULL) { }
+
+// Constructs an empty AtomTable layered on top of another.
+// parent: table to take Atoms from for the strings it already has. It must
+// outlive this table and must not be interned into while this table is used.
+AtomTable::AtomTable(const AtomTable* parent)
+    : parent_(parent),
+    first_id_(parent->first_id_ + parent->size()),
+    slots_(kAtomTableInitialSlots, NULL) { }
+
+// Interns a string, adding it to the table if it has not been seen before.
+// data: the chars of the string. Need not be NULL terminated.
+// length: the number of chars in the string.
+// Returns: the Atom that uniquely represents this string in this table.
+Atom AtomTable::Intern(const char* data, size_t length) {
+    size_t hash = HashString(data, length);
+
+    // Strings the parent knows keep the parent's Atom.
+    for (const AtomTable* table = this->parent_; table != NULL; table = table->parent_) {
+        const Atom::Entry* entry = table->FindEntry(data, length, hash);
+
+        if (entry != NULL) {
+            return Atom(entry);
+        }
+    }
+
+    const Atom::Entry* entry = this->FindEntry(data, length, hash);
+    if (entry != NULL) {
+        return Atom(entry);
+    }
+
+    // Not found, create a new entry. Keep the load factor at or below 1/2.
+    if ((this->entries_.size() + 1) * 2 > this->slots_.size()) {
+        this->Grow();
+    }
+
+    Atom::Entry new_entry = { std::string(data, length), hash, this->first_id_ + this->entries_.size() };
+    this->entries_.push_back(new_entry);
+    entry = &this->entries_.back();
+
+    size_t mask = this->slots_.size() - 1;
+    size_t i = hash & mask;
+    while (this->slots_[i] != NULL) {
+        i = (i + 1) & mask;
+    }
+    this->slots_[i] = entry;
+
+    return Atom(entry);
+}
+
+// Looks up a string without adding it. Only reads the table, so any number
+// of threads may Find at once as long as none of them Interns.
+// data: the chars of the string. Need not be NULL terminated.
+// length: the number of chars in the string.
+// Returns: the string's Atom, or an invalid Atom if it was never interned
+// in this table or its parents.
+Atom AtomTable::Find(const char* data, size_t length) const {
+    size_t hash = HashString(data, length);
+
+    for (const AtomTable* table = this; table != NULL; table = table->parent_) {
+        const Atom::Entry* entry = table->FindEntry(data, length, hash);
+
+        if (entry != NULL) {
+            return Atom(entry);
+        }
+    }
+
+    return Atom(NULL);
+}
+
+// Linear probes this table, but not its parents, for a string.
+// Returns: the string's entry, or NULL if it isn't in this table.
+const Atom::Entry* AtomTable::FindEntry(const char* data, size_t length, size_t hash) const {
+    size_t mask = this->slots_.size() - 1;
+
+    for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+        const Atom::Entry* entry = this->slots_[i];
+
+        if (entry == NULL) {
+            return NULL;
+        }
+
+        if (entry->hash == hash &&
+            entry->str.length() == length &&
+            std::memcmp(entry->str.data(), data, length) == 0) {
+            return entry;
+        }
+    }
+}
+
+// Doubles the number of slots and rehashes all existing entries.
+void AtomTable::Grow() {
+    std::vector<const Atom::Entry*> new_slots(this->slots_.size() * 2, NULL);
+    size_t mask = new_slots.size() - 1;
+
+    for (size_t i = 0; i < this->entries_.size(); i++) {
+        const Atom::Entry* entry = &this->entries_[i];
+
+        size_t slot = entry->hash & mask;
+        while (new_slots[slot] != NULL) {
+            slot = (slot + 1) & mask;
+        }
+        new_slots[slot] = entry;
+    }
+
+    this->slots_.swap(new_slots);
+}
+
+} // namespace gunderscript
@@ -0,0 +1,102 @@
+// Gunderscript 2 Atom Table Unit Test
+// (C) 2016 Christian Gunderman
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "gunderscript/atom_table.h"
+
+using namespace gunderscript;
+
+// Checks that the same string always interns to the same Atom and
+// different strings intern to different Atoms.
+TEST(AtomTable, InternIsIdempotent) {
+    AtomTable atoms;
+
+    Atom a1 = atoms.Intern("foo");
+    Atom b1 = atoms.Intern("bar");
+    Atom a2 = atoms.Intern(std::string("foo"));
+    Atom b2 = atoms.Intern("barbaz", 3);
+
+    ASSERT_TRUE(a1 == a2);
+    ASSERT_TRUE(b1 == b2);
+    ASSERT_TRUE(a1 != b1);
+    ASSERT_EQ(a1.id(), a2.id());
+    ASSERT_NE(a1.id(), b1.id());
+    ASSERT_STREQ("foo", a1.str().c_str());
+    ASSERT_STREQ("bar", b2.str().c_str());
+    ASSERT_EQ(2, atoms.size());
+}
+
+// Checks that the empty string and strings with embedded NULLs intern
+// by their full length.
+TEST(AtomTable, InternEmptyAndEmbeddedNull) {
+    AtomTable atoms;
+
+    Atom empty = atoms.Intern("", 0);
+    Atom a = atoms.Intern("a\0b", 3);
+    Atom a_only = atoms.Intern("a", 1);
+
+    ASSERT_TRUE(empty == atoms.Intern(std::string()));
+    ASSERT_TRUE(a != a_only);
+    ASSERT_EQ(3, a.str().length());
+    ASSERT_EQ(3, atoms.size());
+}
+
+// Checks that Atoms survive the table growing and that ids are dense.
+TEST(AtomTable, AtomsStableAcrossGrowth) {
+    AtomTable atoms;
+    std::vector<Atom> interned;
+
+    for (int i = 0; i < 10000; i++) {
+        std::ostringstream name;
+        name << "name" << i;
+        interned.push_back(atoms.Intern(name.str()));
+    }
+
+    ASSERT_EQ(10000, atoms.size());
+
+    for (int i = 0; i < 10000; i++) {
+        std::ostringstream name;
+        name << "name" << i;
+
+        ASSERT_TRUE(interned[i] == atoms.Intern(name.str()));
+        ASSERT_EQ(i, interned[i].id());
+        ASSERT_STREQ(name.str().c_str(), interned[i].str().c_str());
+    }
+
+    ASSERT_EQ(10000, atoms.size());
+}
+
+// Checks that Find never adds to the table.
+TEST(AtomTable, FindDoesNotIntern) {
+    AtomTable atoms;
+
+    Atom foo = atoms.Intern("foo");
+
+    ASSERT_TRUE(foo == atoms.Find("foo"));
+    ASSERT_FALSE(atoms.Find("bar").valid());
+    ASSERT_EQ(1, atoms.size());
+}
+
+// Checks that a child table shares its parent's Atoms and keeps its own
+// strings to itself.
+TEST(AtomTable, ChildTableSharesParentAtoms) {
+    AtomTable parent;
+    Atom foo = parent.Intern("foo");
+
+    AtomTable child(&parent);
+    Atom bar = child.Intern("bar");
+
+    ASSERT_TRUE(foo == child.Intern("foo"));
+    ASSERT_TRUE(foo == child.Find("foo"));
+    ASSERT_TRUE(bar == child.Intern("bar"));
+    ASSERT_TRUE(bar == child.Find("bar"));
+    ASSERT_FALSE(parent.Find("bar").valid());
+    ASSERT_NE(foo.id(), bar.id());
+    ASSERT_EQ(1, parent.size());
+    ASSERT_EQ(1, child.size());
+}
@@ -1,14 +1,19 @@
 // Gunderscript-2 Compiler API Implementation
 // (C) 2016 Christian Gunderman
 
+#include <vector>
+
 #include "gunderscript/compiler.h"
 
 #include "common_resourcesimpl.h"
 #include "lexer.h"
 #include "lirgen_ast_walker.h"
 #include "moduleimpl.h"
+#include "node_arena.h"
 #include "parser.h"
 #include "semantic_ast_walker.h"
+#include "token_array.h"
+#include "virtual_machineimpl.h"
 
 using namespace gunderscript::compiler;
 
@@ -52,11 +57,136 @@ public:
         ParserNodeFunc parser_walk_func,
         ParserNodeFunc typecheck_walk_func);
     void Compile(CompilerSourceInterface& source, Module& compiled_module);
+    void CompileAndAssemble(
+        CompilerSourceInterface& source,
+        Module& compiled_module,
+        VirtualMachine& vm);
 
 private:
     CommonResources& common_resources_;
+
+    Node* Parse(Parser& parser);
+    void TypeCheck(SemanticAstWalker& semantic_walker);
+    void Generate(LIRGenAstWalker& lir_generator, Module& generated_module);
+    bool StreamCompile(
+        const TokenArray& tokens,
+        AtomTable& atoms,
+        const LineTable& lines,
+        VirtualMachineImpl& vm,
+        Module& streamed_module);
 };
 
+// Copies the symbols that walking the declarations attached to a function or
+// spec onto its copy from Parser::ParseImplementation(). The declarations'
+// placeholder bodies have no children, so the copy's bodies are left alone.
+static void CopyDeclarationSymbols(const Node* declaration_node, Node* impl_node) {
+    impl_node->set_symbol(declaration_node->symbol());
+
+    for (size_t i = 0; i < declaration_node->child_count(); i++) {
+        CopyDeclarationSymbols(declaration_node->child(i), impl_node->child(i));
+    }
+}
+
+// Parses the whole script, or if lazy parsing is enabled in the
+// CommonResources, only the bodies of the functions reachable from its entry
+// point.
+// Function bodies are parsed in parallel if more than one compile thread is
+// allowed and lazy parsing is off.
+Node* CompilerImpl::Parse(Parser& parser) {
+    if (common_resources_.pimpl().lazy_parsing()) {
+        return parser.ParseReachable(common_resources_.pimpl().entry_point());
+    }
+
+    if (common_resources_.pimpl().compile_threads() != 1) {
+        return parser.ParseParallel(common_resources_.pimpl().compile_threads());
+    }
+
+    return parser.Parse();
+}
+
+// Type checks the AST. Implementations are checked in parallel if more than
+// one compile thread is allowed.
+void CompilerImpl::TypeCheck(SemanticAstWalker& semantic_walker) {
+    if (common_resources_.pimpl().compile_threads() != 1) {
+        semantic_walker.WalkParallel(common_resources_.pimpl().compile_threads());
+        return;
+    }
+
+    semantic_walker.Walk();
+}
+
+// Generates LIR for the type checked AST. Functions are generated in
+// parallel if more than one compile thread is allowed.
+void CompilerImpl::Generate(LIRGenAstWalker& lir_generator, Module& generated_module) {
+    if (common_resources_.pimpl().compile_threads() != 1) {
+        lir_generator.GenerateParallel(generated_module, common_resources_.pimpl().compile_threads());
+        return;
+    }
+
+    lir_generator.Generate(generated_module);
+}
+
+// Type checks, generates, and assembles the module one function or spec at
+// a time once the declarations have been walked. Each one's bodies are
+// parsed into their own arena and its LIR is allocated from its own
+// Allocator, and both are freed as soon as it is assembled, so only the
+// tokens, the declarations, and the native code grow with the module. The
+// native code is kept in a CodeAlloc owned by the module, so resetting the
+// module after an error frees the code of the functions already assembled.
+// Returns: true if the module was compiled, or false if a body has to be
+// parsed along with the rest of the module to find its error.
+// Throws: if the module has an error, which may not be the one that a
+// whole module compilation would report first.
+bool CompilerImpl::StreamCompile(
+    const TokenArray& tokens,
+    AtomTable& atoms,
+    const LineTable& lines,
+    VirtualMachineImpl& vm,
+    Module& streamed_module) {
+
+    NodeArena nodes;
+    Parser parser(tokens, nodes);
+    Node* root = parser.ParseDeclarations();
+
+    SemanticAstWalker semantic_walker(*root, atoms, lines);
+    LIRGenAstWalker lir_generator(common_resources_.pimpl(), *root, atoms);
+
+    semantic_walker.WalkDeclarations();
+    lir_generator.BeginGenerate(streamed_module);
+    lir_generator.WalkDeclarations();
+
+    // Functions are assembled as soon as they are generated.
+    CodeAlloc* code_alloc = new CodeAlloc(&common_resources_.pimpl().config());
+    streamed_module.pimpl()->AdoptCodeAlloc(code_alloc);
+    streamed_module.pimpl()->set_assembled(true);
+
+    std::vector<ModuleImplSymbol>& symbols = streamed_module.pimpl()->symbols_vector();
+    std::vector<Node*> impl_nodes = semantic_walker.ImplementationNodes();
+    for (size_t i = 0; i < impl_nodes.size(); i++) {
+        NodeArena impl_arena;
+        Node* impl_node = parser.ParseImplementation(impl_nodes[i], impl_arena);
+
+        if (impl_node == NULL) {
+            return false;
+        }
+
+        CopyDeclarationSymbols(impl_nodes[i], impl_node);
+        semantic_walker.WalkImplementation(impl_node);
+
+        Allocator lir_alloc;
+        size_t first_symbol = symbols.size();
+        lir_generator.set_alloc(lir_alloc);
+        lir_generator.WalkImplementation(impl_node);
+
+        for (size_t j = first_symbol; j < symbols.size(); j++) {
+            vm.AssembleFunction(streamed_module, j, *code_alloc);
+        }
+    }
+
+    lir_generator.EndGenerate();
+    return true;
+}
+
 // Implementation of compiler DebugCompilation function.
 void CompilerImpl::DebugCompilation(
     CompilerSourceInterface& source,
@@ -65,7 +195,8 @@ void CompilerImpl::DebugCompilation(
     ParserNodeFunc parser_walk_func,
     ParserNodeFunc typecheck_walk_func) {
 
-    Lexer lexer(source);
+    AtomTable atoms;
+    Lexer lexer(source, atoms);
 
     // Run the Lexer token iterator function if provided.
     if (lexer_iteration_func != NULL) {
@@ -78,105 +209,128 @@ void CompilerImpl::DebugCompilation(
         return;
     }
 
-    // Perform parsing step.
-    Parser parser(lexer);
-    Node* root = NULL;
-    
-    try {
-        root = parser.Parse();
-
-        // Run the Parser walk function if provided.
-        if (parser_walk_func != NULL) {
-            parser_walk_func(root);
-        }
-
-        if (stop_at == CompilerStage::PARSER) {
-            delete root;
-            return;
-        }
-
-        // Perform typechecking step.
-        SemanticAstWalker semantic_walker(*root);
-        semantic_walker.Walk();
+    // Perform parsing step. The whole AST, and the symbols that the
+    // typechecker attaches to it, live in this arena and are freed at once
+    // when it goes out of scope.
+    NodeArena nodes;
+    Parser parser(lexer, nodes);
+    Node* root = Parse(parser);
 
-        // Run Post-Typecheck AST walker function if given.
-        if (typecheck_walk_func != NULL) {
-            typecheck_walk_func(root);
-        }
+    // Run the Parser walk function if provided.
+    if (parser_walk_func != NULL) {
+        parser_walk_func(root);
+    }
 
-        if (stop_at == CompilerStage::TYPE_CHECKER) {
-            delete root;
-            return;
-        }
+    if (stop_at == CompilerStage::PARSER) {
+        return;
+    }
 
-        // Perform codegen step.
-        Module module;
-        LIRGenAstWalker lir_generator(
-            common_resources_.pimpl().alloc(),
-            common_resources_.pimpl().config(),
-            *root);
-        lir_generator.Generate(module);
+    // Perform typechecking step.
+    SemanticAstWalker semantic_walker(*root, atoms, lexer.lines());
+    TypeCheck(semantic_walker);
 
-        if (stop_at == CompilerStage::CODE_GEN) {
-            delete root;
-            return;
-        }
+    // Run Post-Typecheck AST walker function if given.
+    if (typecheck_walk_func != NULL) {
+        typecheck_walk_func(root);
+    }
 
-        // Perform assembly step.
-        // LIR and assembly is only printed on-screen if the caller set verbose_asm
-        // in CommonResources and the project was built with NJ_VERBOSE defined.
-        // On Windows with VS, this may require manual definition as CMAKE doesn't
-        // seem to define CMAKE_BUILD_TYPE with VS.
-        VirtualMachine vm(common_resources_);
-        vm.AssembleModule(module);
+    if (stop_at == CompilerStage::TYPE_CHECKER) {
+        return;
     }
-    catch (const Exception&) {
 
-        if (root != NULL) {
-            delete root;
-        }
+    // Perform codegen step.
+    Module module;
+    LIRGenAstWalker lir_generator(common_resources_.pimpl(), *root, atoms);
+    Generate(lir_generator, module);
 
-        throw;
+    if (stop_at == CompilerStage::CODE_GEN) {
+        return;
     }
 
-    // Delete AST and return. Be sure to add a stop_at check for ASSEMBLY
-    // stage if you add more compiler stages.
-    delete root;
-    return;
+    // Perform assembly step.
+    // LIR and assembly is only printed on-screen if the caller set verbose_asm
+    // in CommonResources and the project was built with NJ_VERBOSE defined.
+    // On Windows with VS, this may require manual definition as CMAKE doesn't
+    // seem to define CMAKE_BUILD_TYPE with VS.
+    VirtualMachine vm(common_resources_);
+    vm.AssembleModule(module);
+
+    // Be sure to add a stop_at check for ASSEMBLY stage if you add more
+    // compiler stages.
 }
 
 // Compiles code from a source into a module.
 void CompilerImpl::Compile(CompilerSourceInterface& source, Module& compiled_module) {
-    Lexer lexer(source);
-    Parser parser(lexer);
-    
-    Node* root = NULL;
-
-    try {
-        // Perform parse step:
-        root = parser.Parse();
-        SemanticAstWalker semantic_walker(*root);
-
-        // Perform type checking step.
-        semantic_walker.Walk();
-
-        // Generate NanoJIT IR Code.
-        LIRGenAstWalker lir_generator(
-            common_resources_.pimpl().alloc(),
-            common_resources_.pimpl().config(),
-            *root);
-        lir_generator.Generate(compiled_module);
-        delete root;
-    }
-    catch (const Exception&) {
+    AtomTable atoms;
+    Lexer lexer(source, atoms);
 
-        // Free on exception.
-        if (root != NULL) {
-            delete root;
+    // The AST is freed all at once with its arena when compilation ends,
+    // whether or not it succeeded.
+    NodeArena nodes;
+    Parser parser(lexer, nodes);
+
+    // Perform parse step:
+    Node* root = Parse(parser);
+    SemanticAstWalker semantic_walker(*root, atoms, lexer.lines());
+    LIRGenAstWalker lir_generator(common_resources_.pimpl(), *root, atoms);
+
+    // Perform type checking step.
+    TypeCheck(semantic_walker);
+
+    // Generate NanoJIT IR Code.
+    Generate(lir_generator, compiled_module);
+}
+
+// Compiles code from a source into a module and assembles it for a VM like
+// Compile() followed by VirtualMachine::AssembleModule(), but only keeps the
+// AST and LIR of one function or spec at a time. Errors, and the state of
+// the module after one, are the same as from those two calls: if anything
+// goes wrong, the module is compiled again the usual way to find the error
+// that they would report. Functions are compiled serially, and if lazy
+// parsing is enabled the module is always compiled the usual way.
+void CompilerImpl::CompileAndAssemble(
+    CompilerSourceInterface& source,
+    Module& compiled_module,
+    VirtualMachine& vm) {
+
+    AtomTable atoms;
+    Lexer lexer(source, atoms);
+    TokenArray tokens(lexer);
+
+    if (!common_resources_.pimpl().lazy_parsing() && !compiled_module.compiled()) {
+        bool streamed = false;
+
+        try {
+            streamed = StreamCompile(tokens, atoms, lexer.lines(), vm.pimpl(), compiled_module);
+        }
+        catch (const Exception&) {
+            // Compiling the usual way below finds the error that Compile()
+            // would have reported.
+        }
+        catch (...) {
+            compiled_module.pimpl()->Reset();
+            throw;
+        }
+
+        if (streamed) {
+            return;
         }
 
-        throw;
+        // Throw away the functions that were streamed, and their code,
+        // before compiling the module again.
+        compiled_module.pimpl()->Reset();
     }
+
+    NodeArena nodes;
+    Parser parser(tokens, nodes);
+    Node* root = Parse(parser);
+    SemanticAstWalker semantic_walker(*root, atoms, lexer.lines());
+    TypeCheck(semantic_walker);
+
+    LIRGenAstWalker lir_generator(common_resources_.pimpl(), *root, atoms);
+    Generate(lir_generator, compiled_module);
+
+    vm.AssembleModule(compiled_module);
 }
 
 // Public constructor.
@@ -208,4 +362,14 @@ void Compiler::Compile(CompilerSourceInterface& source, Module& compiled_module)
     return this->pimpl_->Compile(source, compiled_module);
 }
 
+// Compiles a file to a Module and assembles it, one function at a time.
+// This method is a wrapper that uses the PIMPL pattern to obscure implementation
+// details.
+void Compiler::CompileAndAssemble(
+    CompilerSourceInterface& source,
+    Module& compiled_module,
+    VirtualMachine& vm) {
+    return this->pimpl_->CompileAndAssemble(source, compiled_module, vm);
+}
+
 } // namespace gunderscript
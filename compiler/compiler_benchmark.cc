@@ -0,0 +1,270 @@
+// Gunderscript 2 Compiler Benchmark
+// (C) 2016 Christian Gunderman
+
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "benchmark_macros.h"
+
+#include "gunderscript/atom_table.h"
+#include "gunderscript/common_resources.h"
+#include "gunderscript/compiler.h"
+#include "gunderscript/compiler_source.h"
+#include "gunderscript/module.h"
+#include "gunderscript/symbol.h"
+#include "gunderscript/virtual_machine.h"
+
+#include "argument_stack.h"
+#include "symbol_table.h"
+
+using namespace gunderscript;
+using gunderscript::compiler::ArgumentStack;
+using gunderscript::compiler::SymbolTable;
+
+// Number of functions in the generated module.
+static const int kBenchmarkFunctionCount = 2000;
+
+// Number of timed iterations for each benchmark.
+static const int kBenchmarkIterations = 3;
+
+// Number of symbol table lookups that miss in each timed iteration.
+static const int kBenchmarkLookupCount = 100000;
+
+// Number of nested calls whose arguments are collected in each timed iteration.
+static const int kBenchmarkCallCount = 1000000;
+
+// Generates a module of many small functions with loops and branches, and a
+// main function that calls the first and the last of them.
+static std::string GenerateModuleScript(int function_count) {
+    std::ostringstream buffer;
+
+    buffer << "package \"Benchmark\";\n";
+    for (int i = 0; i < function_count; i++) {
+        buffer << "public int32 function" << i << "(int32 a, int32 b) {\n"
+            << "    x <- a * " << i << " + b;\n"
+            << "    for (i <- 0; i < 3; i <- i + 1) {\n"
+            << "        if (x > b) { x <- x - i; } else { x <- x + i * 2; }\n"
+            << "    }\n"
+            << "    return x + a % 7;\n"
+            << "}\n";
+    }
+
+    buffer << "public int32 main() { return function0(1, 2) + function"
+        << (function_count - 1) << "(3, 4); }\n";
+
+    return buffer.str();
+}
+
+// Generates a module whose spec functions reassign their locals in nested
+// scopes and call out of spec (static) functions, which are the lookups that
+// miss the symbol table on the way to the symbol they want.
+static std::string GenerateLookupScript(int function_count) {
+    std::ostringstream buffer;
+
+    buffer << "package \"Benchmark\";\n"
+        << "public int32 helper(int32 a, int32 b) { return a + b; }\n"
+        << "public spec Lookups {\n"
+        << "    public construct() { }\n";
+    for (int i = 0; i < function_count; i++) {
+        buffer << "    public int32 function" << i << "(int32 a) {\n"
+            << "        x <- a;\n"
+            << "        for (i <- 0; i < 3; i <- i + 1) {\n"
+            << "            x <- helper(x, i); x <- helper(x, a); x <- x - 1;\n"
+            << "        }\n"
+            << "        return x;\n"
+            << "    }\n";
+    }
+
+    buffer << "}\n";
+
+    return buffer.str();
+}
+
+// Generates a module whose functions are mostly nested calls, so that
+// walking it is dominated by dispatching nodes and collecting arguments.
+static std::string GenerateCallScript(int function_count) {
+    std::ostringstream buffer;
+
+    buffer << "package \"Benchmark\";\n"
+        << "public int32 add(int32 a, int32 b) { return a + b; }\n"
+        << "public int32 mul(int32 a, int32 b, int32 c) { return a * b * c; }\n";
+    for (int i = 0; i < function_count; i++) {
+        buffer << "public int32 function" << i << "(int32 a, int32 b) {\n"
+            << "    x <- add(mul(a, b, " << i << "), add(a, mul(b, 2, add(a, 1))));\n"
+            << "    if (x > add(a, b)) { x <- add(x, add(x, add(x, 1))); }\n"
+            << "    return add(x, mul(x - 1, x + 1, add(a, b)));\n"
+            << "}\n";
+    }
+
+    return buffer.str();
+}
+
+// Compiles and assembles a module and then runs its main function.
+// thread_count: the number of compile threads, or 0 for one per hardware thread.
+static int CompileAndRun(std::string& input, unsigned int thread_count) {
+    CommonResources common_resources;
+    common_resources.set_compile_threads(thread_count);
+    CompilerStringSource source(input);
+    Compiler compiler(common_resources);
+    Module module;
+    compiler.Compile(source, module);
+
+    VirtualMachine vm(common_resources);
+    vm.AssembleModule(module);
+
+    return vm.HackyRunScriptMainInt(module);
+}
+
+// Compares the end to end latency of compiling and assembling a big module
+// on one thread against compiling it on one thread per hardware thread.
+TEST(CompilerBenchmark, ParallelCompile) {
+    std::string input = GenerateModuleScript(kBenchmarkFunctionCount);
+
+    int serial_result = 0;
+    double serial_us = BENCHMARK_RUN("Compile serially", kBenchmarkIterations,
+        serial_result = CompileAndRun(input, 1));
+
+    int parallel_result = 0;
+    double parallel_us = BENCHMARK_RUN("Compile in parallel", kBenchmarkIterations,
+        parallel_result = CompileAndRun(input, 0));
+
+    BENCHMARK_REPORT_SPEEDUP(serial_us, parallel_us);
+
+    ASSERT_EQ(serial_result, parallel_result);
+}
+
+// Compares symbol table misses that unwind an exception out of Get() against
+// misses returned as NULL by Find(), then times compiling a module that is
+// dominated by the lookups that used to take the exception path.
+TEST(CompilerBenchmark, SymbolTableMisses) {
+    AtomTable atoms;
+    SymbolTable<std::string> table;
+    table.Put(atoms.Intern("Present"), "Value");
+    table.Push();
+    const Atom missing = atoms.Intern("Missing");
+
+    int thrown_misses = 0;
+    double get_us = BENCHMARK_RUN("Get and catch misses", kBenchmarkIterations,
+        for (int i = 0; i < kBenchmarkLookupCount; i++) {
+            try {
+                table.Get(missing);
+            }
+            catch (const Exception&) {
+                thrown_misses++;
+            }
+        });
+
+    int found_misses = 0;
+    double find_us = BENCHMARK_RUN("Find misses", kBenchmarkIterations,
+        for (int i = 0; i < kBenchmarkLookupCount; i++) {
+            if (table.Find(missing) == NULL) {
+                found_misses++;
+            }
+        });
+
+    BENCHMARK_REPORT_SPEEDUP(get_us, find_us);
+
+    ASSERT_EQ(thrown_misses, found_misses);
+
+    std::string input = GenerateLookupScript(kBenchmarkFunctionCount);
+    bool compiled = false;
+    BENCHMARK_RUN("Compile lookup heavy module", kBenchmarkIterations,
+        CommonResources common_resources;
+        CompilerStringSource source(input);
+        Compiler compiler(common_resources);
+        Module module;
+        compiler.Compile(source, module);
+        compiled = module.compiled());
+
+    ASSERT_TRUE(compiled);
+}
+
+// Compares collecting the arguments of nested calls into a new vector per
+// call against borrowing them from an ArgumentStack, as AstWalker does, then
+// times type checking and compiling a module that is mostly calls.
+TEST(CompilerBenchmark, CallArguments) {
+    const SymbolBase* argument = &TYPE_INT;
+
+    size_t vector_arguments = 0;
+    double vector_us = BENCHMARK_RUN("Collect arguments in new vectors", kBenchmarkIterations,
+        for (int i = 0; i < kBenchmarkCallCount; i++) {
+            std::vector<const SymbolBase*> outer;
+            outer.push_back(argument);
+            {
+                std::vector<const SymbolBase*> inner;
+                inner.push_back(argument);
+                inner.push_back(argument);
+                inner.push_back(argument);
+                vector_arguments += inner.size();
+            }
+            outer.push_back(argument);
+            vector_arguments += outer.size();
+        });
+
+    ArgumentStack<const SymbolBase*> stack;
+    size_t stack_arguments = 0;
+    double stack_us = BENCHMARK_RUN("Collect arguments in stack frames", kBenchmarkIterations,
+        for (int i = 0; i < kBenchmarkCallCount; i++) {
+            ArgumentStack<const SymbolBase*>::Frame outer(stack);
+            outer.arguments().push_back(argument);
+            {
+                ArgumentStack<const SymbolBase*>::Frame inner(stack);
+                inner.arguments().push_back(argument);
+                inner.arguments().push_back(argument);
+                inner.arguments().push_back(argument);
+                stack_arguments += inner.arguments().size();
+            }
+            outer.arguments().push_back(argument);
+            stack_arguments += outer.arguments().size();
+        });
+
+    BENCHMARK_REPORT_SPEEDUP(vector_us, stack_us);
+
+    ASSERT_EQ(vector_arguments, stack_arguments);
+
+    std::string input = GenerateCallScript(kBenchmarkFunctionCount);
+    BENCHMARK_RUN("Type check call heavy module", kBenchmarkIterations,
+        CommonResources common_resources;
+        common_resources.set_compile_threads(1);
+        CompilerStringSource source(input);
+        Compiler compiler(common_resources);
+        compiler.DebugCompilation(source, CompilerStage::TYPE_CHECKER, NULL, NULL, NULL));
+
+    bool compiled = false;
+    BENCHMARK_RUN("Compile call heavy module", kBenchmarkIterations,
+        CommonResources common_resources;
+        common_resources.set_compile_threads(1);
+        CompilerStringSource source(input);
+        Compiler compiler(common_resources);
+        Module module;
+        compiler.Compile(source, module);
+        compiled = module.compiled());
+
+    ASSERT_TRUE(compiled);
+}
+
+// Compares compiling a whole module and then assembling it against streaming
+// each function through the compiler and assembler in turn, which releases
+// its tree and LIR before the next function starts.
+TEST(CompilerBenchmark, StreamingCompile) {
+    std::string input = GenerateModuleScript(kBenchmarkFunctionCount);
+
+    int whole_module_result = 0;
+    double whole_module_us = BENCHMARK_RUN("Compile then assemble", kBenchmarkIterations,
+        whole_module_result = CompileAndRun(input, 1));
+
+    int streamed_result = 0;
+    double streamed_us = BENCHMARK_RUN("Compile and assemble each function", kBenchmarkIterations,
+        CommonResources common_resources;
+        CompilerStringSource source(input);
+        Compiler compiler(common_resources);
+        Module module;
+        VirtualMachine vm(common_resources);
+        compiler.CompileAndAssemble(source, module, vm);
+        streamed_result = vm.HackyRunScriptMainInt(module));
+
+    BENCHMARK_REPORT_SPEEDUP(whole_module_us, streamed_us);
+
+    ASSERT_EQ(whole_module_result, streamed_result);
+}
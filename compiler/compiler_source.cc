@@ -4,6 +4,14 @@
 #include <fstream>
 #include <iostream>
 
+#if defined __unix__ || defined __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GUNDERSCRIPT_HAS_MMAP
+#endif // __unix__ || __APPLE__
+
 #include "gunderscript/compiler_source.h"
 #include "gunderscript/exceptions.h"
 
@@ -12,6 +20,23 @@ using std::ios_base;
 
 namespace gunderscript {
 
+// Default span implementation for sources that can only stream:
+// copies up to buffer_length chars into buffer one at a time.
+// Returns: the number of chars copied, or 0 if no more input.
+size_t CompilerSourceInterface::NextSpan(
+    const char** span,
+    char* buffer,
+    size_t buffer_length) {
+
+    size_t length = 0;
+    while (length < buffer_length && this->has_next()) {
+        buffer[length++] = (char)this->NextChar();
+    }
+
+    *span = buffer;
+    return length;
+}
+
 // Gets the current character from an instance of LexerStringSource
 // and advances the iterator to the next char.
 // Returns: The next char, or -1 if no characters remain.
@@ -34,6 +59,19 @@ int CompilerStringSource::PeekNextChar() {
     return this->input_[this->index];
 }
 
+// Returns the remainder of the string as one span and consumes it.
+size_t CompilerStringSource::NextSpan(
+    const char** span,
+    char* /* buffer */,
+    size_t /* buffer_length */) {
+
+    size_t length = this->input_.length() - this->index;
+
+    *span = this->input_.data() + this->index;
+    this->index = this->input_.length();
+    return length;
+}
+
 // Constructor for the file source object.
 CompilerFileSource::CompilerFileSource(const std::string& file_name) : file_name_(file_name) {
     this->file_stream_ = new fstream(file_name, ios_base::in);
@@ -89,9 +127,171 @@ int CompilerFileSource::PeekNextChar() {
     return this->next_;
 }
 
+// Reads the next block of the file into buffer with a single read.
+// Returns: the number of chars read, or 0 if no more input.
+// Throws CompilerFileReadException if read error occurs.
+size_t CompilerFileSource::NextSpan(
+    const char** span,
+    char* buffer,
+    size_t buffer_length) {
+
+    *span = buffer;
+
+    if (!this->has_next() || buffer_length == 0) {
+        return 0;
+    }
+
+    // The preloaded next char is the first char of the span.
+    buffer[0] = (char)this->next_;
+    this->file_stream_->read(buffer + 1, buffer_length - 1);
+    size_t length = 1 + (size_t)this->file_stream_->gcount();
+
+    // Preload the char following the span, as NextChar() does.
+    this->next_ = this->file_stream_->get();
+
+    if (this->file_stream_->bad()) {
+        THROW_EXCEPTION(
+            1,
+            1,
+            STATUS_FILESOURCE_FILE_READ_ERROR);
+    }
+
+    return length;
+}
+
 // Delete the file source object and closes the file.
 CompilerFileSource::~CompilerFileSource() {
     delete this->file_stream_;
 }
 
+// Constructor for the mapped file source object.
+// Maps the file into memory if the platform supports it, otherwise
+// reads the whole file into a heap buffer in one go.
+// Throws: STATUS_FILESOURCE_FILE_READ_ERROR if the file can't be read.
+CompilerMappedFileSource::CompilerMappedFileSource(const std::string& file_name) {
+    if (!this->MapFile(file_name) && !this->ReadFile(file_name)) {
+        THROW_EXCEPTION(
+            1,
+            1,
+            STATUS_FILESOURCE_FILE_READ_ERROR);
+    }
+}
+
+// Unmaps or frees the file buffer.
+CompilerMappedFileSource::~CompilerMappedFileSource() {
+#if defined GUNDERSCRIPT_HAS_MMAP
+    if (this->mapped_) {
+        munmap(const_cast<char*>(this->data_), this->length_);
+        return;
+    }
+#endif // GUNDERSCRIPT_HAS_MMAP
+
+    delete[] this->data_;
+}
+
+// Gets the current character from the mapped buffer and advances
+// the cursor to the next char.
+// Returns: The next char, or -1 if no characters remain.
+int CompilerMappedFileSource::NextChar() {
+    if (!this->has_next()) {
+        return -1;
+    }
+
+    return this->data_[this->index_++];
+}
+
+// Looks at the current character in the buffer without moving the
+// cursor.
+// Returns: The current character, or -1 if no characters remain.
+int CompilerMappedFileSource::PeekNextChar() {
+    if (!this->has_next()) {
+        return -1;
+    }
+
+    return this->data_[this->index_];
+}
+
+// Returns the remainder of the file as one span and consumes it.
+size_t CompilerMappedFileSource::NextSpan(
+    const char** span,
+    char* /* buffer */,
+    size_t /* buffer_length */) {
+
+    size_t length = this->length_ - this->index_;
+
+    *span = this->data_ + this->index_;
+    this->index_ = this->length_;
+    return length;
+}
+
+// Maps the file read-only into the address space.
+// Returns: true if the file was mapped, false if the caller should fall
+// back to ReadFile().
+bool CompilerMappedFileSource::MapFile(const std::string& file_name) {
+#if defined GUNDERSCRIPT_HAS_MMAP
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode)) {
+        close(fd);
+        return false;
+    }
+
+    // Zero length mappings are invalid. An empty file is simply an empty buffer.
+    if (file_stat.st_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void* mapping = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping holds its own reference to the file.
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    // The lexer only ever walks forward through the file.
+    madvise(mapping, (size_t)file_stat.st_size, MADV_SEQUENTIAL);
+
+    this->data_ = static_cast<const char*>(mapping);
+    this->length_ = (size_t)file_stat.st_size;
+    this->mapped_ = true;
+    return true;
+#else
+    return false;
+#endif // GUNDERSCRIPT_HAS_MMAP
+}
+
+// Reads the entire file into a heap allocated buffer with one read.
+// Returns: true if the file was read successfully.
+bool CompilerMappedFileSource::ReadFile(const std::string& file_name) {
+    std::ifstream file_stream(file_name, ios_base::in | ios_base::binary | ios_base::ate);
+    if (!file_stream.is_open() || !file_stream.good()) {
+        return false;
+    }
+
+    std::streamoff file_length = file_stream.tellg();
+    if (file_length < 0) {
+        return false;
+    }
+
+    char* buffer = new char[(size_t)file_length];
+    file_stream.seekg(0, ios_base::beg);
+    file_stream.read(buffer, file_length);
+
+    if (file_stream.gcount() != file_length) {
+        delete[] buffer;
+        return false;
+    }
+
+    this->data_ = buffer;
+    this->length_ = (size_t)file_length;
+    return true;
+}
+
 } // namespace gunderscript
\ No newline at end of file
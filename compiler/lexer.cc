@@ -1,7 +1,14 @@
 // Gunderscript-2 Lexer
 // (C) 2014-2016 Christian Gunderman
 
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
 #include "lexer.h"
+#include "lexer_scan.h"
 
 namespace gunderscript {
 
@@ -53,16 +60,27 @@ const std::string LexerSymbolString(LexerSymbol symbol) {
 
 namespace compiler {
 
+// The lexer scans the input as spans of contiguous chars obtained from
+// CompilerSourceInterface::NextSpan() rather than calling into the source
+// once per char. cursor_ is the next unread char and end_ is one past the
+// last char of the current span. Sources that hold their input in memory
+// hand over the whole input as a single span.
+
+// Check if input source has input left.
+#define HAS_CHAR() (this->cursor_ < this->end_ || this->NextSpan())
+
 // Get next character from input and advance to next.
 #define ADVANCE_CHAR()                                    \
-    this->next_column_number_++;                          \
-    this->source_->NextChar();
+    if (HAS_CHAR()) { this->cursor_++; }
 
 // Get next char without advancing to next.
-#define PEEK_CHAR() (this->source_->PeekNextChar())
+#define PEEK_CHAR() (HAS_CHAR() ? (int)*this->cursor_ : -1)
 
-// Check if input source has input left/
-#define HAS_CHAR() (this->source_->has_next())
+// Checks if c may appear in a NAME token after the first char.
+#define IS_NAME_CHAR(c) (isalpha(c) || isdigit(c) || (c) == '_')
+
+// Checks if c may appear in an INT or FLOAT token.
+#define IS_NUMBER_CHAR(c) (isdigit(c) || (c) == '.')
 
 // Save x as next token and return from function.
 // x: LexerSymbol.
@@ -98,43 +116,153 @@ namespace compiler {
     ADVANCE_CHAR();                               \
     ACCEPT_WWOSUFFIX_NU(x, y, z)
 
-// Defines a keyword in the keyword map so it will be found during
-// lexing.
-#define DEFINE_KEYWORD(k, t, s)                               \
-    this->keywords_map_.insert(std::make_pair(k, std::make_pair(t, s)));
+// The keywords and access modifiers recognized by ParseName(). Expands
+// ENTRY(text, LexerTokenType, LexerSymbol) once for each of them.
+#define LEXER_KEYWORDS(ENTRY)                                                 \
+    /* Access Modifiers. */                                                   \
+    ENTRY("public", LexerTokenType::ACCESS_MODIFIER, LexerSymbol::PUBLIC)     \
+    ENTRY("concealed", LexerTokenType::ACCESS_MODIFIER, LexerSymbol::CONCEALED) \
+    ENTRY("package", LexerTokenType::KEYWORD, LexerSymbol::PACKAGE)           \
+    ENTRY("internal", LexerTokenType::ACCESS_MODIFIER, LexerSymbol::INTERNAL) \
+                                                                              \
+    /* Keywords. */                                                           \
+    ENTRY("spec", LexerTokenType::KEYWORD, LexerSymbol::SPEC)                 \
+    ENTRY("if", LexerTokenType::KEYWORD, LexerSymbol::IF)                     \
+    ENTRY("else", LexerTokenType::KEYWORD, LexerSymbol::ELSE)                 \
+    ENTRY("do", LexerTokenType::KEYWORD, LexerSymbol::DO)                     \
+    ENTRY("while", LexerTokenType::KEYWORD, LexerSymbol::WHILE)               \
+    ENTRY("true", LexerTokenType::KEYWORD, LexerSymbol::KTRUE)                \
+    ENTRY("false", LexerTokenType::KEYWORD, LexerSymbol::KFALSE)              \
+    ENTRY("return", LexerTokenType::KEYWORD, LexerSymbol::RETURN)             \
+    ENTRY("get", LexerTokenType::KEYWORD, LexerSymbol::GET)                   \
+    ENTRY("set", LexerTokenType::KEYWORD, LexerSymbol::SET)                   \
+    ENTRY("construct", LexerTokenType::KEYWORD, LexerSymbol::CONSTRUCT)       \
+    ENTRY("start", LexerTokenType::KEYWORD, LexerSymbol::START)               \
+    ENTRY("readonly", LexerTokenType::KEYWORD, LexerSymbol::READONLY)         \
+    ENTRY("for", LexerTokenType::KEYWORD, LexerSymbol::FOR)                   \
+    ENTRY("break", LexerTokenType::KEYWORD, LexerSymbol::BREAK)               \
+    ENTRY("continue", LexerTokenType::KEYWORD, LexerSymbol::CONTINUE)         \
+    ENTRY("depends", LexerTokenType::KEYWORD, LexerSymbol::DEPENDS)           \
+    ENTRY("new", LexerTokenType::KEYWORD, LexerSymbol::NEW)                   \
+    ENTRY("default", LexerTokenType::KEYWORD, LexerSymbol::DEFAULT)
+
+// An entry in the static keyword table.
+typedef struct {
+    const char* text;
+    size_t length;
+    LexerTokenType type;
+    LexerSymbol symbol;
+} LexerKeyword;
+
+#define LEXER_KEYWORD_ENTRY(k, t, s) { k, sizeof(k) - 1, t, s },
+
+// Table of all keywords, built at compile time from LEXER_KEYWORDS.
+static constexpr LexerKeyword kLexerKeywords[] = {
+    LEXER_KEYWORDS(LEXER_KEYWORD_ENTRY)
+};
+
+static constexpr size_t kLexerKeywordCount = sizeof(kLexerKeywords) / sizeof(kLexerKeywords[0]);
+
+// Number of slots in the keyword hash table. Must be a power of two.
+static constexpr size_t kLexerKeywordSlots = 64;
+
+// Perfect hash for keyword lookup. Only looks at the length and the first
+// and last chars of a name so it is cheap to compute for every NAME.
+// If adding a keyword trips the static_assert below, adjust the multipliers
+// until every keyword lands in its own slot again.
+static constexpr size_t KeywordHash(size_t length, char first, char last) {
+    return ((unsigned char)first + (unsigned char)last * 9 + length * 7) & (kLexerKeywordSlots - 1);
+}
+
+// Hashes an entry in the keyword table.
+static constexpr size_t KeywordHash(const LexerKeyword& keyword) {
+    return KeywordHash(keyword.length, keyword.text[0], keyword.text[keyword.length - 1]);
+}
+
+// Counts the keywords at or after index i that hash to the given slot.
+static constexpr size_t CountKeywordsInSlot(size_t slot, size_t i = 0) {
+    return i == kLexerKeywordCount ? 0 :
+        (KeywordHash(kLexerKeywords[i]) == slot ? 1 : 0) + CountKeywordsInSlot(slot, i + 1);
+}
+
+// Checks that no two keywords at or after index i share a slot.
+static constexpr bool KeywordHashIsPerfect(size_t i = 0) {
+    return i == kLexerKeywordCount ? true :
+        CountKeywordsInSlot(KeywordHash(kLexerKeywords[i])) == 1 && KeywordHashIsPerfect(i + 1);
+}
+
+static_assert(KeywordHashIsPerfect(), "Keywords collide in KeywordHash(), adjust the hash");
+
+// Finds the index of the keyword at or after index i that hashes to the
+// given slot, or -1 if the slot is empty.
+static constexpr int FindKeywordInSlot(size_t slot, size_t i = 0) {
+    return i == kLexerKeywordCount ? -1 :
+        KeywordHash(kLexerKeywords[i]) == slot ? (int)i : FindKeywordInSlot(slot, i + 1);
+}
+
+#define KEYWORD_SLOTS_8(s)                                                    \
+    FindKeywordInSlot(s), FindKeywordInSlot(s + 1),                           \
+    FindKeywordInSlot(s + 2), FindKeywordInSlot(s + 3),                       \
+    FindKeywordInSlot(s + 4), FindKeywordInSlot(s + 5),                       \
+    FindKeywordInSlot(s + 6), FindKeywordInSlot(s + 7)
+
+static_assert(kLexerKeywordSlots == 64, "Update kLexerKeywordSlotTable to match kLexerKeywordSlots");
+
+// Maps each keyword hash slot to its index in kLexerKeywords or -1 if no
+// keyword hashes there. Computed entirely at compile time.
+static constexpr signed char kLexerKeywordSlotTable[kLexerKeywordSlots] = {
+    KEYWORD_SLOTS_8(0), KEYWORD_SLOTS_8(8), KEYWORD_SLOTS_8(16), KEYWORD_SLOTS_8(24),
+    KEYWORD_SLOTS_8(32), KEYWORD_SLOTS_8(40), KEYWORD_SLOTS_8(48), KEYWORD_SLOTS_8(56)
+};
 
-// Constructs a Lexer instance from a LexerSource.
+// Checks if a name is a keyword with one hash and at most one compare.
+// Returns: the keyword's table entry or NULL if the name is not a keyword.
+static const LexerKeyword* MatchKeyword(const char* data, size_t length) {
+    int index = kLexerKeywordSlotTable[KeywordHash(length, data[0], data[length - 1])];
+
+    if (index < 0) {
+        return NULL;
+    }
+
+    const LexerKeyword* keyword = &kLexerKeywords[index];
+    if (keyword->length != length || std::memcmp(keyword->text, data, length) != 0) {
+        return NULL;
+    }
+
+    return keyword;
+}
+
+// Constructs a Lexer instance from a LexerSource with its own private
+// AtomTable.
 // input: the text data to lex.
 // Throws: A LexerException or its subclasses.
-Lexer::Lexer(CompilerSourceInterface& source) {
+Lexer::Lexer(CompilerSourceInterface& source) : owned_atoms_(new AtomTable()) {
+    this->Initialize(source, *this->owned_atoms_);
+}
+
+// Constructs a Lexer instance from a LexerSource that interns NAME and
+// STRING tokens into a caller owned AtomTable shared with later stages.
+// input: the text data to lex.
+// atoms: the compilation's AtomTable. Must outlive the Lexer's tokens.
+// Throws: A LexerException or its subclasses.
+Lexer::Lexer(CompilerSourceInterface& source, AtomTable& atoms) {
+    this->Initialize(source, atoms);
+}
+
+// Initializes lexer state and lexes up to the first token.
+void Lexer::Initialize(CompilerSourceInterface& source, AtomTable& atoms) {
     this->source_ = &source;
+    this->atoms_ = &atoms;
     this->first_load_ = true;
-    this->current_column_number_ = 0;
-    this->current_line_number_ = 0;
-    this->next_column_number_ = 0;
-    this->next_line_number_ = 1;
-
-    // Load the keywords for the keywords table.
-    this->LoadKeywords();
+    this->current_offset_ = 0;
 
     // Parse up to the first token
     this->AdvanceTokens();
 }
 
-// Lexer Class destructor. Frees dynamically allocated strings.
-Lexer::~Lexer() {
-    if (this->valid_current_token_ &&
-        (this->current_token_.type == LexerTokenType::STRING ||
-            this->current_token_.type == LexerTokenType::NAME)) {
-        delete this->current_token_.string_const;
-    }
-
-    if (this->valid_next_token_ &&
-        (this->next_token_.type == LexerTokenType::STRING ||
-            this->next_token_.type == LexerTokenType::NAME)) {
-        delete this->next_token_.string_const;
-    }
-}
+// Lexer Class destructor. NAME and STRING tokens point into the source
+// or the string_arena_ so there is nothing to free per token.
+Lexer::~Lexer() { }
 
 // Advances the current and next token and gets the new
 // current token.
@@ -168,35 +296,36 @@ const LexerToken* Lexer::next_token() const {
     return &this->next_token_;
 }
 
-// Loads keywords into the keywords_map_ in preparation for lexing.
-// Called by constructor.
-void Lexer::LoadKeywords() {
-    // Access Modifiers.
-    DEFINE_KEYWORD("public", LexerTokenType::ACCESS_MODIFIER, LexerSymbol::PUBLIC);
-    DEFINE_KEYWORD("concealed", LexerTokenType::ACCESS_MODIFIER, LexerSymbol::CONCEALED);
-    DEFINE_KEYWORD("package", LexerTokenType::KEYWORD, LexerSymbol::PACKAGE);
-    DEFINE_KEYWORD("internal", LexerTokenType::ACCESS_MODIFIER, LexerSymbol::INTERNAL);
-
-    // Keywords.
-    DEFINE_KEYWORD("spec", LexerTokenType::KEYWORD, LexerSymbol::SPEC);
-    DEFINE_KEYWORD("if", LexerTokenType::KEYWORD, LexerSymbol::IF);
-    DEFINE_KEYWORD("else", LexerTokenType::KEYWORD, LexerSymbol::ELSE);
-    DEFINE_KEYWORD("do", LexerTokenType::KEYWORD, LexerSymbol::DO);
-    DEFINE_KEYWORD("while", LexerTokenType::KEYWORD, LexerSymbol::WHILE);
-    DEFINE_KEYWORD("true", LexerTokenType::KEYWORD, LexerSymbol::KTRUE);
-    DEFINE_KEYWORD("false", LexerTokenType::KEYWORD, LexerSymbol::KFALSE);
-    DEFINE_KEYWORD("return", LexerTokenType::KEYWORD, LexerSymbol::RETURN);
-    DEFINE_KEYWORD("get", LexerTokenType::KEYWORD, LexerSymbol::GET);
-    DEFINE_KEYWORD("set", LexerTokenType::KEYWORD, LexerSymbol::SET);
-    DEFINE_KEYWORD("construct", LexerTokenType::KEYWORD, LexerSymbol::CONSTRUCT);
-    DEFINE_KEYWORD("start", LexerTokenType::KEYWORD, LexerSymbol::START);
-    DEFINE_KEYWORD("readonly", LexerTokenType::KEYWORD, LexerSymbol::READONLY);
-    DEFINE_KEYWORD("for", LexerTokenType::KEYWORD, LexerSymbol::FOR);
-    DEFINE_KEYWORD("break", LexerTokenType::KEYWORD, LexerSymbol::BREAK);
-    DEFINE_KEYWORD("continue", LexerTokenType::KEYWORD, LexerSymbol::CONTINUE);
-    DEFINE_KEYWORD("depends", LexerTokenType::KEYWORD, LexerSymbol::DEPENDS);
-    DEFINE_KEYWORD("new", LexerTokenType::KEYWORD, LexerSymbol::NEW);
-    DEFINE_KEYWORD("default", LexerTokenType::KEYWORD, LexerSymbol::DEFAULT);
+// Pulls the next span of input from the source.
+// Returns: true if there is more input, false if the source is exhausted.
+bool Lexer::NextSpan() {
+    if (this->source_exhausted_) {
+        return false;
+    }
+
+    size_t length = this->source_->NextSpan(
+        &this->cursor_,
+        this->span_buffer_,
+        kLexerSpanBufferSize);
+
+    // Offsets are 32 bits to keep tokens and Nodes small.
+    if (length > UINT32_MAX - this->end_offset()) {
+        THROW_EXCEPTION(
+            this->current_line_number(),
+            this->current_column_number(),
+            STATUS_LEXER_SOURCE_TOO_LARGE);
+    }
+
+    this->span_offset_ = this->end_offset();
+    this->span_begin_ = this->cursor_;
+    this->end_ = this->cursor_ + length;
+    this->source_exhausted_ = length == 0;
+    this->lines_.AddSpan(this->cursor_, this->end_, this->span_offset_);
+
+    // Spans that the source didn't copy into our buffer live as long as
+    // the source does so tokens may point directly into them.
+    this->span_is_stable_ = this->cursor_ != this->span_buffer_;
+    return !this->source_exhausted_;
 }
 
 // Processes and removes comments from code.
@@ -218,18 +347,22 @@ bool Lexer::SkipSingleLineComments() {
         return false;
     }
 
-    while (true) {
-        ADVANCE_CHAR();
+    // Skip the second slash.
+    ADVANCE_CHAR();
 
-        if (PEEK_CHAR() == '\n') {
-            ADVANCE_CHAR();
-            break;
-        }
+    // Skip to the end of the line, a span at a time.
+    while (HAS_CHAR()) {
+        const char* newline = static_cast<const char*>(
+            memchr(this->cursor_, '\n', this->end_ - this->cursor_));
 
-        if (!HAS_CHAR()) {
+        if (newline != NULL) {
+            this->cursor_ = newline + 1;
             break;
         }
+
+        this->cursor_ = this->end_;
     }
+
     return true;
 }
 
@@ -245,30 +378,28 @@ bool Lexer::SkipMultiLineComments() {
     ADVANCE_CHAR();
 
     while (true) {
-
-        if (PEEK_CHAR() == '*') {
-            ADVANCE_CHAR();
-
-            if (PEEK_CHAR() == '/') {
-                ADVANCE_CHAR();
-                break;
-            }
-        }
-        else {
-            ADVANCE_CHAR();
-        }
-
-        if (PEEK_CHAR() == '\n') {
-            this->next_column_number_ = -1;
-            this->next_line_number_++;
-        }
-
         if (!HAS_CHAR()) {
             THROW_EXCEPTION(
                 this->current_line_number(),
                 this->current_column_number(),
                 STATUS_LEXER_UNTERMINATED_COMMENT);
         }
+
+        // Find the next "*/", or a '*' at the end of the span that may be
+        // followed by a '/' at the start of the next one.
+        const char* star = ScanCommentEnd(this->cursor_, this->end_);
+
+        if (star == this->end_) {
+            this->cursor_ = this->end_;
+            continue;
+        }
+
+        this->cursor_ = star + 1;
+
+        if (PEEK_CHAR() == '/') {
+            ADVANCE_CHAR();
+            break;
+        }
     }
 
     return true;
@@ -278,23 +409,22 @@ bool Lexer::SkipMultiLineComments() {
 void Lexer::SkipWhitespace() {
 
     // skip contiguous blocks of whitespace
-    while (PEEK_CHAR() == ' ' ||
-        PEEK_CHAR() == '\t' ||
-        PEEK_CHAR() == '\r' ||
-        PEEK_CHAR() == '\n') {
-        // Return carriage encountered: increment line numbers and c
-        if (PEEK_CHAR() == '\n') {
-            this->next_column_number_ = -1;
-            this->next_line_number_++;
+    while (HAS_CHAR()) {
+        const char* run_end = ScanWhitespace(this->cursor_, this->end_);
+
+        bool end_of_span = run_end == this->end_;
+        this->cursor_ = run_end;
+
+        if (!end_of_span) {
+            break;
         }
-        ADVANCE_CHAR();
     }
 }
 
 // Performs string escaping on popular escape sequences.
-// buffer: A stringstream that will receive the escaped char.
+// buffer: A string that will receive the escaped char.
 // Throws: A LexerException if there is an unknown escape sequence.
-void Lexer::EscapeChar(std::stringstream& buffer) {
+void Lexer::EscapeChar(std::string& buffer) {
     ADVANCE_CHAR();
 
     switch (PEEK_CHAR()) {
@@ -302,26 +432,26 @@ void Lexer::EscapeChar(std::stringstream& buffer) {
     case '"':
     case '?':
     case '\\':
-        buffer << (char)PEEK_CHAR();
+        buffer.push_back((char)PEEK_CHAR());
         break;
 
     case 'b':
-        buffer << '\b';
+        buffer.push_back('\b');
         break;
     case 'n':
-        buffer << '\n';
+        buffer.push_back('\n');
         break;
     case 't':
-        buffer << '\t';
+        buffer.push_back('\t');
         break;
     case 'r':
-        buffer << '\r';
+        buffer.push_back('\r');
         break;
     case 'v':
-        buffer << '\v';
+        buffer.push_back('\v');
         break;
     case 'f':
-        buffer << '\f';
+        buffer.push_back('\f');
         break;
     default:
         THROW_EXCEPTION(
@@ -331,15 +461,72 @@ void Lexer::EscapeChar(std::stringstream& buffer) {
     }
 }
 
+// Copies the chars accumulated in scratch_ into the string_arena_ so
+// that they outlive the next token.
+// Returns: view of the arena copy.
+LexerStringView Lexer::SaveScratch() {
+    LexerStringView view;
+    view.data = this->string_arena_.CopyString(this->scratch_.data(), this->scratch_.length());
+    view.length = this->scratch_.length();
+    return view;
+}
+
+// Parses a string literal and sets it as the next token. Literals without
+// escape sequences point directly into the source. Others are decoded into
+// the string_arena_.
 void Lexer::ParseString() {
-    std::stringstream buffer;
+
+    // Skip the opening quote.
+    ADVANCE_CHAR();
+
+    if (HAS_CHAR() && this->span_is_stable_) {
+        const char* run_end = this->cursor_;
+        while (run_end < this->end_ &&
+            *run_end != '\\' &&
+            *run_end != '\n' &&
+            *run_end != '"') {
+            run_end++;
+        }
+
+        // Fast path: the whole literal is plain chars so refer to it in place.
+        if (run_end < this->end_ && *run_end == '"') {
+            this->valid_next_token_ = true;
+            this->next_token_.type = LexerTokenType::STRING;
+            this->next_token_.string_const.data = this->cursor_;
+            this->next_token_.string_const.length = run_end - this->cursor_;
+            this->next_token_.atom = this->atoms_->Intern(this->cursor_, run_end - this->cursor_);
+            this->cursor_ = run_end;
+            ADVANCE_CHAR();
+            return;
+        }
+    }
+
+    this->scratch_.clear();
 
     while (HAS_CHAR()) {
-        ADVANCE_CHAR();
 
-        switch (PEEK_CHAR()) {
+        // Copy the run of plain chars up to the next char that needs
+        // special handling in one go.
+        const char* run_end = this->cursor_;
+        while (run_end < this->end_ &&
+            *run_end != '\\' &&
+            *run_end != '\n' &&
+            *run_end != '"') {
+            run_end++;
+        }
+
+        this->scratch_.append(this->cursor_, run_end - this->cursor_);
+        this->cursor_ = run_end;
+
+        // Reached end of span, get the next one.
+        if (run_end == this->end_) {
+            continue;
+        }
+
+        switch (*this->cursor_) {
         case '\\':
-            this->EscapeChar(buffer);
+            this->EscapeChar(this->scratch_);
+            ADVANCE_CHAR();
             break;
 
         case '\n':
@@ -351,12 +538,10 @@ void Lexer::ParseString() {
         case '"':
             this->valid_next_token_ = true;
             this->next_token_.type = LexerTokenType::STRING;
-            this->next_token_.string_const = new std::string(buffer.str());
+            this->next_token_.string_const = this->SaveScratch();
+            this->next_token_.atom = this->atoms_->Intern(this->scratch_);
             ADVANCE_CHAR();
             return;
-
-        default:
-            buffer << (char)PEEK_CHAR();
         }
     }
 
@@ -369,74 +554,132 @@ void Lexer::ParseString() {
 // Parses a name or Keyword from the InputStream and sets it as the
 // next token.
 void Lexer::ParseName() {
-    std::stringstream buffer;
+    LexerStringView name;
+    bool name_in_scratch = false;
+
+    const char* run_end = this->cursor_;
+    while (run_end < this->end_ && IS_NAME_CHAR(*run_end)) {
+        run_end++;
+    }
+
+    if (this->span_is_stable_ && run_end != this->end_) {
+        // Fast path: the name lies entirely within a span owned by the
+        // source so refer to it in place.
+        name.data = this->cursor_;
+        name.length = run_end - this->cursor_;
+        this->cursor_ = run_end;
+    }
+    else {
+        // Slow path: the name may continue in the next span or our span
+        // buffer is about to be reused. Accumulate and copy to the arena.
+        this->scratch_.clear();
+
+        while (HAS_CHAR()) {
+            run_end = this->cursor_;
+            while (run_end < this->end_ && IS_NAME_CHAR(*run_end)) {
+                run_end++;
+            }
+
+            this->scratch_.append(this->cursor_, run_end - this->cursor_);
+            this->cursor_ = run_end;
+
+            // Name continues only if it ran into the end of the span.
+            if (run_end != this->end_) {
+                break;
+            }
+        }
 
-    while (isalpha(PEEK_CHAR()) ||
-        isdigit(PEEK_CHAR()) ||
-        PEEK_CHAR() == '_') {
-        buffer << (char)PEEK_CHAR();
-        ADVANCE_CHAR();
+        name.data = this->scratch_.data();
+        name.length = this->scratch_.length();
+        name_in_scratch = true;
     }
 
-    std::string name = buffer.str();
-    try {
-        // Check to see if parsed name is a keyword.
-        std::pair<LexerTokenType, LexerSymbol> value = this->keywords_map_.at(name);
+    // Check to see if parsed name is a keyword.
+    const LexerKeyword* keyword = MatchKeyword(name.data, name.length);
 
-        this->next_token_.type = value.first;
-        this->next_token_.symbol = value.second;
+    if (keyword != NULL) {
+        this->next_token_.type = keyword->type;
+        this->next_token_.symbol = keyword->symbol;
     }
-    catch (const std::out_of_range&) {
-        // Not a keyword, treat as name instead.
+    else {
+        // Not a keyword, treat as name instead. Names accumulated in
+        // scratch_ are copied to the arena before scratch_ is reused.
+        if (name_in_scratch) {
+            name = this->SaveScratch();
+        }
+
         this->next_token_.type = LexerTokenType::NAME;
-        this->next_token_.string_const = new std::string(name);
+        this->next_token_.string_const = name;
+        this->next_token_.atom = this->atoms_->Intern(name.data, name.length);
     }
 
     this->valid_next_token_ = true;
 }
 
+// Most significant digits in a FLOAT literal whose mantissa is always
+// exactly representable as a double (10^15 < 2^53).
+static const int kLexerMaxExactFloatDigits = 15;
+
+// Most fraction digits in a FLOAT literal whose power of ten is exactly
+// representable as a double.
+static const int kLexerMaxExactFloatFractionDigits = 22;
+
+// Exactly representable powers of ten used by the FLOAT fast path.
+static const double kLexerPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
 // Parses a number from the input source into an integer or double
-// constant and stores it in the next_token_.
+// constant and stores it in the next_token_. The number is converted in a
+// single pass over the source span without any allocation. Semantics match
+// the stoi()/stod() based conversion that this replaced: a run of digits is
+// an INT that must fit in an int, a run containing one '.' is a FLOAT that
+// must be a finite normal double, and anything else is malformed.
+// Throws: STATUS_LEXER_MALFORMED_NUMBER if the number is invalid.
 void Lexer::ParseNumber() {
-    std::stringstream buffer;
-    bool is_float = false;
+    const char* run_end = this->cursor_;
+    while (run_end < this->end_ && IS_NUMBER_CHAR(*run_end)) {
+        run_end++;
+    }
 
-    while (isdigit(PEEK_CHAR()) || PEEK_CHAR() == '.') {
-        if (PEEK_CHAR() == '.') {
-            is_float = true;
-        }
+    const char* number;
+    size_t length;
 
-        buffer << (char)PEEK_CHAR();
-        ADVANCE_CHAR();
+    if (this->span_is_stable_ && run_end != this->end_) {
+        // Fast path: convert the number in place in the source.
+        number = this->cursor_;
+        length = run_end - this->cursor_;
+        this->cursor_ = run_end;
     }
+    else {
+        // Slow path: the number may continue in the next span.
+        this->scratch_.clear();
+
+        while (HAS_CHAR()) {
+            run_end = this->cursor_;
+            while (run_end < this->end_ && IS_NUMBER_CHAR(*run_end)) {
+                run_end++;
+            }
 
-    std::string num_str = buffer.str();
+            this->scratch_.append(this->cursor_, run_end - this->cursor_);
+            this->cursor_ = run_end;
 
-    try {
-        size_t consumed_idx = 0;
-        if (is_float) {
-            this->next_token_.type = LexerTokenType::FLOAT;
-            this->next_token_.float_const = stod(num_str, &consumed_idx);
-        }
-        else {
-            this->next_token_.type = LexerTokenType::INT;
-            this->next_token_.int_const = stoi(num_str, &consumed_idx);
+            // Number continues only if it ran into the end of the span.
+            if (run_end != this->end_) {
+                break;
+            }
         }
 
-        if (consumed_idx < num_str.length()) {
-            THROW_EXCEPTION(
-                this->current_line_number(),
-                this->current_column_number(),
-                STATUS_LEXER_MALFORMED_NUMBER);
-        }
-    }
-    catch (const std::invalid_argument&) {
-        THROW_EXCEPTION(
-            this->current_line_number(),
-            this->current_column_number(),
-            STATUS_LEXER_MALFORMED_NUMBER);
+        number = this->scratch_.data();
+        length = this->scratch_.length();
     }
-    catch (const std::out_of_range&) {
+
+    bool valid = memchr(number, '.', length) == NULL ?
+        this->ConvertInteger(number, length) :
+        this->ConvertFloat(number, length);
+
+    if (!valid) {
         THROW_EXCEPTION(
             this->current_line_number(),
             this->current_column_number(),
@@ -446,21 +689,93 @@ void Lexer::ParseNumber() {
     this->valid_next_token_ = true;
 }
 
-// Cleans up tokens and memory from the previous iteration of AdvanceTokens.
-void Lexer::CleanupLast() {
+// Converts a run of digits to an INT token.
+// Returns: false if the value does not fit in an int.
+bool Lexer::ConvertInteger(const char* number, size_t length) {
+    long value = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        int digit = number[i] - '0';
+
+        if (value > (INT_MAX - digit) / 10) {
+            return false;
+        }
+
+        value = (value * 10) + digit;
+    }
+
+    this->next_token_.type = LexerTokenType::INT;
+    this->next_token_.int_const = value;
+    return true;
+}
+
+// Converts a run of digits containing a '.' to a FLOAT token. Numbers with
+// at most 15 significant digits and 22 fraction digits are converted
+// exactly with a single correctly rounded division. Anything longer falls
+// back to strtod() for correct rounding.
+// Returns: false if there is more than one '.' or the value is out of range.
+bool Lexer::ConvertFloat(const char* number, size_t length) {
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int fraction_digits = 0;
+    bool seen_point = false;
+
+    for (size_t i = 0; i < length; i++) {
+        if (number[i] == '.') {
+            if (seen_point) {
+                return false;
+            }
 
-    // Free any old strings before losing the old current_token_ for good.
-    if (this->valid_current_token_ &&
-        (this->current_token_.type == LexerTokenType::STRING ||
-            this->current_token_.type == LexerTokenType::NAME)) {
-        delete this->current_token_.string_const;
+            seen_point = true;
+            continue;
+        }
+
+        if (seen_point) {
+            fraction_digits++;
+        }
+
+        // Leading zeros are not significant.
+        if (mantissa == 0 && number[i] == '0') {
+            continue;
+        }
+
+        // Stop accumulating once we know we're taking the slow path so the
+        // mantissa can't overflow.
+        if (++significant_digits <= kLexerMaxExactFloatDigits) {
+            mantissa = (mantissa * 10) + (number[i] - '0');
+        }
     }
 
+    this->next_token_.type = LexerTokenType::FLOAT;
+
+    // Fast path: both the mantissa and the power of ten are exactly
+    // representable so the quotient is correctly rounded.
+    if (significant_digits <= kLexerMaxExactFloatDigits &&
+        fraction_digits <= kLexerMaxExactFloatFractionDigits) {
+        this->next_token_.float_const = (double)mantissa / kLexerPowersOfTen[fraction_digits];
+        return true;
+    }
+
+    // Slow path: strtod() needs a NULL terminated copy.
+    if (number != this->scratch_.data()) {
+        this->scratch_.assign(number, length);
+    }
+
+    char* parse_end = NULL;
+    errno = 0;
+    this->next_token_.float_const = strtod(this->scratch_.c_str(), &parse_end);
+
+    // strtod() reports both overflow and underflow with ERANGE.
+    return errno != ERANGE && parse_end == this->scratch_.c_str() + length;
+}
+
+// Cleans up tokens from the previous iteration of AdvanceTokens.
+void Lexer::CleanupLast() {
+
     // make old "next" token the "current" token
     this->valid_current_token_ = this->valid_next_token_;
     this->current_token_ = this->next_token_;
-    this->current_column_number_ = this->next_column_number_;
-    this->current_line_number_ = this->next_line_number_;
+    this->current_offset_ = this->cursor_offset();
 
     this->valid_next_token_ = false;
 }
@@ -4,52 +4,79 @@
 #ifndef GUNDERSCRIPT_LEXER__H__
 #define GUNDERSCRIPT_LEXER__H__
 
+#include <cstdint>
+#include <memory>
 #include <sstream>
-#include <unordered_map>
 
+#include "gunderscript/atom_table.h"
 #include "gunderscript/compiler.h"
 #include "gunderscript/exceptions.h"
 
+#include "arena.h"
+#include "line_table.h"
+
 namespace gunderscript {
 namespace compiler {
 
+// Size of the buffer used to pull spans from streaming sources.
+const size_t kLexerSpanBufferSize = 4096;
+
 // Lexer Class definition and Public/Private interfaces.
 class Lexer {
 public:
     Lexer(CompilerSourceInterface& source);
+    Lexer(CompilerSourceInterface& source, AtomTable& atoms);
     ~Lexer();
-    int current_column_number() const { return this->current_column_number_; }
-    int current_line_number() const { return this->current_line_number_; }
-    int next_column_number() const { return this->next_column_number_; }
-    int next_line_number() const { return this->next_line_number_; }
+    uint32_t current_offset() const { return this->current_offset_; }
+    uint32_t next_offset() const { return this->cursor_offset(); }
+    int current_column_number() const { return this->lines_.column_number(this->current_offset()); }
+    int current_line_number() const { return this->lines_.line_number(this->current_offset()); }
+    int next_column_number() const { return this->lines_.column_number(this->next_offset()); }
+    int next_line_number() const { return this->lines_.line_number(this->next_offset()); }
     const LexerToken* AdvanceNext();
     const LexerToken* current_token() const;
     const LexerToken* next_token() const;
     bool has_next() const { return this->next_token() != NULL; }
     CompilerSourceInterface* source() const { return source_; }
+    AtomTable& atoms() const { return *atoms_; }
+    const LineTable& lines() const { return this->lines_; }
 
 private:
     CompilerSourceInterface* source_;
+    AtomTable* atoms_;
+    std::unique_ptr<AtomTable> owned_atoms_;
+    const char* cursor_ = NULL;
+    const char* end_ = NULL;
+    const char* span_begin_ = NULL;
+    uint32_t span_offset_ = 0;
+    bool source_exhausted_ = false;
+    bool span_is_stable_ = false;
+    char span_buffer_[kLexerSpanBufferSize];
+    Arena string_arena_;
+    std::string scratch_;
     bool first_load_;
-    int current_column_number_;
-    int current_line_number_;
-    int next_column_number_;
-    int next_line_number_;
+    uint32_t current_offset_;
+    LineTable lines_;
     bool valid_current_token_ = false;
     bool valid_next_token_ = false;
     LexerToken current_token_;
     LexerToken next_token_;
-    std::unordered_map<std::string, std::pair<LexerTokenType, LexerSymbol> > keywords_map_;
 
-    void LoadKeywords();
+    void Initialize(CompilerSourceInterface& source, AtomTable& atoms);
+    bool NextSpan();
+    uint32_t cursor_offset() const { return this->span_offset_ + (uint32_t)(this->cursor_ - this->span_begin_); }
+    uint32_t end_offset() const { return this->span_offset_ + (uint32_t)(this->end_ - this->span_begin_); }
     bool SkipComments();
     bool SkipSingleLineComments();
     bool SkipMultiLineComments();
     void SkipWhitespace();
-    void EscapeChar(std::stringstream& buffer);
+    void EscapeChar(std::string& buffer);
+    LexerStringView SaveScratch();
     void ParseString();
     void ParseName();
     void ParseNumber();
+    bool ConvertInteger(const char* number, size_t length);
+    bool ConvertFloat(const char* number, size_t length);
     void ParseCharacter();
     void CleanupLast();
     void AdvanceTokens();
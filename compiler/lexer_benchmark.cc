@@ -0,0 +1,266 @@
+// Gunderscript 2 Lexer Benchmark
+// (C) 2016 Christian Gunderman
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "benchmark_macros.h"
+
+#include "gunderscript/compiler_source.h"
+#include "gunderscript/exceptions.h"
+
+#include "lexer.h"
+#include "lexer_scan.h"
+
+using namespace gunderscript;
+using gunderscript::compiler::Lexer;
+using gunderscript::compiler::ScanCommentEnd;
+using gunderscript::compiler::ScanCommentEndScalar;
+using gunderscript::compiler::ScanLineStarts;
+using gunderscript::compiler::ScanLineStartsScalar;
+using gunderscript::compiler::ScanWhitespace;
+using gunderscript::compiler::ScanWhitespaceScalar;
+
+// Number of functions in the generated benchmark script.
+static const int kBenchmarkFunctionCount = 5000;
+
+// Number of timed iterations for each benchmark.
+static const int kBenchmarkIterations = 3;
+
+// Number of small snippets lexed by the snippet benchmark.
+static const int kBenchmarkSnippetCount = 100000;
+
+// Number of rows in the generated constant table script.
+static const int kBenchmarkTableRowCount = 50000;
+
+// Number of functions in the generated comment heavy script.
+static const int kBenchmarkCommentedFunctionCount = 2000;
+
+// Generates a large, realistic looking script similar to the generated
+// script bundles that motivate these benchmarks.
+static std::string GenerateScript(int function_count) {
+    std::ostringstream buffer;
+
+    buffer << "package \"Benchmark\";\n";
+    for (int i = 0; i < function_count; i++) {
+        buffer << "// Generated function number " << i << ".\n"
+            << "public int32 function" << i << "(int32 alpha, float32 beta) {\n"
+            << "    /* Compute something\n"
+            << "       vaguely interesting. */\n"
+            << "    gamma <- alpha * " << i << " + 42;\n"
+            << "    if (gamma >= 100 && beta < 3.25) {\n"
+            << "        return gamma % 7;\n"
+            << "    }\n"
+            << "    for (i <- 0; i < gamma; i <- i + 1) { gamma <- gamma - 1; }\n"
+            << "    return gamma;\n"
+            << "}\n";
+    }
+
+    return buffer.str();
+}
+
+// Generates a script that is mostly numeric literals, like the large
+// lookup tables that generated scripts embed.
+static std::string GenerateConstantTableScript(int row_count) {
+    std::ostringstream buffer;
+
+    buffer << "package \"Benchmark\";\n"
+        << "public float32 table() {\n";
+    for (int i = 0; i < row_count; i++) {
+        buffer << "    row <- " << (i * 7919) % 2147483 << " + " << i << ".0625 * "
+            << (i * 31) % 1000 << " - 0." << (i * 97) % 1000000 << ";\n";
+    }
+    buffer << "    return row;\n"
+        << "}\n";
+
+    return buffer.str();
+}
+
+// Generates a script that is mostly license headers, doc comments, and
+// indentation, like the pretty printed output of script bundlers.
+static std::string GenerateCommentedScript(int function_count) {
+    std::ostringstream buffer;
+
+    buffer << "package \"Benchmark\";\n";
+    for (int i = 0; i < function_count; i++) {
+        buffer << "/*\n";
+        for (int j = 0; j < 8; j++) {
+            buffer << " * Generated documentation line " << j
+                << " for function " << i << ", which does very little.\n";
+        }
+        buffer << " */\n"
+            << "public int32 function" << i << "(int32 alpha) {\n"
+            << "                                                \n"
+            << "                // Returns its argument unchanged.\n"
+            << "                return alpha;\n"
+            << "}\n\n\n";
+    }
+
+    return buffer.str();
+}
+
+// Writes the benchmark script to disk and removes it when done.
+class ScriptFile {
+public:
+    ScriptFile(const std::string& file_name, const std::string& contents)
+        : file_name_(file_name) {
+        std::ofstream file_stream(file_name, std::ios_base::out | std::ios_base::binary);
+        file_stream << contents;
+    }
+
+    ~ScriptFile() { std::remove(this->file_name_.c_str()); }
+
+    const std::string& file_name() const { return this->file_name_; }
+
+private:
+    const std::string file_name_;
+};
+
+// Source that only implements the per char interface, so the lexer has
+// to pull its input through the buffered NextSpan() fallback.
+class StreamingStringSource : public CompilerSourceInterface {
+public:
+    StreamingStringSource(const std::string& input) : input_(input) { }
+    bool has_next() { return this->index_ < this->input_.length(); }
+    int NextChar() { return has_next() ? this->input_[this->index_++] : -1; }
+    int PeekNextChar() { return has_next() ? this->input_[this->index_] : -1; }
+private:
+    const std::string& input_;
+    size_t index_ = 0;
+};
+
+// Lexes the entire source and returns the number of tokens.
+static int LexAll(CompilerSourceInterface& source) {
+    Lexer lexer(source);
+    int count = 0;
+
+    while (lexer.AdvanceNext() != NULL) {
+        count++;
+    }
+
+    return count;
+}
+
+// Compares lexing throughput of the fstream backed file source against
+// the memory mapped file source.
+TEST(LexerBenchmark, FileSourceVersusMappedFileSource) {
+    ScriptFile script("lexer_benchmark_script.gs", GenerateScript(kBenchmarkFunctionCount));
+
+    int file_tokens = 0;
+    double file_us = BENCHMARK_RUN("CompilerFileSource", kBenchmarkIterations,
+        CompilerFileSource source(script.file_name());
+        file_tokens = LexAll(source));
+
+    int mapped_tokens = 0;
+    double mapped_us = BENCHMARK_RUN("CompilerMappedFileSource", kBenchmarkIterations,
+        CompilerMappedFileSource source(script.file_name());
+        mapped_tokens = LexAll(source));
+
+    BENCHMARK_REPORT_SPEEDUP(file_us, mapped_us);
+
+    // Both sources must produce the same token stream length.
+    ASSERT_EQ(file_tokens, mapped_tokens);
+}
+
+// Compares lexing a source that hands the lexer one contiguous span against
+// one that can only stream a char at a time.
+TEST(LexerBenchmark, SpanSourceVersusStreamingSource) {
+    std::string input = GenerateScript(kBenchmarkFunctionCount);
+
+    int streaming_tokens = 0;
+    double streaming_us = BENCHMARK_RUN("Streaming source", kBenchmarkIterations,
+        StreamingStringSource source(input);
+        streaming_tokens = LexAll(source));
+
+    int span_tokens = 0;
+    double span_us = BENCHMARK_RUN("Span source", kBenchmarkIterations,
+        CompilerStringSource source(input);
+        span_tokens = LexAll(source));
+
+    BENCHMARK_REPORT_SPEEDUP(streaming_us, span_us);
+
+    ASSERT_EQ(streaming_tokens, span_tokens);
+}
+
+// Lexes many tiny snippets, each with a fresh Lexer, the way an embedding
+// host compiling lots of small scripts would. Dominated by per Lexer setup
+// and keyword recognition.
+TEST(LexerBenchmark, SmallSnippets) {
+    std::string input = "if (x < 10) { return y; } else { return default(int32); }";
+
+    int tokens = 0;
+    BENCHMARK_RUN("Small snippets", kBenchmarkIterations,
+        for (int i = 0; i < kBenchmarkSnippetCount; i++) {
+            CompilerStringSource source(input);
+            tokens += LexAll(source);
+        });
+
+    ASSERT_EQ(kBenchmarkIterations * kBenchmarkSnippetCount * 20, tokens);
+}
+
+// Lexes a script that is dominated by INT and FLOAT literals.
+TEST(LexerBenchmark, NumericLiterals) {
+    std::string input = GenerateConstantTableScript(kBenchmarkTableRowCount);
+
+    int tokens = 0;
+    BENCHMARK_RUN("Numeric literals", kBenchmarkIterations,
+        CompilerStringSource source(input);
+        tokens = LexAll(source));
+
+    ASSERT_EQ(kBenchmarkTableRowCount * 10 + 13, tokens);
+}
+
+// Compares the scalar and vector scanning kernels on their own, then lexes
+// a script dominated by comments and indentation.
+TEST(LexerBenchmark, CommentsAndWhitespace) {
+    std::string input = GenerateCommentedScript(kBenchmarkCommentedFunctionCount);
+    const char* begin = input.data();
+    const char* end = begin + input.length();
+
+    // Find every comment end the way the Lexer does, one span at a time.
+    int scalar_count = 0;
+    double scalar_us = BENCHMARK_RUN("Scalar comment and newline scan", kBenchmarkIterations,
+        std::vector<uint32_t> line_starts;
+        for (const char* i = begin; (i = ScanCommentEndScalar(i, end)) != end; i++) {
+            scalar_count++;
+        }
+        ScanLineStartsScalar(begin, end, 0, line_starts);
+        scalar_count += (int)line_starts.size());
+
+    int vector_count = 0;
+    double vector_us = BENCHMARK_RUN("Vector comment and newline scan", kBenchmarkIterations,
+        std::vector<uint32_t> line_starts;
+        for (const char* i = begin; (i = ScanCommentEnd(i, end)) != end; i++) {
+            vector_count++;
+        }
+        ScanLineStarts(begin, end, 0, line_starts);
+        vector_count += (int)line_starts.size());
+
+    BENCHMARK_REPORT_SPEEDUP(scalar_us, vector_us);
+    ASSERT_EQ(scalar_count, vector_count);
+
+    std::string indentation(1 << 20, ' ');
+    indentation.push_back('x');
+    const char* whitespace_end = indentation.data() + indentation.length();
+
+    const char* scalar_stop = NULL;
+    double scalar_whitespace_us = BENCHMARK_RUN("Scalar whitespace scan", kBenchmarkIterations,
+        scalar_stop = ScanWhitespaceScalar(indentation.data(), whitespace_end));
+
+    const char* vector_stop = NULL;
+    double vector_whitespace_us = BENCHMARK_RUN("Vector whitespace scan", kBenchmarkIterations,
+        vector_stop = ScanWhitespace(indentation.data(), whitespace_end));
+
+    BENCHMARK_REPORT_SPEEDUP(scalar_whitespace_us, vector_whitespace_us);
+    ASSERT_EQ(scalar_stop, vector_stop);
+
+    int tokens = 0;
+    BENCHMARK_RUN("Commented script", kBenchmarkIterations,
+        CompilerStringSource source(input);
+        tokens = LexAll(source));
+
+    ASSERT_EQ(kBenchmarkCommentedFunctionCount * 12 + 3, tokens);
+}
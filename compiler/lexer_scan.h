@@ -0,0 +1,233 @@
+// Gunderscript-2 Lexer Scanning Kernels
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_LEXER_SCAN__H__
+#define GUNDERSCRIPT_LEXER_SCAN__H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Pick the widest vector instruction set the compiler is targeting. SSE2 is
+// part of the x86-64 baseline. AVX2 is only used if the build enables it
+// (e.g.: -mavx2 or -march=native). Everything else uses the scalar kernels.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define GUNDERSCRIPT_LEXER_SCAN_AVX2
+#define GUNDERSCRIPT_LEXER_SCAN_SSE2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GUNDERSCRIPT_LEXER_SCAN_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace gunderscript {
+namespace compiler {
+
+// These kernels find the end of whitespace runs and comments and the start
+// of each line in the source. Each works over a
+// contiguous [begin, end) range and never reads outside of it, so they are
+// safe to use on memory mapped sources. The vector kernels handle whole
+// blocks and hand the tail to the scalar kernels, which are also the
+// reference implementation that the vector kernels are tested against.
+
+// Checks if c is one of the whitespace chars skipped by the Lexer.
+inline bool IsLexerWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Gets the index of the lowest set bit. mask must not be zero.
+inline int ScanLowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Finds the first char that is not whitespace.
+// Returns: a pointer to the char or end if the range is all whitespace.
+inline const char* ScanWhitespaceScalar(const char* begin, const char* end) {
+    while (begin < end && IsLexerWhitespace(*begin)) {
+        begin++;
+    }
+
+    return begin;
+}
+
+// Finds the first '*' that either ends a comment or is the last char in the
+// range, in which case the '/' may be at the start of the next span.
+// Returns: a pointer to the '*' or end if there is none.
+inline const char* ScanCommentEndScalar(const char* begin, const char* end) {
+    for (; begin < end; begin++) {
+        if (*begin == '*' && (begin + 1 == end || begin[1] == '/')) {
+            return begin;
+        }
+    }
+
+    return end;
+}
+
+// Finds the newlines in a range and records where the following lines start.
+// begin_offset: the offset of begin from the start of the source.
+// line_starts: receives the offset of the char after each newline.
+inline void ScanLineStartsScalar(
+    const char* begin,
+    const char* end,
+    uint32_t begin_offset,
+    std::vector<uint32_t>& line_starts) {
+
+    for (const char* i = begin; i < end; i++) {
+        if (*i == '\n') {
+            line_starts.push_back(begin_offset + (uint32_t)(i - begin) + 1);
+        }
+    }
+}
+
+// Vector version of ScanWhitespaceScalar().
+inline const char* ScanWhitespace(const char* begin, const char* end) {
+#if defined(GUNDERSCRIPT_LEXER_SCAN_AVX2)
+    const __m256i space32 = _mm256_set1_epi8(' ');
+    const __m256i tab32 = _mm256_set1_epi8('\t');
+    const __m256i cr32 = _mm256_set1_epi8('\r');
+    const __m256i lf32 = _mm256_set1_epi8('\n');
+
+    while (end - begin >= 32) {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        __m256i whitespace = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chars, space32), _mm256_cmpeq_epi8(chars, tab32)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chars, cr32), _mm256_cmpeq_epi8(chars, lf32)));
+        unsigned int other = ~(unsigned int)_mm256_movemask_epi8(whitespace);
+
+        if (other != 0) {
+            return begin + ScanLowestBit(other);
+        }
+
+        begin += 32;
+    }
+#endif // GUNDERSCRIPT_LEXER_SCAN_AVX2
+
+#if defined(GUNDERSCRIPT_LEXER_SCAN_SSE2)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    while (end - begin >= 16) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        __m128i whitespace = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chars, space), _mm_cmpeq_epi8(chars, tab)),
+            _mm_or_si128(_mm_cmpeq_epi8(chars, cr), _mm_cmpeq_epi8(chars, lf)));
+        unsigned int other = ~(unsigned int)_mm_movemask_epi8(whitespace) & 0xFFFF;
+
+        if (other != 0) {
+            return begin + ScanLowestBit(other);
+        }
+
+        begin += 16;
+    }
+#endif // GUNDERSCRIPT_LEXER_SCAN_SSE2
+
+    return ScanWhitespaceScalar(begin, end);
+}
+
+// Vector version of ScanCommentEndScalar(). Compares each block against '*'
+// and the block one char later against '/' to find "*/" pairs.
+inline const char* ScanCommentEnd(const char* begin, const char* end) {
+#if defined(GUNDERSCRIPT_LEXER_SCAN_AVX2)
+    const __m256i star32 = _mm256_set1_epi8('*');
+    const __m256i slash32 = _mm256_set1_epi8('/');
+
+    while (end - begin >= 33) {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        __m256i next_chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin + 1));
+        unsigned int found = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(chars, star32),
+            _mm256_cmpeq_epi8(next_chars, slash32)));
+
+        if (found != 0) {
+            return begin + ScanLowestBit(found);
+        }
+
+        begin += 32;
+    }
+#endif // GUNDERSCRIPT_LEXER_SCAN_AVX2
+
+#if defined(GUNDERSCRIPT_LEXER_SCAN_SSE2)
+    const __m128i star = _mm_set1_epi8('*');
+    const __m128i slash = _mm_set1_epi8('/');
+
+    while (end - begin >= 17) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        __m128i next_chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + 1));
+        unsigned int found = (unsigned int)_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(chars, star),
+            _mm_cmpeq_epi8(next_chars, slash)));
+
+        if (found != 0) {
+            return begin + ScanLowestBit(found);
+        }
+
+        begin += 16;
+    }
+#endif // GUNDERSCRIPT_LEXER_SCAN_SSE2
+
+    return ScanCommentEndScalar(begin, end);
+}
+
+// Vector version of ScanLineStartsScalar(). Most blocks have no newlines so
+// the bit by bit loop only runs for blocks that do.
+inline void ScanLineStarts(
+    const char* begin,
+    const char* end,
+    uint32_t begin_offset,
+    std::vector<uint32_t>& line_starts) {
+
+    const char* block = begin;
+
+#if defined(GUNDERSCRIPT_LEXER_SCAN_AVX2)
+    const __m256i lf32 = _mm256_set1_epi8('\n');
+
+    while (end - block >= 32) {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        unsigned int newlines = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, lf32));
+        uint32_t block_offset = begin_offset + (uint32_t)(block - begin) + 1;
+
+        while (newlines != 0) {
+            line_starts.push_back(block_offset + ScanLowestBit(newlines));
+            newlines &= newlines - 1;
+        }
+
+        block += 32;
+    }
+#endif // GUNDERSCRIPT_LEXER_SCAN_AVX2
+
+#if defined(GUNDERSCRIPT_LEXER_SCAN_SSE2)
+    const __m128i lf = _mm_set1_epi8('\n');
+
+    while (end - block >= 16) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        unsigned int newlines = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, lf));
+        uint32_t block_offset = begin_offset + (uint32_t)(block - begin) + 1;
+
+        while (newlines != 0) {
+            line_starts.push_back(block_offset + ScanLowestBit(newlines));
+            newlines &= newlines - 1;
+        }
+
+        block += 16;
+    }
+#endif // GUNDERSCRIPT_LEXER_SCAN_SSE2
+
+    ScanLineStartsScalar(block, end, begin_offset + (uint32_t)(block - begin), line_starts);
+}
+
+} // namespace compiler
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_LEXER_SCAN__H__
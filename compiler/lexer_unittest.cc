@@ -1,12 +1,18 @@
 // Gunderscript 2 Lexer Unit Test
 // (C) 2014-2016 Christian Gunderman
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "testing_macros.h"
 
 #include "gunderscript/exceptions.h"
 
 #include "lexer.h"
+#include "lexer_scan.h"
 
 using namespace gunderscript;
 using gunderscript::compiler::Lexer;
@@ -64,6 +70,147 @@ TEST(Lexer, CompilerStringSource) {
     ASSERT_FALSE(source.has_next());
 }
 
+// Checks the CompilerMappedFileSource class to make sure that
+// it reads files correctly.
+TEST(Lexer, CompilerMappedFileSource) {
+    const std::string file_name("lexer_unittest_mapped_source.gs");
+    {
+        std::ofstream file_stream(file_name, std::ios_base::out | std::ios_base::binary);
+        file_stream << "ab\nc";
+    }
+
+    {
+        CompilerMappedFileSource source(file_name);
+
+        ASSERT_EQ(4U, source.length());
+        ASSERT_EQ(0, memcmp("ab\nc", source.data(), 4));
+
+        ASSERT_TRUE(source.has_next());
+        ASSERT_EQ('a', source.PeekNextChar());
+        ASSERT_EQ('a', source.NextChar());
+        ASSERT_EQ('b', source.NextChar());
+        ASSERT_EQ('\n', source.NextChar());
+
+        ASSERT_TRUE(source.has_next());
+        ASSERT_EQ('c', source.PeekNextChar());
+        ASSERT_EQ('c', source.NextChar());
+
+        ASSERT_FALSE(source.has_next());
+        ASSERT_EQ(-1, source.PeekNextChar());
+        ASSERT_EQ(-1, source.NextChar());
+    }
+
+    std::remove(file_name.c_str());
+}
+
+// Checks that CompilerMappedFileSource reports missing files.
+TEST(Lexer, CompilerMappedFileSourceMissingFile) {
+    EXPECT_STATUS(CompilerMappedFileSource source("lexer_unittest_missing_file.gs"),
+        STATUS_FILESOURCE_FILE_READ_ERROR);
+}
+
+// Source that only implements the per char interface, forcing the lexer
+// to pull its input through the buffered NextSpan() fallback.
+class StreamingStringSource : public CompilerSourceInterface {
+public:
+    StreamingStringSource(const std::string& input) : input_(input) { }
+    bool has_next() { return this->index_ < this->input_.length(); }
+    int NextChar() { return has_next() ? this->input_[this->index_++] : -1; }
+    int PeekNextChar() { return has_next() ? this->input_[this->index_] : -1; }
+private:
+    const std::string input_;
+    size_t index_ = 0;
+};
+
+// Checks that a streaming source produces the same tokens and positions
+// as a contiguous one, including tokens split across span boundaries.
+TEST(Lexer, StreamingSourceMatchesContiguousSource) {
+    std::string input;
+    for (int i = 0; i < 1000; i++) {
+        input += "/* comment\n */ name_" + std::to_string(i) +
+            " <- \"str\\n\" + 12.5 * 3; // end\n";
+    }
+
+    CompilerStringSource contiguous_source(input);
+    StreamingStringSource streaming_source(input);
+    Lexer contiguous_lexer(contiguous_source);
+    Lexer streaming_lexer(streaming_source);
+
+    while (contiguous_lexer.AdvanceNext() != NULL) {
+        const LexerToken* expected = contiguous_lexer.current_token();
+        const LexerToken* actual = streaming_lexer.AdvanceNext();
+
+        ASSERT_FALSE(actual == NULL);
+        ASSERT_EQ(expected->type, actual->type);
+        ASSERT_EQ(contiguous_lexer.current_line_number(), streaming_lexer.current_line_number());
+        ASSERT_EQ(contiguous_lexer.current_column_number(), streaming_lexer.current_column_number());
+
+        if (expected->type == LexerTokenType::NAME || expected->type == LexerTokenType::STRING) {
+            ASSERT_EQ(expected->string_const.str(), actual->string_const.str());
+        }
+    }
+
+    ASSERT_TRUE(streaming_lexer.AdvanceNext() == NULL);
+}
+
+// Checks that the vector scanning kernels agree with the scalar ones for
+// every length and alignment, including matches that straddle blocks.
+TEST(Lexer, ScanKernelsMatchScalar) {
+    const char alphabet[] = { ' ', '\t', '\r', '\n', '*', '/', 'a' };
+    char buffer[160];
+    unsigned int seed = 1;
+
+    for (int trial = 0; trial < 2000; trial++) {
+        for (size_t i = 0; i < sizeof(buffer); i++) {
+            seed = seed * 1103515245 + 12345;
+
+            // Bias towards long whitespace runs so the kernels cross blocks.
+            buffer[i] = alphabet[(seed >> 16) % (trial % 2 == 0 ? 4 : sizeof(alphabet))];
+        }
+
+        size_t begin = trial % 37;
+        size_t end = begin + (trial * 7) % (sizeof(buffer) - begin);
+
+        ASSERT_EQ(
+            compiler::ScanWhitespaceScalar(buffer + begin, buffer + end),
+            compiler::ScanWhitespace(buffer + begin, buffer + end));
+        ASSERT_EQ(
+            compiler::ScanCommentEndScalar(buffer + begin, buffer + end),
+            compiler::ScanCommentEnd(buffer + begin, buffer + end));
+
+        std::vector<uint32_t> scalar_line_starts;
+        std::vector<uint32_t> vector_line_starts;
+        compiler::ScanLineStartsScalar(buffer + begin, buffer + end, trial, scalar_line_starts);
+        compiler::ScanLineStarts(buffer + begin, buffer + end, trial, vector_line_starts);
+        ASSERT_EQ(scalar_line_starts, vector_line_starts);
+    }
+}
+
+// Checks that line and column numbers are tracked across long whitespace
+// runs and comments that the vector kernels skip in blocks.
+TEST(Lexer, LineNumbersLongWhitespaceAndComments) {
+    std::string input = std::string(100, ' ') + "a" + std::string(40, '\n') +
+        std::string(37, '\t') + "b /*" + std::string(50, '*') + "\n**\n" +
+        std::string(70, 'x') + "*/ c";
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(1, lexer.current_line_number());
+    EXPECT_EQ(101, lexer.current_column_number());
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(41, lexer.current_line_number());
+    EXPECT_EQ(38, lexer.current_column_number());
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_STREQ("c", lexer.current_token()->string_const.str().c_str());
+    EXPECT_EQ(43, lexer.current_line_number());
+    EXPECT_EQ(74, lexer.current_column_number());
+
+    ASSERT_TRUE(lexer.AdvanceNext() == NULL);
+}
+
 // Checks to make sure whitespace is recognized and removed.
 TEST(Lexer, LexerWhitespace) {
     std::string input = " \n \t  = \n\t  ! \r";
@@ -373,6 +520,29 @@ TEST(Lexer, LineNumberComment) {
     EXPECT_TRUE(lexer.AdvanceNext() == NULL);
 }
 
+// Checks that the newline ending a single line comment and a newline right
+// after the start of a multiline comment both count as new lines.
+TEST(Lexer, LineNumbersCommentNewlines) {
+    std::string input = "a // b\n/*\n*/ c\nd";
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(1, lexer.current_line_number());
+    EXPECT_EQ(1, lexer.current_column_number());
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(3, lexer.current_line_number());
+    EXPECT_EQ(4, lexer.current_column_number());
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(4, lexer.current_line_number());
+    EXPECT_EQ(1, lexer.current_column_number());
+    EXPECT_EQ(input.length(), lexer.current_offset());
+
+    ASSERT_TRUE(lexer.AdvanceNext() == NULL);
+}
+
 TEST(Lexer, LexRegularString) {
     std::string input = " \"Hello\" +";
     CompilerStringSource source(input);
@@ -381,7 +551,7 @@ TEST(Lexer, LexRegularString) {
     lexer.AdvanceNext();
     ASSERT_FALSE(lexer.current_token() == NULL);
     EXPECT_EQ(LexerTokenType::STRING, lexer.current_token()->type);
-    EXPECT_STREQ("Hello", lexer.current_token()->string_const->c_str());
+    EXPECT_STREQ("Hello", lexer.current_token()->string_const.str().c_str());
 
     lexer.AdvanceNext();
     ASSERT_FALSE(lexer.current_token() == NULL);
@@ -414,7 +584,7 @@ TEST(Lexer, LexEscapedString) {
     ASSERT_FALSE(lexer.current_token() == NULL);
     EXPECT_EQ(LexerTokenType::STRING, lexer.current_token()->type);
     EXPECT_STREQ("  '  \"  ?  \\  \b  \n  \t  \r  \v  \f  ",
-        lexer.current_token()->string_const->c_str());
+        lexer.current_token()->string_const.str().c_str());
 
     ASSERT_TRUE(lexer.AdvanceNext() == NULL);
 }
@@ -434,7 +604,7 @@ TEST(Lexer, ParseNameKeyword) {
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::NAME, lexer.current_token()->type);
-    EXPECT_STREQ("hello", lexer.current_token()->string_const->c_str());
+    EXPECT_STREQ("hello", lexer.current_token()->string_const.str().c_str());
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::KEYWORD, lexer.current_token()->type);
@@ -447,6 +617,54 @@ TEST(Lexer, ParseNameKeyword) {
     ASSERT_TRUE(lexer.AdvanceNext() == NULL);
 }
 
+// Checks that names that are prefixes, extensions, or case variants of
+// keywords, or that share a keyword's hash slot, are lexed as NAMEs.
+TEST(Lexer, ParseNameNearKeywords) {
+    const char* names[] = {
+        "i", "fo", "fore", "publi", "publicx", "Public", "iff", "dO", "news",
+        "defaulT", "constructs", "x", "f", "fr", "sec", "sat", "continu"
+    };
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        std::string input = names[i];
+        CompilerStringSource source(input);
+        Lexer lexer(source);
+
+        ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+        EXPECT_EQ(LexerTokenType::NAME, lexer.current_token()->type) << names[i];
+        EXPECT_STREQ(names[i], lexer.current_token()->string_const.str().c_str());
+        ASSERT_TRUE(lexer.AdvanceNext() == NULL);
+    }
+}
+
+// Checks that NAME and STRING tokens are interned into a shared AtomTable
+// so that repeated identifiers compare equal by atom.
+TEST(Lexer, NamesInternedInSharedAtomTable) {
+    std::string input = "foo bar foo \"foo\"";
+    CompilerStringSource source(input);
+    AtomTable atoms;
+    Lexer lexer(source, atoms);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    Atom foo = lexer.current_token()->atom;
+    EXPECT_STREQ("foo", foo.str().c_str());
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    Atom bar = lexer.current_token()->atom;
+    EXPECT_TRUE(foo != bar);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_TRUE(foo == lexer.current_token()->atom);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(LexerTokenType::STRING, lexer.current_token()->type);
+    EXPECT_TRUE(foo == lexer.current_token()->atom);
+
+    ASSERT_TRUE(lexer.AdvanceNext() == NULL);
+    EXPECT_TRUE(&lexer.atoms() == &atoms);
+    EXPECT_EQ(2, atoms.size());
+}
+
 // Tests for keyword recognition:
 TEST_KEYWORD(PUBLIC, "public", LexerTokenType::ACCESS_MODIFIER, LexerSymbol::PUBLIC);
 TEST_KEYWORD(CONCEALED, "concealed", LexerTokenType::ACCESS_MODIFIER, LexerSymbol::CONCEALED);
@@ -501,6 +719,31 @@ TEST(Lexer, ParseIntegerOutOfRange) {
         STATUS_LEXER_MALFORMED_NUMBER);
 }
 
+// Checks the boundaries of the int range.
+TEST(Lexer, ParseIntegerLimits) {
+    std::string input = "2147483647 0000000000002147483647 0";
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(LexerTokenType::INT, lexer.current_token()->type);
+    EXPECT_EQ(2147483647, lexer.current_token()->int_const);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(2147483647, lexer.current_token()->int_const);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(0, lexer.current_token()->int_const);
+
+    ASSERT_TRUE(lexer.AdvanceNext() == NULL);
+
+    std::string overflow_input = "2147483648";
+    CompilerStringSource overflow_source(overflow_input);
+
+    EXPECT_STATUS(Lexer overflow_lexer(overflow_source),
+        STATUS_LEXER_MALFORMED_NUMBER);
+}
+
 TEST(Lexer, ParseFloats) {
     std::string input = "123.456 / 43.2";
     CompilerStringSource source(input);
@@ -521,6 +764,42 @@ TEST(Lexer, ParseFloats) {
     ASSERT_TRUE(lexer.AdvanceNext() == NULL);
 }
 
+// Checks that floats that don't fit the exact fast path are still
+// correctly rounded and that trailing decimal points are allowed.
+TEST(Lexer, ParseFloatsRounding) {
+    std::string input = "0.1000000000000000055511151231257827 9007199254740993.0 "
+        "0.30000000000000004 1. 0.000001";
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(0.1, lexer.current_token()->float_const);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(9007199254740992.0, lexer.current_token()->float_const);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(0.1 + 0.2, lexer.current_token()->float_const);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(LexerTokenType::FLOAT, lexer.current_token()->type);
+    EXPECT_EQ(1.0, lexer.current_token()->float_const);
+
+    ASSERT_FALSE(lexer.AdvanceNext() == NULL);
+    EXPECT_EQ(0.000001, lexer.current_token()->float_const);
+
+    ASSERT_TRUE(lexer.AdvanceNext() == NULL);
+}
+
+// Checks that floats outside of the range of a double are malformed.
+TEST(Lexer, ParseFloatOutOfRange) {
+    std::string input = std::string(400, '9') + ".0";
+    CompilerStringSource source(input);
+
+    EXPECT_STATUS(Lexer lexer(source),
+        STATUS_LEXER_MALFORMED_NUMBER);
+}
+
 TEST(Lexer, ParseFloatsWithMultipleDecimals) {
     std::string input = "34.43.3";
     CompilerStringSource source(input);
@@ -589,11 +868,11 @@ TEST(Lexer, FunctionExample) {
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::NAME, lexer.current_token()->type);
-    EXPECT_STREQ("int", lexer.current_token()->string_const->c_str());
+    EXPECT_STREQ("int", lexer.current_token()->string_const.str().c_str());
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::NAME, lexer.current_token()->type);
-    EXPECT_STREQ("PrintFormat", lexer.current_token()->string_const->c_str());
+    EXPECT_STREQ("PrintFormat", lexer.current_token()->string_const.str().c_str());
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::SYMBOL, lexer.current_token()->type);
@@ -601,11 +880,11 @@ TEST(Lexer, FunctionExample) {
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::NAME, lexer.current_token()->type);
-    EXPECT_STREQ("string", lexer.current_token()->string_const->c_str());
+    EXPECT_STREQ("string", lexer.current_token()->string_const.str().c_str());
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::NAME, lexer.current_token()->type);
-    EXPECT_STREQ("foobar", lexer.current_token()->string_const->c_str());
+    EXPECT_STREQ("foobar", lexer.current_token()->string_const.str().c_str());
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::SYMBOL, lexer.current_token()->type);
@@ -617,11 +896,11 @@ TEST(Lexer, FunctionExample) {
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::NAME, lexer.current_token()->type);
-    EXPECT_STREQ("int", lexer.current_token()->string_const->c_str());
+    EXPECT_STREQ("int", lexer.current_token()->string_const.str().c_str());
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::NAME, lexer.current_token()->type);
-    EXPECT_STREQ("x", lexer.current_token()->string_const->c_str());
+    EXPECT_STREQ("x", lexer.current_token()->string_const.str().c_str());
 
     ASSERT_FALSE(lexer.AdvanceNext() == NULL);
     EXPECT_EQ(LexerTokenType::SYMBOL, lexer.current_token()->type);
@@ -0,0 +1,39 @@
+// Gunderscript-2 Source Line Table
+// (C) 2016 Christian Gunderman
+
+#include <algorithm>
+
+#include "gs_assert.h"
+#include "lexer_scan.h"
+#include "line_table.h"
+
+namespace gunderscript {
+namespace compiler {
+
+// Records the start of every line in the next span of the source. Spans
+// must be added in order.
+// begin: the first char of the span.
+// end: one past the last char of the span.
+// begin_offset: the offset of begin from the start of the source.
+void LineTable::AddSpan(const char* begin, const char* end, uint32_t begin_offset) {
+    GS_ASSERT_TRUE(begin_offset >= this->line_starts_.back(), "LineTable spans added out of order");
+
+    ScanLineStarts(begin, end, begin_offset, this->line_starts_);
+}
+
+// Gets the line number of an offset. Binary searches the line starts so
+// this is only meant to be called when reporting a position.
+int LineTable::line_number(uint32_t offset) const {
+    return (int)(std::upper_bound(
+        this->line_starts_.begin(),
+        this->line_starts_.end(),
+        offset) - this->line_starts_.begin());
+}
+
+// Gets the column number of an offset.
+int LineTable::column_number(uint32_t offset) const {
+    return (int)(offset - this->line_starts_[this->line_number(offset) - 1]);
+}
+
+} // namespace compiler
+} // namespace gunderscript
@@ -0,0 +1,36 @@
+// Gunderscript-2 Source Line Table
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_LINE_TABLE__H__
+#define GUNDERSCRIPT_LINE_TABLE__H__
+
+#include <cstdint>
+#include <vector>
+
+namespace gunderscript {
+namespace compiler {
+
+// Maps byte offsets in a source to line and column numbers. Tokens and AST
+// Nodes only record a 32 bit offset. The Lexer adds each span of the source
+// to the table as it reads it and line and column numbers are only looked
+// up when an error is reported or debug output is requested.
+// Lines are numbered from 1. The column of an offset is the number of chars
+// before it on its line.
+class LineTable {
+public:
+    LineTable() : line_starts_(1, 0) { }
+
+    void AddSpan(const char* begin, const char* end, uint32_t begin_offset);
+    int line_number(uint32_t offset) const;
+    int column_number(uint32_t offset) const;
+    size_t line_count() const { return this->line_starts_.size(); }
+
+private:
+    // Offset of the first char of each line, in increasing order.
+    std::vector<uint32_t> line_starts_;
+};
+
+} // namespace compiler
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_LINE_TABLE__H__
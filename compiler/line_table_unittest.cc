@@ -0,0 +1,58 @@
+// Gunderscript 2 Line Table Unit Test
+// (C) 2016 Christian Gunderman
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+#include "line_table.h"
+
+using namespace gunderscript::compiler;
+
+// Checks that offsets map to the right line and column, including offsets
+// right before and after a newline.
+TEST(LineTable, LineAndColumnNumbers) {
+    const char* input = "ab\n\ncde\nf";
+    LineTable lines;
+    lines.AddSpan(input, input + std::strlen(input), 0);
+
+    ASSERT_EQ(4, lines.line_count());
+
+    ASSERT_EQ(1, lines.line_number(0));
+    ASSERT_EQ(0, lines.column_number(0));
+    ASSERT_EQ(1, lines.line_number(2));
+    ASSERT_EQ(2, lines.column_number(2));
+    ASSERT_EQ(2, lines.line_number(3));
+    ASSERT_EQ(0, lines.column_number(3));
+    ASSERT_EQ(3, lines.line_number(7));
+    ASSERT_EQ(3, lines.column_number(7));
+    ASSERT_EQ(4, lines.line_number(9));
+    ASSERT_EQ(1, lines.column_number(9));
+}
+
+// Checks that a source added a span at a time produces the same table as
+// one added all at once, even when newlines fall on span boundaries.
+TEST(LineTable, SpansMatchWholeSource) {
+    std::string input;
+    for (int i = 0; i < 500; i++) {
+        input.append(i % 7, ' ');
+        input.push_back(i % 3 == 0 ? '\n' : 'x');
+    }
+
+    LineTable whole;
+    whole.AddSpan(input.data(), input.data() + input.length(), 0);
+
+    for (size_t span_length = 1; span_length < 40; span_length++) {
+        LineTable spans;
+        for (size_t offset = 0; offset < input.length(); offset += span_length) {
+            size_t end = std::min(offset + span_length, input.length());
+            spans.AddSpan(input.data() + offset, input.data() + end, (uint32_t)offset);
+        }
+
+        ASSERT_EQ(whole.line_count(), spans.line_count());
+        for (uint32_t offset = 0; offset <= input.length(); offset++) {
+            ASSERT_EQ(whole.line_number(offset), spans.line_number(offset));
+            ASSERT_EQ(whole.column_number(offset), spans.column_number(offset));
+        }
+    }
+}
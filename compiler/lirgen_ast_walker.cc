@@ -2,11 +2,15 @@
 // (C) 2016 Christian Gunderman
 
 #include <cmath>
+#include <exception>
+#include <memory>
+#include <sstream>
 
 #include "gunderscript/exceptions.h"
 
 #include "gs_assert.h"
 #include "lirgen_ast_walker.h"
+#include "parallel_for.h"
 #include "parser.h"
 #include "symbolimpl.h"
 
@@ -69,11 +73,125 @@ const CallInfo CI_M_PCALLI = {
     CallInfo::typeSig3(ARGTYPE_P, ARGTYPE_P, ARGTYPE_P, ARGTYPE_P),
     ABI_CDECL, 0, ACCSET_STORE_ANY verbose_only(, "this.CallIndirect_pointer") };
 
+// Mangles a function's name to include its spec name and parameter types so
+// that each overload is exported from the module under a unique name.
+// Format: {spec}::{function}$arg1$arg2... or ::{function}$arg1... if there
+// is no spec.
+static std::string MangleFunctionSymbolName(Node* spec_node, Node* function_node) {
+    std::ostringstream name_buf;
+    name_buf << (spec_node != NULL ? spec_node->symbol()->symbol_name() : "");
+    name_buf << "::";
+    name_buf << *function_node->child(2)->string_value();
+
+    // Append parameter types to the symbol name.
+    Node* function_params_node = function_node->child(3);
+    for (size_t i = 0; i < function_params_node->child_count(); i++) {
+        name_buf << "$";
+        name_buf << function_params_node->child(i)->symbol()->type_symbol()->symbol_name();
+    }
+
+    return name_buf.str();
+}
+
+// Constructor for the code generation workers used by GenerateParallel().
+// declarations_walker: the walker that walked the module's declarations.
+// Its tables are only read, so all of the workers share them.
+// alloc: the worker's own Allocator for LIR.
+// atoms: the worker's own AtomTable, layered on declarations_walker's.
+LIRGenAstWalker::LIRGenAstWalker(
+    const LIRGenAstWalker& declarations_walker,
+    Allocator& alloc,
+    AtomTable& atoms)
+    : AstWalker(declarations_walker.root()),
+    atoms_(atoms),
+    func_table_(declarations_walker.func_table_),
+    module_name_(declarations_walker.module_name_),
+    register_table_(&declarations_walker.register_table_),
+    declarations_walker_(&declarations_walker),
+    symbols_vector_(NULL),
+    alloc_(&alloc),
+    current_fragment_(NULL),
+    config_(declarations_walker.config_) { }
+
 // Generates IR code for the given module and stores it within the module.
 // Throws: If this module has failed compilation once or is already compiled
 // or a code generation step fails.
 void LIRGenAstWalker::Generate(Module& module) {
-    
+    BeginGenerate(module);
+
+    // Walk through the AST and find everything we need for our new Module.
+    this->Walk();
+
+    EndGenerate();
+}
+
+// Generates IR code for the given module like Generate(), but generates
+// the functions in parallel once the declarations have been walked. Each
+// worker thread gets its own Allocator, owned by the module, and its own
+// register table on top of this walker's. Functions end up in the module in
+// the same order as they would from Generate() so that they still line up
+// with their slots in the function table.
+// thread_count: the number of threads, or 0 for one per hardware thread.
+// Throws: If this module has failed compilation once or is already compiled
+// or a code generation step fails.
+void LIRGenAstWalker::GenerateParallel(Module& module, unsigned int thread_count) {
+    thread_count = ParallelThreadCount(thread_count);
+
+    BeginGenerate(module);
+
+    // Declarations assign the function table slots, so they are walked serially.
+    WalkModuleDeclarationsChildren();
+
+    // Functions are generated in the same order as Walk() would generate them.
+    std::vector<Node*> impl_nodes = ImplementationNodes();
+
+    std::vector<std::unique_ptr<AtomTable>> worker_atoms(thread_count);
+    std::vector<std::unique_ptr<LIRGenAstWalker>> workers(thread_count);
+    for (unsigned int i = 0; i < thread_count; i++) {
+        Allocator* worker_alloc = new Allocator();
+        module.pimpl()->AdoptAlloc(worker_alloc);
+
+        worker_atoms[i].reset(new AtomTable(&this->atoms_));
+        workers[i].reset(new LIRGenAstWalker(*this, *worker_alloc, *worker_atoms[i]));
+    }
+
+    std::vector<std::vector<ModuleImplSymbol>> impl_symbols(impl_nodes.size());
+    std::vector<std::exception_ptr> impl_errors(impl_nodes.size());
+
+    ParallelFor(impl_nodes.size(), thread_count, [&](unsigned int worker, size_t i) {
+        LIRGenAstWalker& worker_walker = *workers[worker];
+        worker_walker.symbols_vector_ = &impl_symbols[i];
+
+        try {
+            worker_walker.WalkImplementation(impl_nodes[i]);
+        }
+        catch (...) {
+            impl_errors[i] = std::current_exception();
+        }
+    });
+
+    // Report the same error that Generate() would have hit first.
+    for (size_t i = 0; i < impl_errors.size(); i++) {
+        if (impl_errors[i]) {
+            std::rethrow_exception(impl_errors[i]);
+        }
+    }
+
+    for (size_t i = 0; i < impl_symbols.size(); i++) {
+        for (size_t j = 0; j < impl_symbols[i].size(); j++) {
+            this->symbols_vector_->push_back(std::move(impl_symbols[i][j]));
+        }
+    }
+
+    EndGenerate();
+}
+
+// Prepares the module for code generation and allocates its function table.
+// Callers that walk the AST themselves, a piece at a time, must call this
+// first and EndGenerate() once every implementation has been walked.
+// Throws: If this module has failed compilation once or is already compiled.
+void LIRGenAstWalker::BeginGenerate(Module& module) {
+
     // Check if a module has already been compiled into this module file.
     if (module.compiled()) {
         THROW_EXCEPTION(1, 1, STATUS_INVALID_CALL);
@@ -95,18 +213,20 @@ void LIRGenAstWalker::Generate(Module& module) {
     this->func_table_ = new ModuleFunc[functions_count];
     this->current_function_index_ = 0;
 
+    // The module owns the table from the start, even if generation fails,
+    // and functions that are assembled while the module is being generated
+    // are stored in it right away.
+    module.pimpl()->set_func_table(this->func_table_);
+
     // Debug sanity check prereq.
 #ifdef _DEBUG
     this->debug_functions_count_ = functions_count;
 #endif // _DEBUG
+}
 
-    // Walk through the AST and find everything we need for our new Module.
-    this->Walk();
-
+// Finishes code generation once every implementation has been walked.
+void LIRGenAstWalker::EndGenerate() {
     GS_ASSERT_TRUE(this->register_table_.depth() == 1, "Inconsistent reg table levels");
-
-    // Store the function lookup table in the module.
-    module.pimpl()->set_func_table(this->func_table_);
 }
 
 // Handles depends statements.
@@ -169,7 +289,7 @@ LirGenResult LIRGenAstWalker::WalkSpecFunctionDeclarationParameter(
 
         // Store the param load type, address, and offset in the register_table_
         this->register_table_.Put(
-            function_param_node->symbol()->symbol_name(),
+            this->atoms_.Intern(function_param_node->symbol()->symbol_name()),
             std::make_tuple(
                 param_type_symbol,
                 this->current_writer_->insParam(/* args vector*/ 0, /*func param kind*/0),
@@ -200,20 +320,20 @@ void LIRGenAstWalker::WalkSpecPropertyDeclaration(
         // Determine argument size.
         int arg_size = property_type_symbol->size();
 
-        // Store the property load address in the register_table_.
-        this->register_table_.PutBottom(
-            get_property_function_node->symbol()->symbol_name(),
+        // Store the property load address in the declaration_table_.
+        this->declaration_table_.insert(std::make_pair(
+            SYMBOL_TO_PROPERTY(get_property_function_node->symbol()),
             std::make_tuple(
                 property_type_symbol,
                 (LIns*)NULL,
-                this->property_offset_));
+                this->property_offset_)));
 
-        this->register_table_.PutBottom(
-            set_property_function_node->symbol()->symbol_name(),
+        this->declaration_table_.insert(std::make_pair(
+            SYMBOL_TO_FUNCTION(set_property_function_node->symbol()),
             std::make_tuple(
                 property_type_symbol,
                 (LIns*)NULL,
-                this->property_offset_));
+                this->property_offset_)));
 
         this->property_offset_ += arg_size;
     }
@@ -272,8 +392,8 @@ LirGenResult LIRGenAstWalker::WalkFunctionCall(
     // Register entry contains register information for variables and 
     // a pointer to a location that will contain a function pointer after compilation
     // for functions. This is done to avoid the need to backpatch function addresses later.
-    std::tuple<const SymbolBase*, LIns*, int> function_reg_tuple
-        = this->register_table_.Get(call_symbol->symbol_name());
+    const std::tuple<const SymbolBase*, LIns*, int>& function_reg_tuple
+        = DeclarationEntry(call_symbol);
 
     // NanoJIT unfortunately depends on having a function pointer to jump to for function calls,
     // however, we don't have one readily available for most functions since compilation hasn't
@@ -415,7 +535,7 @@ LirGenResult LIRGenAstWalker::WalkMemberPropertyGet(
 
     // Lookup property entry.
     const std::tuple<const SymbolBase*, LIns*, int>& reg_tuple
-        = this->register_table_.Get(member_symbol->symbol_name());
+        = DeclarationEntry(member_symbol);
 
 #if defined _DEBUG
     this->current_writer_->insComment("Property get");
@@ -442,7 +562,7 @@ LirGenResult LIRGenAstWalker::WalkMemberPropertySet(
 
     // Lookup property entry.
     const std::tuple<const SymbolBase*, LIns*, int>& reg_tuple
-        = this->register_table_.Get(member_symbol->symbol_name());
+        = DeclarationEntry(member_symbol);
 
 #if defined _DEBUG
     this->current_writer_->insComment("Property set");
@@ -473,7 +593,7 @@ LirGenResult LIRGenAstWalker::WalkFunctionLikeTypecast(
     const TypeSymbol* expression_symbol = argument_result.symbol()->type_symbol();
 
     // If types are the same, no conversion neccessary.
-    if (*expression_symbol == *cast_symbol) {
+    if (expression_symbol == cast_symbol) {
         return argument_result;
     }
 
@@ -547,37 +667,36 @@ LirGenResult LIRGenAstWalker::WalkAssign(
     LirGenResult operations_result) {
 
     LIns* variable_ptr = NULL;
+    int variable_offset = 0;
 
     // Check if the variable name was bound in the current scope. If it was, it is a local
     // and we can use the NanoJIT register for it.
-    try {
-        variable_ptr = std::get<1>(this->register_table_.GetTopOnly(*name_node->string_value()));;
+    const std::tuple<const SymbolBase*, LIns*, int>* variable_reg
+        = this->register_table_.FindTopOnly(name_node->atom());
+    if (variable_reg != NULL) {
+        variable_ptr = std::get<1>(*variable_reg);
+        variable_offset = std::get<2>(*variable_reg);
         goto emit_assign_ins;
     }
-    catch (const Exception&) {
 
-        // Variable was not bound in the current scope, check if it was bound in any scope.
-        // If so, if it is the same type as our expression then we are assigning to the already
-        // declared variable.
-        // If not, this variable is a narrower scope variable of the same name and a different
-        // type that is masking the old one.
-        try {
-            std::tuple<const SymbolBase*, LIns*, int> variable_reg = this->register_table_.Get(*name_node->string_value());
-
-            if (*(std::get<0>(variable_reg)->type_symbol()) == *(operations_result.symbol()->type_symbol())) {
-                variable_ptr = std::get<1>(variable_reg);
-                goto emit_assign_ins;
-            }
-            /* else: Fall into new alloc */
-        }
-        catch (const Exception&) { /* Fall into new alloc */ }
-    } 
+    // Variable was not bound in the current scope, check if it was bound in any scope.
+    // If so, if it is the same type as our expression then we are assigning to the already
+    // declared variable.
+    // If not, this variable is a narrower scope variable of the same name and a different
+    // type that is masking the old one.
+    variable_reg = this->register_table_.Find(name_node->atom());
+    if (variable_reg != NULL &&
+        std::get<0>(*variable_reg)->type_symbol() == operations_result.symbol()->type_symbol()) {
+        variable_ptr = std::get<1>(*variable_reg);
+        variable_offset = std::get<2>(*variable_reg);
+        goto emit_assign_ins;
+    }
 
     // New Alloc: Allocate a new register (NanoJIT register) for this variable name,
     // it has either never been seen before or is a new var of a different type masking
     // the original definition in an enclosing scope.
     variable_ptr = this->current_writer_->insAlloc(operations_result.symbol()->type_symbol()->size());
-    this->register_table_.Put(*name_node->string_value(), std::make_tuple(operations_result.symbol(), variable_ptr, 0));
+    this->register_table_.Put(name_node->atom(), std::make_tuple(operations_result.symbol(), variable_ptr, 0));
 
     // Emit the assignment instruction. Dijkstra doesn't have to agree with me, gotos can be useful.
 emit_assign_ins:
@@ -587,7 +706,12 @@ emit_assign_ins:
     this->current_writer_->insComment(name_node->string_value()->c_str());
 #endif // _DEBUG
 
-    EmitStore(operations_result.symbol()->type_symbol(), variable_ptr, 0, operations_result.ins());
+    // Params that are still in the arguments vector are stored at their offset into it.
+    EmitStore(
+        operations_result.symbol()->type_symbol(),
+        variable_ptr,
+        variable_offset,
+        operations_result.ins());
 
     // The value and type of an assignment is equal to that of the right hand
     // side of the operation (the expression). Simply pass it along.
@@ -1374,7 +1498,7 @@ LirGenResult LIRGenAstWalker::WalkVariable(
 #endif // _DEBUG
 
     const std::tuple<const SymbolBase*, LIns*, int>& reg_tuple
-        = this->register_table_.Get(*name_node->string_value());
+        = this->register_table_.Get(name_node->atom());
 
     // No try/catch here, if register_table_ throws then the type checker made
     // a boo boo and didn't notice the missing variable initialization.
@@ -1431,8 +1555,9 @@ void LIRGenAstWalker::WalkFunctionChildren(
 
     // If we're doing code generation now:
     if (!prescan) {
-        // TODO: make sure that this is freed.
-        LirBuffer* buf = new (alloc_) LirBuffer(alloc_);
+        // The buffer is freed along with its Allocator, which must outlive
+        // the function's assembly.
+        LirBuffer* buf = new (*alloc_) LirBuffer(*alloc_);
         buf->abi = ABI_CDECL;
 
         // Allocate a fragment for the function
@@ -1470,12 +1595,12 @@ void LIRGenAstWalker::WalkFunctionChildren(
         // positionally to correspond with the location of the function in the symbols_vector.
         // NOTE: this code working properly is dependent upon the assumption that the prescan
         // and the code gen steps are done in EXACTLY the same order every time.
-        this->register_table_.PutBottom(
-            function_symbol->symbol_name(),
+        this->declaration_table_.insert(std::make_pair(
+            function_symbol,
             std::make_tuple(
                 &TYPE_FUNCTION,
                 reinterpret_cast<LIns*>(&(this->func_table_[this->current_function_index_++])),
-                0));
+                0)));
     } else {
 
 #if defined _DEBUG
@@ -1515,7 +1640,7 @@ void LIRGenAstWalker::WalkFunctionChildren(
             }
             break;
         case 0:
-            GS_ASSERT_TRUE(*function_type_symbol == TYPE_VOID, "Expected void type");
+            GS_ASSERT_TRUE(function_type_symbol == &TYPE_VOID, "Expected void type");
             ret_inst = this->current_writer_->ins1(LIR_reti, this->current_writer_->insImmI(0));
             break;
         default:
@@ -1528,11 +1653,11 @@ void LIRGenAstWalker::WalkFunctionChildren(
         // there is probably a problem with the lexer, parser, or typechecker.
         this->symbols_vector_->push_back(
             ModuleImplSymbol(
-                function_symbol->symbol_name(),
+                MangleFunctionSymbolName(spec_node, function_node),
                 function_symbol->type_symbol()->Clone(),
-                this->current_fragment_));
+                this->current_fragment_,
+                !function_node->child(4)->bool_value()));
 
-        // TODO: delete this somehow?? delete this->current_fragment_->lirbuf;
         delete this->current_writer_;
         this->current_fragment_ = NULL;
         this->current_writer_ = NULL;
@@ -1555,7 +1680,7 @@ void LIRGenAstWalker::WalkIfStatementChildren(
     GS_ASSERT_OPTIONAL_NODE_RULE(property_node, NodeRule::PROPERTY);
 
     // Walk condition expression.
-    LirGenResult condition_result = AstWalker<LirGenResult>::WalkExpressionChildren(
+    LirGenResult condition_result = AstWalker::WalkExpressionChildren(
         spec_node,
         function_node,
         property_node,
@@ -1621,7 +1746,7 @@ LirGenResult LIRGenAstWalker::WalkNewExpression(
     // Lookup the spec's size and allocate enough memory to hold its properties.
     // NOTE: there is no need to catch exceptions from this table. If it throws
     // then the AstWalker is walking in the incorrect order.
-    int alloc_size = this->type_size_table_.at(type_node->symbol()->symbol_name());
+    int alloc_size = this->declarations_walker_->type_size_table_.at(type_node->symbol()->symbol_name());
     LIns* size_arg[] = { this->current_writer_->insImmI(alloc_size) };
 
     LIns* alloc_call_inst = this->current_writer_->insCall(&runtime::CI_GC_ALLOC, size_arg);
@@ -1889,6 +2014,17 @@ LIns* LIRGenAstWalker::EmitStore(const SymbolBase* symbol, LIns* base, int offse
     }
 }
 
+// Looks up the register entry for a function or property function.
+// symbol: the symbol of the function's declaration.
+// Returns: the entry for the function, which must have been prescanned.
+const std::tuple<const SymbolBase*, LIns*, int>& LIRGenAstWalker::DeclarationEntry(
+    const SymbolBase* symbol) const {
+
+    // No try/catch here, if this throws then the type checker attached the
+    // wrong symbol or the declarations were not prescanned.
+    return this->declarations_walker_->declaration_table_.at(symbol);
+}
+
 // Counts the total number of functions produced by this module.
 int LIRGenAstWalker::CountFunctions() {
     size_t count = 0;
@@ -5,8 +5,10 @@
 #define GUNDERSCRIPT_LIRGEN_AST_WALKER__H__
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "gunderscript/atom_table.h"
 #include "gunderscript/node.h"
 #include "gunderscript/symbol.h"
 #include "gunderscript/virtual_machine.h"
@@ -14,6 +16,7 @@
 #include "gs_assert.h"
 
 #include "ast_walker.h"
+#include "common_resourcesimpl.h"
 #include "moduleimpl.h"
 #include "symbol_table.h"
 
@@ -39,24 +42,39 @@ private:
 
 // LirGenResult checking abstract syntax tree walker.
 // Walks along the AST and checks for type correctness.
-class LIRGenAstWalker : public AstWalker<LirGenResult> {
+class LIRGenAstWalker : public AstWalker<LIRGenAstWalker, LirGenResult> {
 public:
 
+    // Constructor. LIR is allocated from, and code generation is configured
+    // by, common_resources.
     LIRGenAstWalker(
-        Allocator& alloc,
-        Config& config,
-        Node& node)
+        CommonResourcesImpl& common_resources,
+        Node& node,
+        AtomTable& atoms)
         : AstWalker(node),
-        alloc_(alloc),
-        config_(config),
+        atoms_(atoms),
         module_name_(NULL),
-        current_fragment_(NULL) { }
+        alloc_(&common_resources.alloc()),
+        current_fragment_(NULL),
+        config_(common_resources.config()) {
+        this->declarations_walker_ = this;
+    }
 
-    virtual ~LIRGenAstWalker() { }
+    ~LIRGenAstWalker() { }
 
     void Generate(Module& generated_module);
+    void GenerateParallel(Module& generated_module, unsigned int thread_count);
+    void BeginGenerate(Module& generated_module);
+    void EndGenerate();
+
+    // Sets the Allocator that the LIR of the functions walked from now on
+    // is allocated from.
+    void set_alloc(Allocator& alloc) { this->alloc_ = &alloc; }
 
 protected:
+    // AstWalker dispatches to the Walk methods directly.
+    friend class AstWalker<LIRGenAstWalker, LirGenResult>;
+
     void WalkModule(Node* module_node) { }
     void WalkModuleName(Node* name_node) { this->module_name_ = name_node->string_value(); }
     void WalkModuleDependsName(Node* name_node);
@@ -323,23 +341,36 @@ protected:
         Node* type_node);
 
 private:
+    LIRGenAstWalker(const LIRGenAstWalker& declarations_walker, Allocator& alloc, AtomTable& atoms);
+
     LIns* EmitLoad(const SymbolBase* symbol, nanojit::LIns* base, int offset);
     LIns* EmitStore(const SymbolBase* symbol, nanojit::LIns* base, int offset, LIns* value);
     int CountFunctions();
+    const std::tuple<const SymbolBase*, LIns*, int>& DeclarationEntry(const SymbolBase* symbol) const;
 
+    AtomTable& atoms_;
     ModuleFunc* func_table_;
     const std::string* module_name_;
 
     // Registers stored values as a 3-tuple for load/store: Type, Address, Offset.
     SymbolTable<std::tuple<const SymbolBase*, LIns*, int>> register_table_;
 
+    // Register entries of functions and property functions keyed by the
+    // symbol that declared them, which calls and member expressions share.
+    std::unordered_map<const SymbolBase*, std::tuple<const SymbolBase*, LIns*, int>> declaration_table_;
+
     // Stores the compiled-object sizes of Gunderscript types + and their properties.
     // Although it'd make more sense to have this as part of the type's Symbol, doing so
     // would prevent us from using immutable copies as is currently done and it would
     // introduce cycles into the abstract syntax tree, complicating memory management.
     std::unordered_map<const std::string, int, std::hash<std::string> > type_size_table_;
+
+    // The walker whose declaration_table_ and type_size_table_ are read: this
+    // one, or for a GenerateParallel() worker, the walker that walked the
+    // declarations. Workers never fill in their own tables.
+    const LIRGenAstWalker* declarations_walker_;
     std::vector<ModuleImplSymbol>* symbols_vector_;
-    nanojit::Allocator& alloc_;
+    nanojit::Allocator* alloc_;
     nanojit::Fragment* current_fragment_;
     nanojit::Config& config_;
     nanojit::LirBufWriter* current_writer_;
@@ -0,0 +1,135 @@
+// Gunderscript-2 AST Node Arena
+// (C) 2016 Christian Gunderman
+
+#include <cstdint>
+#include <utility>
+
+#include "gs_assert.h"
+
+#include "node_arena.h"
+
+namespace gunderscript {
+namespace compiler {
+
+// Marks the root while flattening, which is not stored in any child slot.
+static const uint32_t kNoChildSlot = UINT32_MAX;
+
+// Frees the symbols created for the tree. The nodes themselves have trivial
+// destructors and go away with the underlying Arena's blocks.
+NodeArena::~NodeArena() {
+    for (size_t i = 0; i < this->symbols_.size(); i++) {
+        delete this->symbols_[i];
+    }
+}
+
+// Lays a parse tree out in a new NodeArray in pre-order. Nodes are numbered
+// in the order that a depth first walk visits them and each node's children
+// are recorded as a contiguous run of indices. The parse tree is left in the
+// arena, and may be freed with ReleaseParseNodes().
+// root: the root of the parse tree.
+// Returns: the root node of the flattened tree.
+Node* NodeArena::Flatten(const ParseNode& root) {
+
+    // Count the nodes first so that every column is allocated exactly once.
+    size_t size = 0;
+    std::vector<const ParseNode*> stack(1, &root);
+    while (!stack.empty()) {
+        const ParseNode* node = stack.back();
+        stack.pop_back();
+        size++;
+
+        for (size_t i = 0; i < node->child_count(); i++) {
+            stack.push_back(node->child(i));
+        }
+    }
+
+    // Sources are limited to 4GB so the node count can't realistically
+    // overflow before memory runs out.
+    GS_ASSERT_TRUE(size < kNoChildSlot, "Too many nodes to index with 32 bits");
+
+    NodeArray* array = new (this->arena_.Allocate(sizeof(NodeArray), alignof(NodeArray))) NodeArray();
+    array->arena_ = this;
+    array->size_ = (uint32_t)size;
+    array->nodes_ = this->AllocateArray<Node>(size);
+    array->rules_ = this->AllocateArray<NodeRule>(size);
+    array->offsets_ = this->AllocateArray<uint32_t>(size);
+    array->values_ = this->AllocateArray<NodeValue>(size);
+    array->atoms_ = this->AllocateArray<Atom>(size);
+    array->first_children_ = this->AllocateArray<uint32_t>(size);
+    array->child_counts_ = this->AllocateArray<uint32_t>(size);
+
+    // Every node but the root is the child of exactly one other node.
+    array->children_ = this->AllocateArray<uint32_t>(size - 1);
+    array->symbols_ = this->AllocateArray<const SymbolBase*>(size);
+
+    // Walk depth first, pushing children in reverse so that they are popped
+    // and numbered in order. Each entry carries the slot in children_ that
+    // must receive the node's index once it is numbered.
+    std::vector<std::pair<const ParseNode*, uint32_t> > pending(1, std::make_pair(&root, kNoChildSlot));
+    uint32_t next_index = 0;
+    uint32_t next_child_slot = 0;
+
+    while (!pending.empty()) {
+        const ParseNode* node = pending.back().first;
+        uint32_t slot = pending.back().second;
+        uint32_t index = next_index++;
+        uint32_t child_count = (uint32_t)node->child_count();
+        pending.pop_back();
+
+        if (slot != kNoChildSlot) {
+            array->children_[slot] = index;
+        }
+
+        new (&array->nodes_[index]) Node(*array, index);
+        array->rules_[index] = node->rule();
+        array->offsets_[index] = node->offset();
+        array->values_[index] = node->value();
+        array->atoms_[index] = node->atom();
+        array->symbols_[index] = NULL;
+        array->first_children_[index] = next_child_slot;
+        array->child_counts_[index] = child_count;
+
+        for (uint32_t i = child_count; i > 0; i--) {
+            pending.push_back(std::make_pair(node->child(i - 1), next_child_slot + i - 1));
+        }
+
+        next_child_slot += child_count;
+    }
+
+    return array->root();
+}
+
+// Gets the instantiation of a generic type template with the given type
+// params, creating it the first time that it is asked for, so that every use
+// of the same generic type shares one symbol. Thread safe.
+// template_symbol: the GENERIC_TYPE_TEMPLATE symbol of the generic spec.
+// symbol_name: the name of the instantiation, e.g.: Map<string,int32,>.
+// type_params: the resolved type params.
+// Returns: the GENERIC_TYPE symbol, owned by the arena.
+const GenericTypeSymbol* NodeArena::InternGenericType(
+    const SymbolBase* template_symbol,
+    const std::string& symbol_name,
+    const std::vector<const SymbolBase*>& type_params) {
+
+    std::vector<const SymbolBase*> key;
+    key.reserve(type_params.size() + 1);
+    key.push_back(template_symbol);
+    key.insert(key.end(), type_params.begin(), type_params.end());
+
+    std::lock_guard<std::mutex> lock(this->symbols_mutex_);
+
+    const GenericTypeSymbol*& generic_type = this->generic_types_[key];
+    if (generic_type == NULL) {
+        generic_type = new GenericTypeSymbol(
+            SymbolType::GENERIC_TYPE,
+            template_symbol->access_modifier(),
+            symbol_name,
+            type_params);
+        this->symbols_.push_back(generic_type);
+    }
+
+    return generic_type;
+}
+
+} // namespace compiler
+} // namespace gunderscript
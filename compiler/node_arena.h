@@ -0,0 +1,101 @@
+// Gunderscript-2 AST Node Arena
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_NODE_ARENA__H__
+#define GUNDERSCRIPT_NODE_ARENA__H__
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gunderscript/node.h"
+#include "gunderscript/symbol.h"
+
+#include "arena.h"
+#include "parse_node.h"
+
+namespace gunderscript {
+namespace compiler {
+
+// Owns every node of an abstract syntax tree: the ParseNodes that the Parser
+// builds, the flattened NodeArray that later stages walk, and the symbols the
+// SemanticAstWalker annotates it with. Everything is bump allocated and never
+// freed one at a time. The ParseNodes are kept apart from the rest so that
+// they can be released as soon as they have been flattened. The rest of the
+// tree is released at once when the arena is destroyed, so a NodeArena must
+// outlive every stage of the compilation that looks at the tree. Each symbol
+// is created once and shared by every node that refers to it, so symbols of
+// the same compilation are equal only if they are the same object. Not
+// thread safe, except that NewSymbol() and InternGenericType() may be called
+// from several threads at once so that a tree's nodes can be annotated in
+// parallel.
+class NodeArena {
+public:
+    NodeArena(size_t block_size = kArenaDefaultBlockSize) : arena_(block_size), parse_arena_(block_size) { }
+    ~NodeArena();
+
+    // Constructs a ParseNode in the arena. Takes the same arguments as the
+    // ParseNode constructors. The node lives until ReleaseParseNodes().
+    template <typename... Args>
+    ParseNode* NewParseNode(Args... args) {
+        return new (this->parse_arena_.Allocate(sizeof(ParseNode), alignof(ParseNode))) ParseNode(*this, args...);
+    }
+
+    // Allocates an uninitialized array of count trivially destructible Ts
+    // that lives as long as the ParseNodes.
+    template <typename T>
+    T* AllocateParseArray(size_t count) {
+        return static_cast<T*>(this->parse_arena_.Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Frees every ParseNode, once the tree has been flattened.
+    void ReleaseParseNodes() { this->parse_arena_.Release(); }
+
+    // Allocates an uninitialized array of count trivially destructible Ts.
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        return static_cast<T*>(this->arena_.Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Constructs a symbol that lives until the arena is destroyed. Takes the
+    // same arguments as SymbolT's constructors. Thread safe.
+    template <typename SymbolT, typename... Args>
+    const SymbolT* NewSymbol(Args&&... args) {
+        const SymbolT* symbol = new SymbolT(std::forward<Args>(args)...);
+        std::lock_guard<std::mutex> lock(this->symbols_mutex_);
+        this->symbols_.push_back(symbol);
+        return symbol;
+    }
+
+    Node* Flatten(const ParseNode& root);
+    const GenericTypeSymbol* InternGenericType(
+        const SymbolBase* template_symbol,
+        const std::string& symbol_name,
+        const std::vector<const SymbolBase*>& type_params);
+    size_t bytes_allocated() const {
+        return this->arena_.bytes_allocated() + this->parse_arena_.bytes_allocated();
+    }
+
+private:
+    Arena arena_;
+    Arena parse_arena_;
+    std::vector<const SymbolBase*> symbols_;
+
+    // Instantiations of generic types, keyed by the generic type template
+    // followed by the type params.
+    std::map<std::vector<const SymbolBase*>, const GenericTypeSymbol*> generic_types_;
+    std::mutex symbols_mutex_;
+
+    // Arenas own raw memory and must not be copied.
+    NodeArena(const NodeArena&);
+    NodeArena& operator=(const NodeArena&);
+};
+
+} // namespace compiler
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_NODE_ARENA__H__
@@ -0,0 +1,129 @@
+// Gunderscript 2 Node Arena Unit Test
+// (C) 2016 Christian Gunderman
+
+#include "gtest/gtest.h"
+
+#include "gunderscript/compiler_source.h"
+#include "gunderscript/node.h"
+
+#include "lexer.h"
+#include "node_arena.h"
+#include "parser.h"
+
+using namespace gunderscript;
+using namespace gunderscript::compiler;
+
+// Walks a subtree recursively and checks that it was numbered in pre-order.
+// Returns: the index expected for the node after the subtree.
+static uint32_t CheckPreOrder(const Node* node, uint32_t expected_index) {
+    EXPECT_EQ(expected_index, node->index());
+    expected_index++;
+
+    for (size_t i = 0; i < node->child_count(); i++) {
+        expected_index = CheckPreOrder(node->child(i), expected_index);
+    }
+
+    return expected_index;
+}
+
+// Checks that every node of a flattened tree is stored in pre-order, with
+// the root first and each subtree directly after its parent.
+TEST(NodeArena, FlattensInPreOrder) {
+    std::string input("package \"Foo\";"
+        "public spec Bar { int32 X { public get; concealed set; } }"
+        "public int32 main(int32 a) {"
+        "    x <- 1 + 2 * 3 - foo(a, 4.5);"
+        "    if (x > 3 && !true) { return x; }"
+        "    return 0;"
+        "}");
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    NodeArena nodes;
+    Parser parser(lexer, nodes);
+    Node* root = parser.Parse();
+
+    ASSERT_EQ(0, root->index());
+    ASSERT_EQ(NodeRule::MODULE, root->rule());
+    EXPECT_EQ(61, CheckPreOrder(root, 0));
+}
+
+// Checks that a flattened single node tree keeps its values and has no
+// children.
+TEST(NodeArena, FlattensSingleNode) {
+    NodeArena nodes;
+    ParseNode* parse_node = nodes.NewParseNode(NodeRule::INT, 7, 42L);
+    Node* node = nodes.Flatten(*parse_node);
+
+    EXPECT_EQ(NodeRule::INT, node->rule());
+    EXPECT_EQ(7, node->offset());
+    EXPECT_EQ(42, node->int_value());
+    EXPECT_EQ(0, node->child_count());
+    EXPECT_TRUE(node->string_value() == NULL);
+    EXPECT_TRUE(node->symbol() == NULL);
+}
+
+// Checks that the ParseNodes can be released once they are flattened without
+// affecting the flattened tree.
+TEST(NodeArena, ReleaseParseNodes) {
+    NodeArena nodes;
+    ParseNode* parse_root = nodes.NewParseNode(NodeRule::ADD, 3);
+    parse_root->AddChild(nodes.NewParseNode(NodeRule::INT, 1, 2L));
+    parse_root->AddChild(nodes.NewParseNode(NodeRule::INT, 5, 4L));
+    Node* root = nodes.Flatten(*parse_root);
+    size_t flattened_bytes = nodes.bytes_allocated();
+
+    nodes.ReleaseParseNodes();
+
+    EXPECT_GT(flattened_bytes, nodes.bytes_allocated());
+    EXPECT_LT(0, nodes.bytes_allocated());
+    ASSERT_EQ(NodeRule::ADD, root->rule());
+    ASSERT_EQ(2, root->child_count());
+    EXPECT_EQ(2, root->child(0)->int_value());
+    EXPECT_EQ(4, root->child(1)->int_value());
+}
+
+// Checks that nodes share the symbols set on them, whether they are builtin
+// or were created in the nodes' arena.
+TEST(NodeArena, SetSymbol) {
+    NodeArena nodes;
+    ParseNode* parse_node = nodes.NewParseNode(NodeRule::ADD, 0);
+    parse_node->AddChild(nodes.NewParseNode(NodeRule::INT, 1, 1L));
+    parse_node->AddChild(nodes.NewParseNode(NodeRule::INT, 3, 2L));
+    Node* node = nodes.Flatten(*parse_node);
+    EXPECT_EQ(&nodes, &node->arena());
+
+    node->child(1)->set_symbol(&TYPE_INT);
+    EXPECT_TRUE(node->symbol() == NULL);
+    EXPECT_TRUE(node->child(0)->symbol() == NULL);
+    EXPECT_EQ(&TYPE_INT, node->child(1)->symbol());
+
+    const TypeSymbol* spec_symbol = nodes.NewSymbol<TypeSymbol>(LexerSymbol::PUBLIC, "Spec");
+    node->set_symbol(spec_symbol);
+    node->child(0)->set_symbol(spec_symbol);
+    EXPECT_EQ(spec_symbol, node->symbol());
+    EXPECT_EQ(spec_symbol, node->child(0)->symbol());
+    EXPECT_EQ("Spec", node->symbol()->symbol_name());
+}
+
+// Checks that a generic type instantiated twice with the same params gets
+// the same symbol, and with different params a different one.
+TEST(NodeArena, InternGenericType) {
+    NodeArena nodes;
+    const TypeSymbol* type_param = nodes.NewSymbol<TypeSymbol>(
+        SymbolType::TYPE_TEMPLATE, LexerSymbol::CONCEALED, "T", TypeFormat::POINTER, (int)sizeof(void*));
+    const GenericTypeSymbol* template_symbol = nodes.NewSymbol<GenericTypeSymbol>(
+        SymbolType::GENERIC_TYPE_TEMPLATE, LexerSymbol::PUBLIC, "Box~",
+        std::vector<const SymbolBase*>({ type_param }));
+
+    const GenericTypeSymbol* int_box = nodes.InternGenericType(
+        template_symbol, "Box<int32,>", std::vector<const SymbolBase*>({ &TYPE_INT }));
+    const GenericTypeSymbol* float_box = nodes.InternGenericType(
+        template_symbol, "Box<float32,>", std::vector<const SymbolBase*>({ &TYPE_FLOAT }));
+
+    EXPECT_EQ(SymbolType::GENERIC_TYPE, int_box->symbol_type());
+    EXPECT_EQ("Box<int32,>", int_box->symbol_name());
+    EXPECT_EQ(&TYPE_INT, int_box->type_params()[0]);
+    EXPECT_NE(int_box, float_box);
+    EXPECT_EQ(int_box, nodes.InternGenericType(
+        template_symbol, "Box<int32,>", std::vector<const SymbolBase*>({ &TYPE_INT })));
+}
@@ -0,0 +1,122 @@
+// Gunderscript-2 Function Overload Index
+// (C) 2016 Christian Gunderman
+
+#include <string>
+
+#include "overload_index.h"
+
+namespace gunderscript {
+namespace compiler {
+
+// Instantiate template so we can unit test and link from external modules.
+template class OverloadIndex<const SymbolBase*>;
+template class OverloadIndex<std::string>;
+
+// Checks if an argument has a parameter's type. Each type of a compilation
+// has exactly one symbol so types are compared by identity.
+static bool TypeMatches(const TypeSymbol* param, const SymbolBase* argument) {
+    return param == argument->type_symbol();
+}
+
+// Constructor, creates an empty index.
+template <typename ValueType>
+OverloadIndex<ValueType>::OverloadIndex() : global_index_(NULL) { }
+
+// Constructor, creates an empty index that looks up overloads that it
+// doesn't define in global_index.
+// global_index: the index to fall back on. It is never modified through this
+// index and must outlive it.
+template <typename ValueType>
+OverloadIndex<ValueType>::OverloadIndex(const OverloadIndex* global_index)
+    : global_index_(global_index) { }
+
+// Adds an overload.
+// key: the spec, name, and property function of the overload.
+// params: the symbols of the overload's parameters, in order.
+// value: the value to associate with the overload.
+// Throws: STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL if key already has an
+// overload with the same parameter types.
+template <typename ValueType>
+void OverloadIndex<ValueType>::Put(
+    const OverloadKey& key,
+    const std::vector<const SymbolBase*>& params,
+    ValueType value) {
+
+    std::vector<Candidate>& candidates = this->overloads_[key];
+
+    if (FindCandidate(candidates, params) != NULL) {
+        // These are incorrect line numbers but this exception should ALWAYS be caught
+        // and never bubble up so it doesn't matter.
+        THROW_EXCEPTION(
+            1,
+            1,
+            STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL);
+    }
+
+    Candidate candidate = { std::vector<const TypeSymbol*>(), value };
+    candidate.params.reserve(params.size());
+    for (size_t i = 0; i < params.size(); i++) {
+        candidate.params.push_back(params[i]->type_symbol());
+    }
+
+    candidates.push_back(candidate);
+}
+
+// Resolves a call to one of key's overloads.
+// key: the spec, name, and property function being called.
+// arguments: the symbols of the call's arguments, in order.
+// Returns: the value of the overload whose parameter types match the
+// argument types, or NULL if there isn't one. The pointer is invalidated by
+// the next call to Put().
+template <typename ValueType>
+const ValueType* OverloadIndex<ValueType>::Find(
+    const OverloadKey& key,
+    const std::vector<const SymbolBase*>& arguments) const {
+
+    typename std::unordered_map<OverloadKey, std::vector<Candidate>, KeyHash>::const_iterator it
+        = this->overloads_.find(key);
+
+    if (it != this->overloads_.end()) {
+        const Candidate* candidate = FindCandidate(it->second, arguments);
+
+        if (candidate != NULL) {
+            return &candidate->value;
+        }
+    }
+
+    if (this->global_index_ != NULL) {
+        return this->global_index_->Find(key, arguments);
+    }
+
+    return NULL;
+}
+
+// Searches a key's candidates for the one whose parameter types match.
+// Returns: the matching candidate, or NULL if there isn't one.
+template <typename ValueType>
+const typename OverloadIndex<ValueType>::Candidate* OverloadIndex<ValueType>::FindCandidate(
+    const std::vector<Candidate>& candidates,
+    const std::vector<const SymbolBase*>& arguments) const {
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+        const Candidate& candidate = candidates[i];
+
+        if (candidate.params.size() != arguments.size()) {
+            continue;
+        }
+
+        size_t j = 0;
+        while (j < arguments.size() && TypeMatches(candidate.params[j], arguments[j])) {
+            j++;
+        }
+
+        if (j == arguments.size()) {
+            return &candidate;
+        }
+    }
+
+    return NULL;
+}
+
+} // namespace compiler
+} // namespace gunderscript
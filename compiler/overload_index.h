@@ -0,0 +1,84 @@
+// Gunderscript-2 Function Overload Index
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_OVERLOAD_INDEX__H__
+#define GUNDERSCRIPT_OVERLOAD_INDEX__H__
+
+#include <unordered_map>
+#include <vector>
+
+#include "gunderscript/atom_table.h"
+#include "gunderscript/exceptions.h"
+#include "gunderscript/symbol.h"
+
+namespace gunderscript {
+namespace compiler {
+
+// Names a group of overloads: the spec that declares them, or an invalid
+// Atom for static functions, the function or property name, and which
+// property function, or NONE for plain functions.
+class OverloadKey {
+public:
+    OverloadKey(Atom spec, Atom name, PropertyFunction function)
+        : spec_(spec), name_(name), function_(function) { }
+
+    bool operator==(const OverloadKey& other) const {
+        return this->spec_ == other.spec_
+            && this->name_ == other.name_
+            && this->function_ == other.function_;
+    }
+
+    // Combines the Atoms' ids, which were hashed when they were interned.
+    size_t hash() const {
+        return ((this->spec_.valid() ? this->spec_.id() : 0) * 31
+            + (this->name_.valid() ? this->name_.id() : 0)) * 3
+            + static_cast<size_t>(this->function_);
+    }
+
+private:
+    Atom spec_;
+    Atom name_;
+    PropertyFunction function_;
+};
+
+// Index of the functions and property functions declared in a module. Calls
+// are resolved by looking up their OverloadKey and comparing the argument
+// types against each candidate signature for that key, so no mangled name
+// is ever built. Like SymbolTable, an index may be given a read only global
+// index that Find() falls back on, so that several threads can share one.
+template <typename ValueType>
+class OverloadIndex {
+public:
+    OverloadIndex();
+    explicit OverloadIndex(const OverloadIndex* global_index);
+    void Put(
+        const OverloadKey& key,
+        const std::vector<const SymbolBase*>& params,
+        ValueType value);
+    const ValueType* Find(
+        const OverloadKey& key,
+        const std::vector<const SymbolBase*>& arguments) const;
+
+private:
+    // One overload's parameter types and the value it maps to.
+    struct Candidate {
+        std::vector<const TypeSymbol*> params;
+        ValueType value;
+    };
+
+    struct KeyHash {
+        size_t operator()(const OverloadKey& key) const { return key.hash(); }
+    };
+
+    std::unordered_map<OverloadKey, std::vector<Candidate>, KeyHash> overloads_;
+    const OverloadIndex* global_index_;
+
+    const Candidate* FindCandidate(
+        const std::vector<Candidate>& candidates,
+        const std::vector<const SymbolBase*>& arguments) const;
+};
+
+} // namespace compiler
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_OVERLOAD_INDEX__H__
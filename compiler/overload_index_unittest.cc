@@ -0,0 +1,80 @@
+// Gunderscript 2 Function Overload Index Unit Test
+// (C) 2016 Christian Gunderman
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "testing_macros.h"
+
+#include "overload_index.h"
+
+using namespace gunderscript;
+using gunderscript::compiler::OverloadIndex;
+using gunderscript::compiler::OverloadKey;
+
+// Checks that overloads of one name are told apart by their parameter types
+// and that lookups with other types or counts miss.
+TEST(OverloadIndex, ResolvesByParameterTypes) {
+    AtomTable atoms;
+    OverloadIndex<std::string> index;
+    const OverloadKey key(Atom(), atoms.Intern("foo"), PropertyFunction::NONE);
+
+    index.Put(key, std::vector<const SymbolBase*>(), "foo()");
+    index.Put(key, std::vector<const SymbolBase*>({ &TYPE_INT }), "foo(int32)");
+    index.Put(key, std::vector<const SymbolBase*>({ &TYPE_FLOAT, &TYPE_INT }), "foo(float32, int32)");
+
+    ASSERT_STREQ("foo()", index.Find(key, std::vector<const SymbolBase*>())->c_str());
+    ASSERT_STREQ("foo(int32)", index.Find(key, std::vector<const SymbolBase*>({ &TYPE_INT }))->c_str());
+    ASSERT_STREQ("foo(float32, int32)",
+        index.Find(key, std::vector<const SymbolBase*>({ &TYPE_FLOAT, &TYPE_INT }))->c_str());
+
+    ASSERT_TRUE(index.Find(key, std::vector<const SymbolBase*>({ &TYPE_FLOAT })) == NULL);
+    ASSERT_TRUE(index.Find(key, std::vector<const SymbolBase*>({ &TYPE_INT, &TYPE_FLOAT })) == NULL);
+    ASSERT_TRUE(index.Find(key, std::vector<const SymbolBase*>({ &TYPE_INT, &TYPE_INT, &TYPE_INT })) == NULL);
+
+    EXPECT_STATUS(index.Put(key, std::vector<const SymbolBase*>({ &TYPE_INT }), "again"),
+        STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL);
+}
+
+// Checks that the spec and property function are part of the key, and that
+// argument types only match parameters of the very same type symbol.
+TEST(OverloadIndex, KeysAndTypeIdentity) {
+    AtomTable atoms;
+    OverloadIndex<std::string> index;
+    const Atom spec = atoms.Intern("Spec");
+    const Atom name = atoms.Intern("X");
+    const std::vector<const SymbolBase*> none;
+
+    index.Put(OverloadKey(spec, name, PropertyFunction::GET), none, "get");
+    index.Put(OverloadKey(spec, name, PropertyFunction::SET), none, "set");
+    index.Put(OverloadKey(spec, name, PropertyFunction::NONE), none, "function");
+
+    ASSERT_STREQ("get", index.Find(OverloadKey(spec, name, PropertyFunction::GET), none)->c_str());
+    ASSERT_STREQ("set", index.Find(OverloadKey(spec, name, PropertyFunction::SET), none)->c_str());
+    ASSERT_STREQ("function", index.Find(OverloadKey(spec, name, PropertyFunction::NONE), none)->c_str());
+    ASSERT_TRUE(index.Find(OverloadKey(Atom(), name, PropertyFunction::NONE), none) == NULL);
+
+    std::unique_ptr<const SymbolBase> int_copy(TYPE_INT.Clone());
+    index.Put(OverloadKey(spec, name, PropertyFunction::NONE),
+        std::vector<const SymbolBase*>({ &TYPE_INT }), "function(int32)");
+    ASSERT_STREQ("function(int32)", index.Find(OverloadKey(spec, name, PropertyFunction::NONE),
+        std::vector<const SymbolBase*>({ &TYPE_INT }))->c_str());
+    ASSERT_TRUE(index.Find(OverloadKey(spec, name, PropertyFunction::NONE),
+        std::vector<const SymbolBase*>({ int_copy.get() })) == NULL);
+}
+
+// Checks that an index falls back on its global index.
+TEST(OverloadIndex, GlobalIndex) {
+    AtomTable atoms;
+    const OverloadKey key(Atom(), atoms.Intern("foo"), PropertyFunction::NONE);
+    const std::vector<const SymbolBase*> none;
+
+    OverloadIndex<std::string> global_index;
+    global_index.Put(key, none, "global");
+
+    OverloadIndex<std::string> index(&global_index);
+    ASSERT_STREQ("global", index.Find(key, none)->c_str());
+    ASSERT_TRUE(index.Find(OverloadKey(Atom(), atoms.Intern("bar"), PropertyFunction::NONE), none) == NULL);
+}
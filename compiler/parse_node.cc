@@ -0,0 +1,85 @@
+// Gunderscript-2 Parse Tree Node
+// (C) 2016 Christian Gunderman
+
+#include <algorithm>
+
+#include "gs_assert.h"
+
+#include "node_arena.h"
+#include "parse_node.h"
+
+namespace gunderscript {
+namespace compiler {
+
+// Initial capacity of a node's children array. Most nodes have fewer children.
+static const uint32_t kParseNodeInitialChildCapacity = 4;
+
+// Constructs a new node with no children and the specified NodeRule.
+ParseNode::ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset)
+    : arena_(arena), children_(NULL), child_count_(0), child_capacity_(0),
+    atom_(), offset_(offset), rule_(rule) {
+    value_.int_value = 0;
+}
+
+// Constructs a new node with no children, the specified NodeRule, and a boolean value.
+ParseNode::ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, bool value)
+    : arena_(arena), children_(NULL), child_count_(0), child_capacity_(0),
+    atom_(), offset_(offset), rule_(rule) {
+    value_.int_value = 0;
+    value_.bool_value = value;
+}
+
+// Constructs a new node with no children, the specified NodeRule, and a long value.
+ParseNode::ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, long value)
+    : arena_(arena), children_(NULL), child_count_(0), child_capacity_(0),
+    atom_(), offset_(offset), rule_(rule) {
+    value_.int_value = value;
+}
+
+// Constructs a new node with no children, the specified NodeRule, and a double value.
+ParseNode::ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, double value)
+    : arena_(arena), children_(NULL), child_count_(0), child_capacity_(0),
+    atom_(), offset_(offset), rule_(rule) {
+    value_.float_value = value;
+}
+
+// Constructs a new node with no children, the specified NodeRule, and a LexerSymbol.
+ParseNode::ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, LexerSymbol symbol)
+    : arena_(arena), children_(NULL), child_count_(0), child_capacity_(0),
+    atom_(), offset_(offset), rule_(rule) {
+    value_.int_value = 0;
+    value_.symbol_value = symbol;
+}
+
+// Constructs a new node with no children, the specified NodeRule, and an
+// interned string value.
+ParseNode::ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, Atom value)
+    : arena_(arena), children_(NULL), child_count_(0), child_capacity_(0),
+    atom_(value), offset_(offset), rule_(rule) {
+    value_.int_value = 0;
+}
+
+// Registers a new child node for this node.
+void ParseNode::AddChild(ParseNode* child) {
+    if (this->child_count_ == this->child_capacity_) {
+        uint32_t new_capacity = this->child_capacity_ == 0 ?
+            kParseNodeInitialChildCapacity : this->child_capacity_ * 2;
+        ParseNode** new_children = this->arena_.AllocateParseArray<ParseNode*>(new_capacity);
+
+        // The old array stays in the arena until the ParseNodes are released.
+        std::copy(this->children_, this->children_ + this->child_count_, new_children);
+        this->children_ = new_children;
+        this->child_capacity_ = new_capacity;
+    }
+
+    this->children_[this->child_count_++] = child;
+}
+
+// Gets a child from this node by its index (added order).
+ParseNode* ParseNode::child(size_t child) const {
+    GS_ASSERT_TRUE(child_count() > child, "Child index is out of bounds in ParseNode");
+    return this->children_[child];
+}
+
+} // namespace compiler
+} // namespace gunderscript
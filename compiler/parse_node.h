@@ -0,0 +1,63 @@
+// Gunderscript-2 Parse Tree Node
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_PARSE_NODE__H__
+#define GUNDERSCRIPT_PARSE_NODE__H__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gunderscript/atom_table.h"
+#include "gunderscript/lexer_resources.h"
+#include "gunderscript/node.h"
+
+namespace gunderscript {
+namespace compiler {
+
+class NodeArena;
+
+// Node of the tree that the Parser builds. The grammar creates nodes out of
+// order (e.g.: an operator after its left operand), so the Parser builds this
+// mutable tree first and the NodeArena then flattens it into a NodeArray in
+// pre-order for the later compiler stages.
+class ParseNode {
+public:
+    void AddChild(ParseNode* child);
+    ParseNode* child(size_t child) const;
+    size_t child_count() const { return this->child_count_; }
+    NodeRule rule() const { return this->rule_; }
+    uint32_t offset() const { return this->offset_; }
+    const NodeValue& value() const { return this->value_; }
+    Atom atom() const { return this->atom_; }
+    void set_bool_value(bool value) { this->value_.bool_value = value; }
+
+private:
+    friend class NodeArena;
+
+    ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset);
+    ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, bool value);
+    ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, long value);
+    ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, double value);
+    ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, LexerSymbol symbol);
+    ParseNode(NodeArena& arena, NodeRule rule, uint32_t offset, Atom value);
+
+    // Parse nodes are never deleted individually. They are freed with their arena.
+    ~ParseNode() = default;
+
+    // Arena that owns this node and its children array.
+    NodeArena& arena_;
+
+    // Arena allocated array of children. Grows by doubling into a new array.
+    ParseNode** children_;
+    uint32_t child_count_;
+    uint32_t child_capacity_;
+    Atom atom_;
+    NodeValue value_;
+    const uint32_t offset_;
+    NodeRule rule_;
+};
+
+} // namespace compiler
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_PARSE_NODE__H__
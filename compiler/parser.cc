@@ -1,42 +1,313 @@
 // Gunderscript-2 Parser
 // (C) 2014-2016 Christian Gunderman
 
+#include <algorithm>
+#include <exception>
 #include <functional>
+#include <unordered_map>
 
 #include "gs_assert.h"
+#include "parallel_for.h"
 #include "parser.h"
 
 namespace gunderscript {
 namespace compiler {
 
+// Precedence of the binary operators, from loosest to tightest binding.
+// Operators with the same precedence are left associative.
+static const int kPrecedenceNone = 0;
+static const int kPrecedenceLogOr = 1;
+static const int kPrecedenceLogAnd = 2;
+static const int kPrecedenceComparison = 3;
+static const int kPrecedenceAdditive = 4;
+static const int kPrecedenceMultiplicative = 5;
+static const int kPrecedenceMember = 6;
+
+// A binary operator and the node that it produces.
+typedef struct {
+    NodeRule rule;
+    int precedence;
+} BinaryOperator;
+
+// Maps each LexerSymbol to the binary operator that it represents. Symbols
+// that aren't binary operators have kPrecedenceNone.
+class BinaryOperatorTable {
+public:
+    BinaryOperatorTable() {
+        for (size_t i = 0; i < kSymbolCount; i++) {
+            this->operators_[i].rule = NodeRule::ANY_TYPE;
+            this->operators_[i].precedence = kPrecedenceNone;
+        }
+
+        Add(LexerSymbol::LOGOR, NodeRule::LOGOR, kPrecedenceLogOr);
+        Add(LexerSymbol::LOGAND, NodeRule::LOGAND, kPrecedenceLogAnd);
+        Add(LexerSymbol::EQUALS, NodeRule::EQUALS, kPrecedenceComparison);
+        Add(LexerSymbol::NOTEQUALS, NodeRule::NOT_EQUALS, kPrecedenceComparison);
+        Add(LexerSymbol::LESS, NodeRule::LESS, kPrecedenceComparison);
+        Add(LexerSymbol::LESSEQUALS, NodeRule::LESS_EQUALS, kPrecedenceComparison);
+        Add(LexerSymbol::GREATER, NodeRule::GREATER, kPrecedenceComparison);
+        Add(LexerSymbol::GREATEREQUALS, NodeRule::GREATER_EQUALS, kPrecedenceComparison);
+        Add(LexerSymbol::ADD, NodeRule::ADD, kPrecedenceAdditive);
+        Add(LexerSymbol::SUB, NodeRule::SUB, kPrecedenceAdditive);
+        Add(LexerSymbol::MUL, NodeRule::MUL, kPrecedenceMultiplicative);
+        Add(LexerSymbol::DIV, NodeRule::DIV, kPrecedenceMultiplicative);
+        Add(LexerSymbol::MOD, NodeRule::MOD, kPrecedenceMultiplicative);
+        Add(LexerSymbol::DOT, NodeRule::MEMBER, kPrecedenceMember);
+    }
+
+    const BinaryOperator& operator[](LexerSymbol symbol) const {
+        return this->operators_[(size_t)symbol];
+    }
+
+private:
+    static const size_t kSymbolCount = (size_t)LexerSymbol::ANY_TYPE + 1;
+    BinaryOperator operators_[kSymbolCount];
+
+    void Add(LexerSymbol symbol, NodeRule rule, int precedence) {
+        this->operators_[(size_t)symbol].rule = rule;
+        this->operators_[(size_t)symbol].precedence = precedence;
+    }
+};
+
+static const BinaryOperatorTable kBinaryOperators;
+
 // Parses all input in the parser object's Lexer component into an abstract
-// syntax tree of Nodes.
-// NOTE: root node must be deleted upon completion or it will never be freed.
-// Deleting the root node deletes ALL nodes in the tree recursively so deleting
-// the root deletes the tree.
+// syntax tree of Nodes. The tree is built from ParseNodes and then flattened
+// into a NodeArray for the later compiler stages.
+// NOTE: the tree is allocated from the Parser's NodeArena and is freed all at
+// once along with the arena, so nodes must never be deleted individually.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
 Node* Parser::Parse() {
+    return FlattenParseTree(*ParseModule());
+}
+
+// Parses the input like Parse(), but skips the body of every module level
+// function and then parses only the bodies of functions that can be reached
+// by calls from the entry point function or from spec functions. Functions
+// that can't be reached keep their declarations, so that their signatures
+// are still checked and the module still has them, but their bodies are
+// never parsed, so errors in them aren't found. Each gets an empty BLOCK
+// whose bool_value() is true instead, so that it can't be mistaken for an
+// empty body. Calls are matched by name alone, so every overload of a called
+// name is treated as reachable and the script itself can never call a
+// function whose body wasn't parsed.
+// entry_point: the name of the function that execution starts from.
+// Throws: Lexer or Parser exceptions from the respective headers if a problem
+// is encountered with lexemes or syntax.
+Node* Parser::ParseReachable(const std::string& entry_point) {
+    this->skip_bodies_ = true;
+    ParseNode* module_node = ParseModule();
+    this->skip_bodies_ = false;
+
+    ParseNode* reachable_module_node = ParseReachableBodies(
+        module_node,
+        this->tokens_.atoms().Intern(entry_point));
+
+    if (reachable_module_node == NULL) {
+        return Reparse();
+    }
+
+    return FlattenParseTree(*reachable_module_node);
+}
+
+// Parses the input like Parse(), but first finds the declarations and body
+// token ranges of every function and then parses the bodies in parallel.
+// Each worker thread has its own Parser and NodeArena since neither is
+// thread safe. They only share the TokenArray, which is read only by now.
+// The tree and any error thrown are the same as those from Parse().
+// thread_count: the number of threads, or 0 for one per hardware thread.
+// Throws: Lexer or Parser exceptions from the respective headers if a problem
+// is encountered with lexemes or syntax.
+Node* Parser::ParseParallel(unsigned int thread_count) {
+    thread_count = ParallelThreadCount(thread_count);
 
-    // Try to Parse the module. Upon failure, catch
-    // exception, cleanup, and rethrow.
+    // An error outside of the bodies is held until the bodies before it are
+    // parsed, since Parse() would have hit any errors in those first.
+    std::unique_ptr<Exception> module_error;
+    ParseNode* module_node = NULL;
+
+    this->skip_bodies_ = true;
+    this->skip_spec_bodies_ = true;
     try {
-        return ParseModule();
+        module_node = ParseModule();
+    }
+    catch (const Exception& ex) {
+        module_error.reset(new Exception(ex));
+    }
+    this->skip_bodies_ = false;
+    this->skip_spec_bodies_ = false;
+
+    // The workers' nodes are linked into the tree, so their arenas must live
+    // until it is flattened into this Parser's arena.
+    std::vector<std::unique_ptr<NodeArena>> worker_nodes(thread_count);
+    std::vector<std::unique_ptr<Parser>> workers(thread_count);
+    for (unsigned int i = 0; i < thread_count; i++) {
+        worker_nodes[i].reset(new NodeArena());
+        workers[i].reset(new Parser(this->tokens_, *worker_nodes[i]));
+    }
+
+    size_t body_count = this->lazy_bodies_.size();
+    std::vector<ParseNode*> block_nodes(body_count, NULL);
+    std::vector<std::exception_ptr> body_errors(body_count);
+
+    std::vector<size_t> body_end_indices(body_count, 0);
+
+    ParallelFor(body_count, thread_count, [&](unsigned int worker, size_t i) {
+        try {
+            block_nodes[i] = workers[worker]->ParseSkippedBody(this->lazy_bodies_[i].begin_index);
+            body_end_indices[i] = workers[worker]->next_index_;
+        }
+        catch (...) {
+            body_errors[i] = std::current_exception();
+        }
+    });
+
+    // Bodies are in source order, so the first error found is the one that
+    // Parse() would have thrown, as long as every body before it ended on
+    // the brace that matched its opening brace.
+    for (size_t i = 0; i < body_count; i++) {
+        if (body_errors[i]) {
+            std::rethrow_exception(body_errors[i]);
+        }
+
+        if (body_end_indices[i] != this->lazy_bodies_[i].end_index) {
+            return Reparse();
+        }
+
+        ParseNode* placeholder_node = this->lazy_bodies_[i].block_node;
+        for (size_t j = 0; j < block_nodes[i]->child_count(); j++) {
+            placeholder_node->AddChild(block_nodes[i]->child(j));
+        }
     }
-    catch (const Exception&) {
-        delete module_node_;
-        throw;
+
+    if (module_error != NULL) {
+        throw *module_error;
+    }
+
+    return FlattenParseTree(*module_node);
+}
+
+// Parses the input like Parse(), but skips the body of every function,
+// leaving an empty BLOCK in its place. The bodies of each module level
+// function or spec are then parsed on their own by ParseImplementation(), so
+// that the whole tree never has to be in memory at once. The declarations
+// are in this Parser's arena and the bodies in the arenas given to
+// ParseImplementation().
+// Throws: Lexer or Parser exceptions from the respective headers if the
+// declarations have a problem with lexemes or syntax. Errors in the bodies
+// are only found by ParseImplementation(), so the error thrown may not be
+// the first one that Parse() would have found.
+Node* Parser::ParseDeclarations() {
+    this->skip_bodies_ = true;
+    this->skip_spec_bodies_ = true;
+    ParseNode* module_node = ParseModule();
+    this->skip_bodies_ = false;
+    this->skip_spec_bodies_ = false;
+
+    // Both bodies and implementations are in source order, so each
+    // implementation's bodies are the ones between it and the next.
+    std::vector<ParseNode*> impl_nodes;
+    for (size_t i = 2; i < 4; i++) {
+        for (size_t j = 0; j < module_node->child(i)->child_count(); j++) {
+            impl_nodes.push_back(module_node->child(i)->child(j));
+        }
     }
+
+    std::sort(impl_nodes.begin(), impl_nodes.end(), [](const ParseNode* a, const ParseNode* b) {
+        return a->offset() < b->offset();
+    });
+
+    size_t next_body = 0;
+    for (size_t i = 0; i < impl_nodes.size(); i++) {
+        LazyImplementation impl = { impl_nodes[i], next_body, 0 };
+
+        while (next_body < this->lazy_bodies_.size() &&
+            (i + 1 == impl_nodes.size() ||
+                this->lazy_bodies_[next_body].function_node->offset() < impl_nodes[i + 1]->offset())) {
+            impl.body_count++;
+            next_body++;
+        }
+
+        this->lazy_impls_.insert(std::make_pair(impl_nodes[i]->offset(), impl));
+    }
+
+    // The ParseNodes are kept for ParseImplementation() to splice the bodies
+    // into.
+    return this->nodes_.Flatten(*module_node);
+}
+
+// Parses the skipped bodies of a function or spec from the tree returned by
+// ParseDeclarations() and returns a copy of its subtree with the bodies
+// filled in. The copy is the same as the function or spec's subtree from
+// Parse(), but has none of the symbols of the declarations' tree.
+// impl_node: a child of the FUNCTIONS or SPECS node of the declarations.
+// nodes: the arena to put the bodies and the copy in. Not this Parser's arena,
+// since its ParseNodes are released once the copy is flattened.
+// Returns: the copy, or NULL if a body did not end on its matching brace,
+// in which case the input must be parsed with Parse() to find the error.
+// Throws: Lexer or Parser exceptions from the respective headers if a body
+// has a problem with lexemes or syntax.
+Node* Parser::ParseImplementation(const Node* impl_node, NodeArena& nodes) {
+    GS_ASSERT_FALSE(&nodes == &this->nodes_, "Implementation parsed into the declarations' arena");
+
+    const LazyImplementation& impl = this->lazy_impls_.at(impl_node->offset());
+    Parser body_parser(this->tokens_, nodes);
+    std::unordered_map<const ParseNode*, ParseNode*> bodies;
+
+    for (size_t i = impl.first_body; i < impl.first_body + impl.body_count; i++) {
+        const LazyFunctionBody& body = this->lazy_bodies_[i];
+        ParseNode* block_node = body_parser.ParseSkippedBody(body.begin_index);
+
+        if (body_parser.next_index_ != body.end_index) {
+            return NULL;
+        }
+
+        bodies.insert(std::make_pair(body.block_node, block_node));
+    }
+
+    return body_parser.FlattenParseTree(*body_parser.SpliceBodies(impl.impl_node, bodies));
+}
+
+// Copies the nodes of a function or spec that lead down to its skipped
+// bodies into this Parser's arena, replacing each placeholder BLOCK with its
+// parsed body, which starts at the same brace. All other nodes are shared
+// with the declarations' tree.
+// node: the node to copy.
+// bodies: the parsed body of each placeholder BLOCK.
+// Returns: the copy.
+ParseNode* Parser::SpliceBodies(
+    const ParseNode* node,
+    const std::unordered_map<const ParseNode*, ParseNode*>& bodies) {
+
+    std::unordered_map<const ParseNode*, ParseNode*>::const_iterator body = bodies.find(node);
+    if (body != bodies.end()) {
+        return body->second;
+    }
+
+    if (node->rule() != NodeRule::SPEC &&
+        node->rule() != NodeRule::FUNCTIONS &&
+        node->rule() != NodeRule::FUNCTION) {
+        return const_cast<ParseNode*>(node);
+    }
+
+    GS_ASSERT_FALSE(node->atom().valid(), "Unexpected value in spec or function node");
+
+    ParseNode* copy_node = this->nodes_.NewParseNode(node->rule(), node->offset());
+    for (size_t i = 0; i < node->child_count(); i++) {
+        copy_node->AddChild(SpliceBodies(node->child(i), bodies));
+    }
+
+    return copy_node;
 }
 
 // Parses a module (e.g.: a script).
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-Node* Parser::ParseModule() {
-    module_node_ = new Node(
+ParseNode* Parser::ParseModule() {
+    module_node_ = this->nodes_.NewParseNode(
         NodeRule::MODULE,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     ParsePackageDeclaration(module_node_);
 
     // 0 or more.
@@ -52,32 +323,31 @@ Node* Parser::ParseModule() {
 // package "MyPackage";
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParsePackageDeclaration(Node* node) {
+void Parser::ParsePackageDeclaration(ParseNode* node) {
 
     GS_ASSERT_NODE_RULE(node, NodeRule::MODULE);
 
     // Check "package" keyword.
     if (!AdvanceKeyword(LexerSymbol::PACKAGE)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MISSING_PACKAGE);
     }
 
     // Check package name string.
-    if (AdvanceNext()->type != LexerTokenType::STRING) {
+    if (AdvanceNext().type() != LexerTokenType::STRING) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_INVALID_PACKAGE);
     }
 
     // Save package name string in first module child.
-    node->AddChild(new Node(
+    node->AddChild(this->nodes_.NewParseNode(
         NodeRule::NAME,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
-        CurrentToken()->string_const));
+        this->current_offset(),
+        CurrentToken().atom()));
 
     AdvanceNext();
     ParseSemicolon();
@@ -88,14 +358,13 @@ void Parser::ParsePackageDeclaration(Node* node) {
 // and may be from 0 to many.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseDependsStatements(Node* node) {
+void Parser::ParseDependsStatements(ParseNode* node) {
 
     GS_ASSERT_NODE_RULE(node, NodeRule::MODULE);
 
-    Node* depends_node = new Node(
+    ParseNode* depends_node = this->nodes_.NewParseNode(
         NodeRule::DEPENDS,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
 
     node->AddChild(depends_node);
 
@@ -110,32 +379,31 @@ void Parser::ParseDependsStatements(Node* node) {
 // depends "OtherScript";
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseDependsStatement(Node* node) {
+void Parser::ParseDependsStatement(ParseNode* node) {
 
     GS_ASSERT_NODE_RULE(node, NodeRule::DEPENDS);
 
     // Check "depends" statement.
     if (!CurrentKeyword(LexerSymbol::DEPENDS)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_DEPENDS);
     }
 
     // Check for package name to import.
-    if (AdvanceNext()->type != LexerTokenType::STRING) {
+    if (AdvanceNext().type() != LexerTokenType::STRING) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_DEPENDS);
     }
 
     // Add package name to the depends tree node.
-    node->AddChild(new Node(
+    node->AddChild(this->nodes_.NewParseNode(
         NodeRule::NAME,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
-        CurrentToken()->string_const));
+        this->current_offset(),
+        CurrentToken().atom()));
 
     AdvanceNext();
     ParseSemicolon();
@@ -148,8 +416,8 @@ void Parser::ParseSemicolon() {
     // Check for terminating semicolon.
     if (!CurrentSymbol(LexerSymbol::SEMICOLON)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_EXPECTED_SEMICOLON);
     }
 }
@@ -158,37 +426,35 @@ void Parser::ParseSemicolon() {
 // inheritance) or static function definitions (non-class functions).
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseModuleBody(Node* module_node) {
+void Parser::ParseModuleBody(ParseNode* module_node) {
 
     GS_ASSERT_NODE_RULE(module_node, NodeRule::MODULE);
 
-    Node* specs_node = new Node(
+    ParseNode* specs_node = this->nodes_.NewParseNode(
         NodeRule::SPECS,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     module_node->AddChild(specs_node);
 
-    Node* functions_node = new Node(
+    ParseNode* functions_node = this->nodes_.NewParseNode(
         NodeRule::FUNCTIONS,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     module_node->AddChild(functions_node);
 
     // Addresses Github issue #64.
-    if (CurrentToken()->type == LexerTokenType::ACCESS_MODIFIER && !has_next()) {
+    if (CurrentToken().type() == LexerTokenType::ACCESS_MODIFIER && !has_next()) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_EOF);
     }
 
     while (has_next()) {
 
         // Check if current token is an access modifier. If not, this is malformed syntax.
-        if (CurrentToken()->type != LexerTokenType::ACCESS_MODIFIER) {
+        if (CurrentToken().type() != LexerTokenType::ACCESS_MODIFIER) {
             THROW_EXCEPTION(
-                this->lexer_.current_line_number(),
-                this->lexer_.current_column_number(),
+                this->current_line_number(),
+                this->current_column_number(),
                 STATUS_PARSER_MALFORMED_SPEC_OR_FUNC_ACCESS_MODIFIER_MISSING);
         }
 
@@ -212,43 +478,41 @@ void Parser::ParseModuleBody(Node* module_node) {
 // public spec MyClassName { .....
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseSpecDefinition(Node* specs_node) {
+void Parser::ParseSpecDefinition(ParseNode* specs_node) {
 
     GS_ASSERT_NODE_RULE(specs_node, NodeRule::SPECS);
 
-    Node* spec_node = new Node(
+    ParseNode* spec_node = this->nodes_.NewParseNode(
         NodeRule::SPEC,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     specs_node->AddChild(spec_node);
 
     // Check access modifier.
-    if (CurrentToken()->type != LexerTokenType::ACCESS_MODIFIER) {
+    if (CurrentToken().type() != LexerTokenType::ACCESS_MODIFIER) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_SPEC_OR_FUNC_ACCESS_MODIFIER_MISSING);
     }
 
-    spec_node->AddChild(new Node(
+    spec_node->AddChild(this->nodes_.NewParseNode(
         NodeRule::ACCESS_MODIFIER,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
-        CurrentToken()->symbol));
+        this->current_offset(),
+        CurrentToken().symbol()));
 
     // Check for "spec" keyword in declaration.
     if (!AdvanceKeyword(LexerSymbol::SPEC)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_SPEC_SPEC_KEYWORD_MISSING);
     }
 
     // Check for spec NAME.
-    if (AdvanceNext()->type != LexerTokenType::NAME) {
+    if (AdvanceNext().type() != LexerTokenType::NAME) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_SPEC_NAME_MISSING);
     }
 
@@ -257,8 +521,8 @@ void Parser::ParseSpecDefinition(Node* specs_node) {
     // Check for opening curly brace.
     if (!CurrentSymbol(LexerSymbol::LBRACE)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_SPEC_LBRACE_MISSING);
     }
 
@@ -268,8 +532,8 @@ void Parser::ParseSpecDefinition(Node* specs_node) {
     // Check for closing curly brace.
     if (!CurrentSymbol(LexerSymbol::RBRACE)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_SPEC_RBRACE_MISSING);
     }
 }
@@ -280,25 +544,23 @@ void Parser::ParseSpecDefinition(Node* specs_node) {
 // as properties.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseSpecBody(Node* spec_node) {
+void Parser::ParseSpecBody(ParseNode* spec_node) {
 
     GS_ASSERT_NODE_RULE(spec_node, NodeRule::SPEC);
 
-    Node* properties_node = new Node(
+    ParseNode* properties_node = this->nodes_.NewParseNode(
         NodeRule::PROPERTIES,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
-    Node* functions_node = new Node(
+        this->current_offset());
+    ParseNode* functions_node = this->nodes_.NewParseNode(
         NodeRule::FUNCTIONS,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
 
     spec_node->AddChild(functions_node);
     spec_node->AddChild(properties_node);
 
     // Parse body elements until we reach the closing curly brace.
     while (!AdvanceSymbol(LexerSymbol::RBRACE)) {
-        switch (CurrentToken()->type) {
+        switch (CurrentToken().type()) {
         case LexerTokenType::ACCESS_MODIFIER:
             ParseFunction(functions_node, true);
             break;
@@ -307,8 +569,8 @@ void Parser::ParseSpecBody(Node* spec_node) {
             break;
         default:
             THROW_EXCEPTION(
-                this->lexer_.current_line_number(),
-                this->lexer_.current_column_number(),
+                this->current_line_number(),
+                this->current_column_number(),
                 STATUS_PARSER_MALFORMED_SPEC_UNKNOWN_MEMBER);
         }
     }
@@ -319,45 +581,43 @@ void Parser::ParseSpecBody(Node* spec_node) {
 // int X { public get; concealed set; }
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseProperty(Node* properties_node) {
+void Parser::ParseProperty(ParseNode* properties_node) {
 
     GS_ASSERT_NODE_RULE(properties_node, NodeRule::PROPERTIES);
 
-    Node* property_node = new Node(
+    ParseNode* property_node = this->nodes_.NewParseNode(
         NodeRule::PROPERTY,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     properties_node->AddChild(property_node);
 
     // Make sure first token is a TYPE.
-    if (CurrentToken()->type != LexerTokenType::NAME) {
+    if (CurrentToken().type() != LexerTokenType::NAME) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_PROPERTY_TYPE_MISSING);
     }
 
     ParseTypeExpression(property_node);
 
     // Make sure second token is a NAME.
-    if (CurrentToken()->type != LexerTokenType::NAME) {
+    if (CurrentToken().type() != LexerTokenType::NAME) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_PROPERTY_NAME_MISSING);
     }
 
-    property_node->AddChild(new Node(
+    property_node->AddChild(this->nodes_.NewParseNode(
         NodeRule::NAME,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
-        CurrentToken()->string_const));
+        this->current_offset(),
+        CurrentToken().atom()));
 
     // Check for LBRACE
     if (!AdvanceSymbol(LexerSymbol::LBRACE)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_PROPERTY_LBRACE_MISSING);
     }
 
@@ -367,8 +627,8 @@ void Parser::ParseProperty(Node* properties_node) {
     // Check for RBRACE
     if (!CurrentSymbol(LexerSymbol::RBRACE)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_PROPERTY_RBRACE_MISSING);
     }
 }
@@ -376,26 +636,23 @@ void Parser::ParseProperty(Node* properties_node) {
 // Parses between the braces of a property definition.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParsePropertyBody(Node* property_node) {
+void Parser::ParsePropertyBody(ParseNode* property_node) {
 
     GS_ASSERT_NODE_RULE(property_node, NodeRule::PROPERTY);
 
-    Node* getter_node = new Node(
+    ParseNode* getter_node = this->nodes_.NewParseNode(
         NodeRule::PROPERTY_FUNCTION,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
-    Node* setter_node = new Node(
+        this->current_offset());
+    ParseNode* setter_node = this->nodes_.NewParseNode(
         NodeRule::PROPERTY_FUNCTION,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
 
     property_node->AddChild(getter_node);
     property_node->AddChild(setter_node);
 
     // Giving an error message with the line number of the close brace is pointless
     // so lets save the line numbers of the first line of the property body instead.
-    int start_property_body_line = this->lexer_.current_line_number();
-    int start_property_body_column = this->lexer_.current_column_number();
+    uint32_t start_property_body_offset = this->current_offset();
 
     // There must be exactly 2 body functions (get/set), parse twice.
     // Functions return if there is no body function.
@@ -405,8 +662,8 @@ void Parser::ParsePropertyBody(Node* property_node) {
     // Properties MUST define both members.
     if (getter_node->child_count() == 0 || setter_node->child_count() == 0) {
         THROW_EXCEPTION(
-            start_property_body_line,
-            start_property_body_column,
+            this->tokens_.lines().line_number(start_property_body_offset),
+            this->tokens_.lines().column_number(start_property_body_offset),
             STATUS_PARSER_MALFORMED_PROPERTY_MISSING_PROPERTY_FUNCTION);
     }
 }
@@ -414,7 +671,7 @@ void Parser::ParsePropertyBody(Node* property_node) {
 // Parses a GET or SET function in a property body (see C# properties for info).
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParsePropertyBodyFunction(Node* getter_node, Node* setter_node) {
+void Parser::ParsePropertyBodyFunction(ParseNode* getter_node, ParseNode* setter_node) {
 
     GS_ASSERT_NODE_RULE(getter_node, NodeRule::PROPERTY_FUNCTION);
     GS_ASSERT_NODE_RULE(setter_node, NodeRule::PROPERTY_FUNCTION);
@@ -425,17 +682,17 @@ void Parser::ParsePropertyBodyFunction(Node* getter_node, Node* setter_node) {
     }
 
     // We have a getter/setter here, Check for the access modifier.
-    if (CurrentToken()->type != LexerTokenType::ACCESS_MODIFIER) {
+    if (CurrentToken().type() != LexerTokenType::ACCESS_MODIFIER) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_PROPERTYFUNCTION_MISSING_ACCESS_MODIFIER);
     }
 
-    LexerSymbol access_modifier = CurrentToken()->symbol;
+    LexerSymbol access_modifier = CurrentToken().symbol();
 
     // Determine node to receive output.
-    Node* node = NULL;
+    ParseNode* node = NULL;
     if (AdvanceKeyword(LexerSymbol::GET)) {
         node = getter_node;
     }
@@ -444,23 +701,22 @@ void Parser::ParsePropertyBodyFunction(Node* getter_node, Node* setter_node) {
     }
     else {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_PROPERTYFUNCTION_INVALID_ACCESSORMUTATOR);
     }
 
     // Check if property body function was specified twice.
     if (node->child_count() > 0) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_PROPERTYFUNCTION_DUPLICATE);
     }
 
-    node->AddChild(new Node(
+    node->AddChild(this->nodes_.NewParseNode(
         NodeRule::ACCESS_MODIFIER,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(), 
+        this->current_offset(), 
         access_modifier));
 
     // If we found a semicolon, it's an auto property and we're done.
@@ -478,26 +734,24 @@ void Parser::ParsePropertyBodyFunction(Node* getter_node, Node* setter_node) {
 // public int sqrt(int value) { ...
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseFunction(Node* node, bool in_spec) {
-    Node* function_node = new Node(
+void Parser::ParseFunction(ParseNode* node, bool in_spec) {
+    ParseNode* function_node = this->nodes_.NewParseNode(
         NodeRule::FUNCTION,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     node->AddChild(function_node);
 
     // Check for ACCESS_MODIFIER.
-    if (CurrentToken()->type != LexerTokenType::ACCESS_MODIFIER) {
+    if (CurrentToken().type() != LexerTokenType::ACCESS_MODIFIER) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_FUNCTION_MISSING_ACCESS_MODIFIER);
     }
 
-    function_node->AddChild(new Node(
+    function_node->AddChild(this->nodes_.NewParseNode(
         NodeRule::ACCESS_MODIFIER, 
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(), 
-        CurrentToken()->symbol));
+        this->current_offset(), 
+        CurrentToken().symbol()));
 
     // Check if this is a constructor definition or a function definition.
     if (AdvanceKeyword(LexerSymbol::CONSTRUCT)) {
@@ -505,56 +759,53 @@ void Parser::ParseFunction(Node* node, bool in_spec) {
         // Disallow constructors outside of function.
         if (!in_spec) {
             THROW_EXCEPTION(
-                this->lexer_.current_line_number(),
-                this->lexer_.current_column_number(),
+                this->current_line_number(),
+                this->current_column_number(),
                 STATUS_PARSER_CONSTRUCTOR_OUTSIDE_SPEC);
         }
 
         // Constructor functions are void type.
-        function_node->AddChild(new Node(
+        function_node->AddChild(this->nodes_.NewParseNode(
             NodeRule::TYPE,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
-            &TYPE_VOID.symbol_name()));
+            this->current_offset(),
+            this->tokens_.atoms().Intern(TYPE_VOID.symbol_name())));
 
         // Name is mangled to be inaccessible from user code.
         function_node->AddChild(
-            new Node(NodeRule::NAME,
-                this->lexer_.current_line_number(),
-                this->lexer_.current_column_number(),
-                &kConstructorName));
+            this->nodes_.NewParseNode(NodeRule::NAME,
+                this->current_offset(),
+                this->tokens_.atoms().Intern(kConstructorName)));
     }
     else {
         // Check for TYPE for return type.
-        if (CurrentToken()->type != LexerTokenType::NAME) {
+        if (CurrentToken().type() != LexerTokenType::NAME) {
             THROW_EXCEPTION(
-                this->lexer_.current_line_number(),
-                this->lexer_.current_column_number(),
+                this->current_line_number(),
+                this->current_column_number(),
                 STATUS_PARSER_MALFORMED_FUNCTION_MISSING_TYPE);
         }
 
         ParseTypeExpression(function_node);
 
         // Check for NAME symbol type for function name.
-        if (CurrentToken()->type != LexerTokenType::NAME) {
+        if (CurrentToken().type() != LexerTokenType::NAME) {
             THROW_EXCEPTION(
-                this->lexer_.current_line_number(),
-                this->lexer_.current_column_number(),
+                this->current_line_number(),
+                this->current_column_number(),
                 STATUS_PARSER_MALFORMED_FUNCTION_MISSING_NAME);
         }
 
-        function_node->AddChild(new Node(
+        function_node->AddChild(this->nodes_.NewParseNode(
             NodeRule::NAME,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
-            CurrentToken()->string_const));
+            this->current_offset(),
+            CurrentToken().atom()));
     }
 
     // Check for opening parenthesis for parameters.
     if (!AdvanceSymbol(LexerSymbol::LPAREN)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_FUNCTION_MISSING_LPAREN);
     }
 
@@ -563,27 +814,33 @@ void Parser::ParseFunction(Node* node, bool in_spec) {
     // Check for closing parenthesis for params.
     if (!CurrentSymbol(LexerSymbol::RPAREN)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_FUNCTION_MISSING_RPAREN);
     }
 
     AdvanceNext();
 
-    ParseBlockStatement(function_node);
+    // Spec functions are only skipped when parsing in parallel since calls to
+    // them can't be resolved for ParseReachable() without types.
+    if (this->skip_bodies_ && (!in_spec || this->skip_spec_bodies_)) {
+        SkipBlockStatement(function_node);
+    }
+    else {
+        ParseBlockStatement(function_node);
+    }
 }
 
 // Parses function arguments.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseFunctionParameters(Node* function_node) {
+void Parser::ParseFunctionParameters(ParseNode* function_node) {
 
     GS_ASSERT_NODE_RULE(function_node, NodeRule::FUNCTION);
 
-    Node* parameters_node = new Node(
+    ParseNode* parameters_node = this->nodes_.NewParseNode(
         NodeRule::FUNCTION_PARAMETERS,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     function_node->AddChild(parameters_node);
 
     // Keep on parsing till we reach the close parenthesis.
@@ -595,8 +852,8 @@ void Parser::ParseFunctionParameters(Node* function_node) {
             // Check for comma.
             if (!CurrentSymbol(LexerSymbol::COMMA)) {
                 THROW_EXCEPTION(
-                    this->lexer_.current_line_number(),
-                    this->lexer_.current_column_number(),
+                    this->current_line_number(),
+                    this->current_column_number(),
                     STATUS_PARSER_MALFORMED_FUNCTIONPARAMS_MISSING_COMMA);
             }
 
@@ -609,60 +866,67 @@ void Parser::ParseFunctionParameters(Node* function_node) {
 // Parses a single function parameter.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseFunctionParameter(Node* parameters_node) {
+void Parser::ParseFunctionParameter(ParseNode* parameters_node) {
 
     GS_ASSERT_NODE_RULE(parameters_node, NodeRule::FUNCTION_PARAMETERS);
 
-    Node* parameter_node = new Node(
+    ParseNode* parameter_node = this->nodes_.NewParseNode(
         NodeRule::FUNCTION_PARAMETER,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     parameters_node->AddChild(parameter_node);
 
     // Check for a parameter TYPE.
-    if (CurrentToken()->type != LexerTokenType::NAME) {
+    if (CurrentToken().type() != LexerTokenType::NAME) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_FUNCTIONPARAMS_MISSING_TYPE);
     }
 
     ParseTypeExpression(parameter_node);
 
     // Check for a parameter NAME.
-    if (CurrentToken()->type != LexerTokenType::NAME) {
+    if (CurrentToken().type() != LexerTokenType::NAME) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_FUNCTIONPARAMS_MISSING_NAME);
     }
 
-    parameter_node->AddChild(new Node(
+    parameter_node->AddChild(this->nodes_.NewParseNode(
         NodeRule::NAME,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
-        CurrentToken()->string_const));
+        this->current_offset(),
+        CurrentToken().atom()));
 }
 
 // Parses a block of code from an open brace to a closed brace.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseBlockStatement(Node* node) {
+void Parser::ParseBlockStatement(ParseNode* node) {
 
     GS_ASSERT_FALSE(node == NULL, "NULL node in ParseBlockStatement");
 
-    Node* block_node = new Node(
+    ParseNode* block_node = this->nodes_.NewParseNode(
         NodeRule::BLOCK,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     node->AddChild(block_node);
 
+    ParseBlockStatements(block_node);
+}
+
+// Parses the statements of a block, from its open brace to its closed brace.
+// Throws: Lexer or Parser exceptions from the respective headers if a problem
+// is encountered with lexemes or syntax.
+void Parser::ParseBlockStatements(ParseNode* block_node) {
+
+    GS_ASSERT_NODE_RULE(block_node, NodeRule::BLOCK);
+
     // Check opening brace.
     // TODO: this might never be hit. Re-evaluate whether or not they are need.
     if (!CurrentSymbol(LexerSymbol::LBRACE)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_BLOCK_MISSING_LBRACE);
     }
 
@@ -676,21 +940,184 @@ void Parser::ParseBlockStatement(Node* node) {
     // TODO: this might never be hit. Re-evaluate whether or not they are need.
     if (!CurrentSymbol(LexerSymbol::RBRACE)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_BLOCK_MISSING_RBRACE);
     }
 }
 
+// Skips over a function body by counting braces, without parsing it, and
+// gives the function an empty BLOCK in its place. The body is parsed later,
+// by ParseReachableBodies() if the function is called, or by ParseParallel().
+// Throws: Lexer or Parser exceptions from the respective headers if the body
+// has no closing brace.
+void Parser::SkipBlockStatement(ParseNode* function_node) {
+
+    GS_ASSERT_NODE_RULE(function_node, NodeRule::FUNCTION);
+
+    ParseNode* block_node = this->nodes_.NewParseNode(
+        NodeRule::BLOCK,
+        this->current_offset());
+    function_node->AddChild(block_node);
+
+    // Check opening brace.
+    if (!CurrentSymbol(LexerSymbol::LBRACE)) {
+        THROW_EXCEPTION(
+            this->current_line_number(),
+            this->current_column_number(),
+            STATUS_PARSER_MALFORMED_BLOCK_MISSING_LBRACE);
+    }
+
+    LazyFunctionBody body = { function_node, block_node, this->next_index_, 0 };
+    this->lazy_bodies_.push_back(body);
+
+    // Only the type and symbol columns are read, so this stays in cache.
+    size_t index = this->next_index_ - 1;
+    for (int depth = 0; index < this->tokens_.size(); index++) {
+        if (this->tokens_.type(index) != LexerTokenType::SYMBOL) {
+            continue;
+        }
+
+        LexerSymbol symbol = this->tokens_.payload(index).symbol;
+        if (symbol == LexerSymbol::LBRACE) {
+            depth++;
+        }
+        else if (symbol == LexerSymbol::RBRACE && --depth == 0) {
+            break;
+        }
+    }
+
+    // Stop on the closing brace, as ParseBlockStatement() does. If there is
+    // none, this throws the same Lexer error or EOF as parsing the body would.
+    this->lazy_bodies_.back().end_index = index + 1;
+    this->next_index_ = index;
+    AdvanceNext();
+}
+
+// Adds a call's function name, and those of all calls nested in it, to a list.
+static void FindCalledNames(const ParseNode* node, std::vector<Atom>& called_names) {
+    if (node->rule() == NodeRule::CALL) {
+        called_names.push_back(node->child(0)->atom());
+    }
+
+    for (size_t i = 0; i < node->child_count(); i++) {
+        FindCalledNames(node->child(i), called_names);
+    }
+}
+
+// Parses the skipped bodies of every function that can be reached from the
+// entry point or the specs. The rest keep the empty BLOCKs that they were
+// given in place of their bodies, which are marked by setting their value.
+// Returns: the module, or NULL if a body did not end on its matching brace,
+// in which case the input must be parsed serially.
+// Throws: Lexer or Parser exceptions from the respective headers if a problem
+// is encountered with lexemes or syntax.
+ParseNode* Parser::ParseReachableBodies(ParseNode* module_node, Atom entry_point) {
+
+    GS_ASSERT_NODE_RULE(module_node, NodeRule::MODULE);
+
+    // Look up skipped bodies by function name. A function's name is its
+    // third child, after its access modifier and type.
+    std::unordered_map<Atom, std::vector<size_t>> bodies_by_name;
+    for (size_t i = 0; i < this->lazy_bodies_.size(); i++) {
+        bodies_by_name[this->lazy_bodies_[i].function_node->child(2)->atom()].push_back(i);
+    }
+
+    std::vector<bool> reached(this->lazy_bodies_.size(), false);
+    std::vector<Atom> called_names(1, entry_point);
+    FindCalledNames(module_node->child(2), called_names);
+
+    while (!called_names.empty()) {
+        Atom name = called_names.back();
+        called_names.pop_back();
+
+        auto overloads = bodies_by_name.find(name);
+        if (overloads == bodies_by_name.end()) {
+            continue;
+        }
+
+        for (size_t i : overloads->second) {
+            if (reached[i]) {
+                continue;
+            }
+
+            reached[i] = true;
+
+            LazyFunctionBody& body = this->lazy_bodies_[i];
+            this->next_index_ = body.begin_index;
+            ParseBlockStatements(body.block_node);
+
+            if (this->next_index_ != body.end_index) {
+                return NULL;
+            }
+
+            FindCalledNames(body.block_node, called_names);
+        }
+    }
+
+    for (size_t i = 0; i < this->lazy_bodies_.size(); i++) {
+        if (!reached[i]) {
+            this->lazy_bodies_[i].block_node->set_bool_value(true);
+        }
+    }
+
+    return module_node;
+}
+
+// Parses a function body that was skipped by SkipBlockStatement() into a new
+// BLOCK.
+// begin_index: the LazyFunctionBody's begin_index.
+// Throws: Lexer or Parser exceptions from the respective headers if a problem
+// is encountered with lexemes or syntax.
+ParseNode* Parser::ParseSkippedBody(size_t begin_index) {
+    this->next_index_ = begin_index;
+
+    ParseNode* block_node = this->nodes_.NewParseNode(
+        NodeRule::BLOCK,
+        this->current_offset());
+
+    ParseBlockStatements(block_node);
+
+    return block_node;
+}
+
+// Throws away a parse that skipped function bodies and parses the whole input
+// again with Parse(). Brace matching finds the same end for a body as parsing
+// it does for all valid input, but statements missing their semicolon swallow
+// the next token, which may be a brace.
+// Throws: Lexer or Parser exceptions from the respective headers if a problem
+// is encountered with lexemes or syntax.
+Node* Parser::Reparse() {
+    this->next_index_ = 0;
+    this->lazy_bodies_.clear();
+
+    return Parse();
+}
+
+// Flattens a parse tree into this Parser's arena and then frees the arena's
+// ParseNodes, which nothing looks at again, so that the tree isn't kept in
+// memory twice.
+// root: the root of the parse tree.
+// Returns: the root node of the flattened tree.
+Node* Parser::FlattenParseTree(const ParseNode& root) {
+    Node* root_node = this->nodes_.Flatten(root);
+    this->nodes_.ReleaseParseNodes();
+
+    // The skipped bodies pointed into the released nodes.
+    this->lazy_bodies_.clear();
+
+    return root_node;
+}
+
 // Parses any stand-alone statement in code (has side effects or control flow,
 // not just an expression).
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseStatement(Node* node) {
+void Parser::ParseStatement(ParseNode* node) {
 
     GS_ASSERT_FALSE(node == NULL, "NULL node in ParseStatement");
 
-    switch (CurrentToken()->type) {
+    switch (CurrentToken().type()) {
     case LexerTokenType::SYMBOL:
         // TODO: do we NEED to allow parenthesis in member expressions?
         if (CurrentSymbol(LexerSymbol::LBRACE)) {
@@ -703,8 +1130,8 @@ void Parser::ParseStatement(Node* node) {
         // and so we fall through to NAME.
         if (!CurrentSymbol(LexerSymbol::LPAREN)) {
             THROW_EXCEPTION(
-                this->lexer_.current_line_number(),
-                this->lexer_.current_column_number(),
+                this->current_line_number(),
+                this->current_column_number(),
                 STATUS_PARSER_EXPECTED_STATEMENT);
         }
     case LexerTokenType::NAME:
@@ -715,8 +1142,8 @@ void Parser::ParseStatement(Node* node) {
         break;
     default:
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_EXPECTED_STATEMENT);
     }
 }
@@ -724,11 +1151,11 @@ void Parser::ParseStatement(Node* node) {
 // Parses a keyword statement (control flow structures and return statement).
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseKeywordStatement(Node* node) {
+void Parser::ParseKeywordStatement(ParseNode* node) {
 
     GS_ASSERT_FALSE(node == NULL, "NULL node in ParseKeywordStatement");
 
-    switch (CurrentToken()->symbol) {
+    switch (CurrentToken().symbol()) {
     case LexerSymbol::IF:
         ParseIfStatement(node);
         break;
@@ -743,30 +1170,29 @@ void Parser::ParseKeywordStatement(Node* node) {
         break;
     default:
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_EXPECTED_STATEMENT_INVALID_KEYWORD);
     }
 }
 
 // Parses if statement and attaches the IF node to the given node.
-void Parser::ParseIfStatement(Node* node) {
+void Parser::ParseIfStatement(ParseNode* node) {
     GS_ASSERT_TRUE(CurrentKeyword(LexerSymbol::IF), "Expected IF token in if statement parser");
 
     AdvanceNext();
 
     // Create IF statement node.
-    Node* if_node = new Node(
+    ParseNode* if_node = this->nodes_.NewParseNode(
         NodeRule::IF,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     node->AddChild(if_node);
 
     // Check for left parenthesis.
     if (!CurrentSymbol(LexerSymbol::LPAREN)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_IF_MISSING_LPAREN);
     }
 
@@ -778,8 +1204,8 @@ void Parser::ParseIfStatement(Node* node) {
     // Check for right parenthesis.
     if (!CurrentSymbol(LexerSymbol::RPAREN)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_IF_MISSING_RPAREN);
     }
 
@@ -795,17 +1221,16 @@ void Parser::ParseIfStatement(Node* node) {
 }
 
 // Parses else or else if statement or returns if neither is given.
-void Parser::ParseElIfStatement(Node* node) {
+void Parser::ParseElIfStatement(ParseNode* node) {
     GS_ASSERT_NODE_RULE(node, NodeRule::IF);
 
     // Check if an else / else if was provided.
     if (!CurrentKeyword(LexerSymbol::ELSE)) {
 
         // Still need an empty block to maintain the proper structure of the tree.
-        Node* else_block_node = new Node(
+        ParseNode* else_block_node = this->nodes_.NewParseNode(
             NodeRule::BLOCK,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
+            this->current_offset());
         node->AddChild(else_block_node);
         return;
     }
@@ -815,10 +1240,9 @@ void Parser::ParseElIfStatement(Node* node) {
     // Check if there is an else if or an else (false) block.
     if (CurrentKeyword(LexerSymbol::IF)) {
         // Create else body block to contain the if statement.
-        Node* else_block_node = new Node(
+        ParseNode* else_block_node = this->nodes_.NewParseNode(
             NodeRule::BLOCK,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
+            this->current_offset());
         node->AddChild(else_block_node);
 
         // Parse the if statement into the else's block.
@@ -832,36 +1256,32 @@ void Parser::ParseElIfStatement(Node* node) {
 }
 
 // Parses a while loop.
-void Parser::ParseWhileStatement(Node* node) {
+void Parser::ParseWhileStatement(ParseNode* node) {
     GS_ASSERT_TRUE(CurrentKeyword(LexerSymbol::WHILE), "Expected WHILE token in for statement parser");
 
     // Create WHILE loop subtree root node.
     // WHILE loop is a syntactic sugar around the FOR loop parse tree.
-    Node* while_node = new Node(
+    ParseNode* while_node = this->nodes_.NewParseNode(
         NodeRule::FOR,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     node->AddChild(while_node);
 
     // Create LOOP_INITIALIZE node.
-    Node* init_node = new Node(
+    ParseNode* init_node = this->nodes_.NewParseNode(
         NodeRule::LOOP_INITIALIZE,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     while_node->AddChild(init_node);
 
     // Create LOOP_CONDITION node.
-    Node* cond_node = new Node(
+    ParseNode* cond_node = this->nodes_.NewParseNode(
         NodeRule::LOOP_CONDITION,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     while_node->AddChild(cond_node);
 
     // Create LOOP_UPDATE node.
-    Node* update_node = new Node(
+    ParseNode* update_node = this->nodes_.NewParseNode(
         NodeRule::LOOP_UPDATE,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     while_node->AddChild(update_node);
 
     AdvanceNext();
@@ -869,8 +1289,8 @@ void Parser::ParseWhileStatement(Node* node) {
     // Check for left parenthesis.
     if (!CurrentSymbol(LexerSymbol::LPAREN)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_WHILE_MISSING_LPAREN);
     }
 
@@ -881,8 +1301,8 @@ void Parser::ParseWhileStatement(Node* node) {
     // Check for right parenthesis.
     if (!CurrentSymbol(LexerSymbol::RPAREN)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_WHILE_MISSING_RPAREN);
     }
 
@@ -895,35 +1315,31 @@ void Parser::ParseWhileStatement(Node* node) {
 }
 
 // Parses for loop.
-void Parser::ParseForStatement(Node* node) {
+void Parser::ParseForStatement(ParseNode* node) {
     GS_ASSERT_TRUE(CurrentKeyword(LexerSymbol::FOR), "Expected FOR token in for statement parser");
 
     // Create FOR loop subtree root node.
-    Node* for_node = new Node(
+    ParseNode* for_node = this->nodes_.NewParseNode(
         NodeRule::FOR,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     node->AddChild(for_node);
 
     // Create LOOP_INITIALIZE node.
-    Node* init_node = new Node(
+    ParseNode* init_node = this->nodes_.NewParseNode(
         NodeRule::LOOP_INITIALIZE,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     for_node->AddChild(init_node);
 
     // Create LOOP_CONDITION node.
-    Node* cond_node = new Node(
+    ParseNode* cond_node = this->nodes_.NewParseNode(
         NodeRule::LOOP_CONDITION,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     for_node->AddChild(cond_node);
 
     // Create LOOP_UPDATE node.
-    Node* update_node = new Node(
+    ParseNode* update_node = this->nodes_.NewParseNode(
         NodeRule::LOOP_UPDATE,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     for_node->AddChild(update_node);
 
     AdvanceNext();
@@ -931,8 +1347,8 @@ void Parser::ParseForStatement(Node* node) {
     // Check for left parenthesis.
     if (!CurrentSymbol(LexerSymbol::LPAREN)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_FOR_MISSING_LPAREN);
     }
 
@@ -962,8 +1378,8 @@ void Parser::ParseForStatement(Node* node) {
     // Check for right parenthesis.
     if (!CurrentSymbol(LexerSymbol::RPAREN)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_FOR_MISSING_RPAREN);
     }
 
@@ -978,15 +1394,14 @@ void Parser::ParseForStatement(Node* node) {
 // Parses a return statement.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseReturnStatement(Node* node) {
+void Parser::ParseReturnStatement(ParseNode* node) {
 
     GS_ASSERT_FALSE(node == NULL, "NULL node in ParseReturnStatement");
     GS_ASSERT_TRUE(CurrentKeyword(LexerSymbol::RETURN), "Expected RETURN in ParseBlockStatement");
 
-    Node* return_node = new Node(
+    ParseNode* return_node = this->nodes_.NewParseNode(
         NodeRule::RETURN,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     node->AddChild(return_node);
 
     // Check for return expression.
@@ -1002,17 +1417,17 @@ void Parser::ParseReturnStatement(Node* node) {
 // a function call or an assignment.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseNameStatement(Node* node) {
+void Parser::ParseNameStatement(ParseNode* node) {
 
     GS_ASSERT_FALSE(node == NULL, "NULL node in ParseNameStatement");
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::NAME ||
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::NAME ||
         CurrentSymbol(LexerSymbol::LPAREN),
         "Expected NAME in ParseNameStatement");
 
     // Call the toplevel assign parser. Parser will fall through into subparsers
     // as necessary until we are left with either a call, an assignment, either by
     // itself or embedded inside of a member (object dereference) expression.
-    Node* statement_node = ParseAssignExpressionA();
+    ParseNode* statement_node = ParseAssignExpression();
     node->AddChild(statement_node);
 
     AdvanceNext();
@@ -1027,18 +1442,18 @@ void Parser::ParseNameStatement(Node* node) {
     }
     
     THROW_EXCEPTION(
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
+        this->current_line_number(),
+        this->current_column_number(),
         STATUS_PARSER_INCOMPLETE_NAME_STATEMENT);
 }
 
 // Parses a function call.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseCallStatement(Node* node) {
+void Parser::ParseCallStatement(ParseNode* node) {
 
     GS_ASSERT_FALSE(node == NULL, "NULL node in ParseCallStatement");
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::NAME,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::NAME,
         "Expected NAME in ParseCallStatement");
     GS_ASSERT_TRUE(NextSymbol(LexerSymbol::LPAREN),
         "Expected LPAREN in ParseCallStatement");
@@ -1051,15 +1466,15 @@ void Parser::ParseCallStatement(Node* node) {
 // Parses a variable assignment statement.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseAssignStatement(Node* node) {
+void Parser::ParseAssignStatement(ParseNode* node) {
 
     GS_ASSERT_FALSE(node == NULL, "NULL node in ParseAssignStatement");
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::NAME,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::NAME,
         "Expected NAME in ParseAssignStatement");
     GS_ASSERT_TRUE(NextSymbol(LexerSymbol::ASSIGN),
         "Expected ASSIGN in ParseAssignStatement");
 
-    node->AddChild(ParseAssignExpressionA());
+    node->AddChild(ParseAssignExpression());
     ParseSemicolon();
     AdvanceNext();
 }
@@ -1067,37 +1482,38 @@ void Parser::ParseAssignStatement(Node* node) {
 // Parses an expression.
 // Throws: Lexer or Parser exceptions from the respective headers if a problem
 // is encountered with lexemes or syntax.
-void Parser::ParseExpression(Node* node) {
+void Parser::ParseExpression(ParseNode* node) {
 
     GS_ASSERT_FALSE(node == NULL, "NULL node in ParseExpression");
 
-    Node* expression_node = new Node(
+    ParseNode* expression_node = this->nodes_.NewParseNode(
         NodeRule::EXPRESSION,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     node->AddChild(expression_node);
 
-    expression_node->AddChild(ParseAssignExpressionA());
+    expression_node->AddChild(ParseAssignExpression());
 }
 
-Node* Parser::ParseAssignExpressionA() {
+// Parses an expression that may be an assignment. Assignment is right
+// associative and has the lowest precedence, so its value is a whole
+// expression.
+ParseNode* Parser::ParseAssignExpression() {
 
-    if (CurrentToken()->type == LexerTokenType::NAME &&
+    if (CurrentToken().type() == LexerTokenType::NAME &&
         NextSymbol(LexerSymbol::ASSIGN)) {
-        return ParseAssignExpressionB(ParseVariableExpression());
+        return ParseAssignOperation(ParseVariableExpression());
     }
     else {
-        return ParseOrExpression(ParseAndExpressionA());
+        return ParseBinaryExpression(kPrecedenceLogOr);
     }
 }
 
-Node* Parser::ParseAssignExpressionB(Node* left_operand_node) {
+// Parses the '<-' and value of an assignment to an already parsed target.
+// left_operand_node: the variable or member being assigned.
+ParseNode* Parser::ParseAssignOperation(ParseNode* left_operand_node) {
 
-    GS_ASSERT_FALSE(left_operand_node == NULL, "NULL node in ParseAssignExpressionB");
-
-    if (CurrentToken()->symbol != LexerSymbol::ASSIGN) {
-        return left_operand_node;
-    }
+    GS_ASSERT_FALSE(left_operand_node == NULL, "NULL node in ParseAssignOperation");
+    GS_ASSERT_TRUE(CurrentSymbol(LexerSymbol::ASSIGN), "Expected ASSIGN in ParseAssignOperation");
 
     // Throw if assigning to a member call or expression like so:
     // this.Foo() <- 3;
@@ -1108,378 +1524,86 @@ Node* Parser::ParseAssignExpressionB(Node* left_operand_node) {
         (left_operand_node->rule() != NodeRule::SYMBOL &&
             left_operand_node->rule() != NodeRule::MEMBER)) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_INCOMPLETE_NAME_STATEMENT);
     }
 
-    Node* operation_node = new Node(
+    ParseNode* operation_node = this->nodes_.NewParseNode(
         NodeRule::ASSIGN,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
-    try {
-        AdvanceNext();
-        operation_node->AddChild(left_operand_node);
-        operation_node->AddChild(ParseAssignExpressionA());
-    }
-    catch (const Exception&) {
-        delete operation_node;
-        throw;
-    }
+        this->current_offset());
+    AdvanceNext();
+    operation_node->AddChild(left_operand_node);
+    operation_node->AddChild(ParseAssignExpression());
 
     return operation_node;
 }
 
-Node* Parser::ParseOrExpression(Node* left_operand_node) {
-
-    GS_ASSERT_FALSE(left_operand_node == NULL,
-        "NULL node in ParseOrExpression");
+// Parses a chain of left associative binary operations by precedence
+// climbing. Operators that bind at least as tightly as min_precedence are
+// folded into the left operand one at a time, and each right operand is
+// parsed with a minimum precedence one tighter than its operator.
+// An assignment found where a member operator could appear assigns to the
+// operand parsed so far (e.g.: 1 + this.x <- 2).
+// min_precedence: the loosest precedence that this call may consume.
+ParseNode* Parser::ParseBinaryExpression(int min_precedence) {
+    ParseNode* left_operand_node = ParseInvertExpression();
 
-    // Return left operand if this isn't an operation.
-    if (CurrentToken()->type != LexerTokenType::SYMBOL) {
-        return left_operand_node;
-    }
-
-    if (CurrentToken()->symbol != LexerSymbol::LOGOR) {
-        return left_operand_node;
-    }
+    while (CurrentToken().type() == LexerTokenType::SYMBOL) {
+        LexerSymbol symbol = CurrentToken().symbol();
 
-    Node* operation_node = new Node(
-        NodeRule::LOGOR,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
-
-    try {
-        AdvanceNext();
-        operation_node->AddChild(left_operand_node);
-        operation_node->AddChild(ParseAndExpressionA());
-    }
-    catch (const Exception&) {
-        delete operation_node;
-        throw;
-    }
-
-    Node* parent_node = NULL;
-    try {
-        parent_node = ParseOrExpression(operation_node);
-    }
-    catch (const Exception&) {
-        delete parent_node;
-        throw;
-    }
-
-    return parent_node;
-}
-
-Node* Parser::ParseAndExpressionA() {
-    return ParseAndExpressionB(ParseComparisonExpressionA());
-}
-
-Node* Parser::ParseAndExpressionB(Node* left_operand_node) {
-
-    GS_ASSERT_FALSE(left_operand_node == NULL,
-        "NULL node in ParseAndExpressionB");
-
-    // Return left operand if this isn't an operation.
-    if (CurrentToken()->type != LexerTokenType::SYMBOL) {
-        return left_operand_node;
-    }
-
-    Node* operation_node = NULL;
-
-    switch (CurrentToken()->symbol) {
-    case LexerSymbol::LOGAND:
-        operation_node = new Node(
-            NodeRule::LOGAND,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    default:
-        // Return left operand if this isn't an operation.
-        return left_operand_node;
-    }
-
-    Node* parent_node = NULL;
-
-    try {
-        AdvanceNext();
-        operation_node->AddChild(left_operand_node);
-        operation_node->AddChild(ParseComparisonExpressionA());
-        parent_node = ParseAndExpressionB(operation_node);
-    }
-    catch (const Exception&) {
-        delete operation_node;
-        throw;
-    }
-
-    return parent_node;
-}
-
-Node* Parser::ParseComparisonExpressionA() {
-    return ParseComparisonExpressionB(ParsePrimaryExpressionA());
-}
-
-Node* Parser::ParseComparisonExpressionB(Node* left_operand_node) {
-
-    GS_ASSERT_FALSE(left_operand_node == NULL,
-        "NULL node in ParseComparisonExpressionB");
-
-    // Return left operand if this isn't an operation.
-    if (CurrentToken()->type != LexerTokenType::SYMBOL) {
-        return left_operand_node;
-    }
-
-    Node* operation_node = NULL;
-
-    switch (CurrentToken()->symbol) {
-    case LexerSymbol::EQUALS:
-        operation_node = new Node(
-            NodeRule::EQUALS,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    case LexerSymbol::NOTEQUALS:
-        operation_node = new Node(
-            NodeRule::NOT_EQUALS,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    case LexerSymbol::LESS:
-        operation_node = new Node(
-            NodeRule::LESS,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    case LexerSymbol::LESSEQUALS:
-        operation_node = new Node(
-            NodeRule::LESS_EQUALS,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    case LexerSymbol::GREATER:
-        operation_node = new Node(
-            NodeRule::GREATER,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    case LexerSymbol::GREATEREQUALS:
-        operation_node = new Node(
-            NodeRule::GREATER_EQUALS,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    default:
-        // Return left operand if this isn't an operation.
-        return left_operand_node;
-    }
-
-    Node* parent_node = NULL;
-
-    try {
-        AdvanceNext();
-        operation_node->AddChild(left_operand_node);
-        operation_node->AddChild(ParsePrimaryExpressionA());
-        parent_node = ParseComparisonExpressionB(operation_node);
-    }
-    catch (const Exception&) {
-        delete operation_node;
-        throw;
-    }
-
-    return parent_node;
-}
-
-Node* Parser::ParsePrimaryExpressionA() {
-    return ParsePrimaryExpressionB(ParseSecondaryExpressionA());
-}
-
-Node* Parser::ParsePrimaryExpressionB(Node* left_operand_node) {
-
-    GS_ASSERT_FALSE(left_operand_node == NULL,
-        "NULL node in ParsePrimaryExpressionB");
-
-    // Return left operand if this isn't an operation.
-    if (CurrentToken()->type != LexerTokenType::SYMBOL) {
-        return left_operand_node;
-    }
-
-    Node* operation_node = NULL;
-
-    switch (CurrentToken()->symbol) {
-    case LexerSymbol::ADD:
-        operation_node = new Node(
-            NodeRule::ADD,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    case LexerSymbol::SUB:
-        operation_node = new Node(
-            NodeRule::SUB,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    default:
-        // Return left operand if this isn't an operation.
-        return left_operand_node;
-    }
-
-    Node* parent_node = NULL;
-
-    try {
-        AdvanceNext();
-        operation_node->AddChild(left_operand_node);
-        operation_node->AddChild(ParseSecondaryExpressionA());
-        parent_node = ParsePrimaryExpressionB(operation_node);
-    }
-    catch (const Exception&) {
-        delete operation_node;
-        throw;
-    }
-
-    return parent_node;
-}
-
-Node* Parser::ParseSecondaryExpressionA() {
-    return ParseSecondaryExpressionB(ParseTertiaryExpressionA());
-}
-
-Node* Parser::ParseSecondaryExpressionB(Node* left_operand_node) {
-
-    GS_ASSERT_FALSE(left_operand_node == NULL,
-        "NULL node in ParseSecondaryExpressionB");
-
-    // Return left operand if this isn't an operation.
-    if (CurrentToken()->type != LexerTokenType::SYMBOL) {
-        return left_operand_node;
-    }
-
-    Node* operation_node = NULL;
-
-    switch (CurrentToken()->symbol) {
-    case LexerSymbol::MUL:
-        operation_node = new Node(
-            NodeRule::MUL,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    case LexerSymbol::DIV:
-        operation_node = new Node(
-            NodeRule::DIV,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    case LexerSymbol::MOD:
-        operation_node = new Node(
-            NodeRule::MOD,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    default:
-        // Return left operand if this isn't an operation.
-        return left_operand_node;
-    }
-
-    Node* parent_node = NULL;
-
-    try {
-        AdvanceNext();
-        operation_node->AddChild(left_operand_node);
-        operation_node->AddChild(ParseTertiaryExpressionA());
-        parent_node = ParseSecondaryExpressionB(operation_node);
-    }
-    catch (const Exception&) {
-        delete operation_node;
-        throw;
-    }
-
-    return parent_node;
-}
-
-Node* Parser::ParseTertiaryExpressionA() {
-    return ParseTertiaryExpressionB(ParseInvertExpression());
-}
-
-Node* Parser::ParseTertiaryExpressionB(Node* left_operand_node) {
-
-    GS_ASSERT_FALSE(left_operand_node == NULL,
-        "NULL node in ParseTertiaryExpressionB");
-
-    // Return left operand if this isn't an operation.
-    if (CurrentToken()->type != LexerTokenType::SYMBOL) {
-        return left_operand_node;
-    }
+        if (symbol == LexerSymbol::ASSIGN) {
+            if (min_precedence > kPrecedenceMember) {
+                break;
+            }
 
-    Node* operation_node = NULL;
+            left_operand_node = ParseAssignOperation(left_operand_node);
+            continue;
+        }
 
-    switch (CurrentToken()->symbol) {
-    case LexerSymbol::DOT:
-        operation_node = new Node(
-            NodeRule::MEMBER,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        break;
-    case LexerSymbol::ASSIGN:
-        return ParseAssignExpressionB(left_operand_node);
-    default:
-        // Return left operand if this isn't an operation.
-        return left_operand_node;
-    }
+        const BinaryOperator& binary_operator = kBinaryOperators[symbol];
+        if (binary_operator.precedence < min_precedence) {
+            break;
+        }
 
-    Node* parent_node = NULL;
+        ParseNode* operation_node = this->nodes_.NewParseNode(
+            binary_operator.rule,
+            this->current_offset());
 
-    try {
         AdvanceNext();
         operation_node->AddChild(left_operand_node);
-        operation_node->AddChild(ParseInvertExpression());
-        parent_node = ParseTertiaryExpressionB(operation_node);
-    }
-    catch (const Exception&) {
-        delete operation_node;
-        throw;
+        operation_node->AddChild(ParseBinaryExpression(binary_operator.precedence + 1));
+        left_operand_node = operation_node;
     }
 
-    // Check to make sure that we aren't assigning to a function call.
-    if (operation_node->rule() == NodeRule::ASSIGN &&
-        (operation_node->child(0)->rule() == NodeRule::CALL ||
-        (operation_node->child(0)->rule() == NodeRule::MEMBER &&
-            operation_node->child(0)->child(1)->rule() != NodeRule::SYMBOL))) {
-        THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
-            STATUS_PARSER_INCOMPLETE_NAME_STATEMENT);;
-    }
-
-    return parent_node;
+    return left_operand_node;
 }
 
-Node* Parser::ParseInvertExpression() {
+ParseNode* Parser::ParseInvertExpression() {
 
-    if (CurrentToken()->type != LexerTokenType::SYMBOL) {
+    if (CurrentToken().type() != LexerTokenType::SYMBOL) {
         return ParseAtomicExpression();
     }
 
-    Node* invert_node = NULL;
+    ParseNode* invert_node = NULL;
 
-    switch (CurrentToken()->symbol) {
+    switch (CurrentToken().symbol()) {
     case LexerSymbol::SUB:
         // Add NEGATE node if there is a '-'.
-        invert_node = new Node(
+        invert_node = this->nodes_.NewParseNode(
             NodeRule::SUB,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
-        invert_node->AddChild(new Node(
+            this->current_offset());
+        invert_node->AddChild(this->nodes_.NewParseNode(
             NodeRule::ANY_TYPE,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_offset(),
             0l));
         break;
 
     case LexerSymbol::LOGNOT:
         // Add NOT node if there is a '!'.
-        invert_node = new Node(
+        invert_node = this->nodes_.NewParseNode(
             NodeRule::LOGNOT,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number());
+            this->current_offset());
         break;
     default:
         return ParseAtomicExpression();
@@ -1488,19 +1612,13 @@ Node* Parser::ParseInvertExpression() {
     // If we got this far without returning it means that we found either a '-' number
     // or '!' boolean, so Advance to the next symbol and recurse into this function again
     // instead of ParseAtomicExpression() in case there is another '-' or '!'.
-    try {
-        AdvanceNext();
-        invert_node->AddChild(ParseInvertExpression());
-    }
-    catch (const Exception&) {
-        delete invert_node;
-        throw;
-    }
+    AdvanceNext();
+    invert_node->AddChild(ParseInvertExpression());
 
     return invert_node;
 }
 
-Node* Parser::ParseAtomicExpression() {
+ParseNode* Parser::ParseAtomicExpression() {
 
     // If no LPAREN, evaluate value of expression.
     if (!CurrentSymbol(LexerSymbol::LPAREN)) {
@@ -1509,14 +1627,13 @@ Node* Parser::ParseAtomicExpression() {
 
     // LPAREN, probably a "(" Expr ")".
     AdvanceNext();
-    Node* node = ParseAssignExpressionA();
+    ParseNode* node = ParseAssignExpression();
 
     // Check for closing parenthesis.
     if (!CurrentSymbol(LexerSymbol::RPAREN)) {
-        delete node;
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_EXPRESSION_MISSING_RPAREN);
     }
 
@@ -1525,12 +1642,12 @@ Node* Parser::ParseAtomicExpression() {
     return node;
 }
 
-Node* Parser::ParseValueExpression() {
-    switch (CurrentToken()->type) {
+ParseNode* Parser::ParseValueExpression() {
+    switch (CurrentToken().type()) {
     case LexerTokenType::NAME:
         return ParseNamedValueExpression();
     case LexerTokenType::KEYWORD:
-        switch (CurrentToken()->symbol)
+        switch (CurrentToken().symbol())
         {
         case LexerSymbol::NEW:
             return ParseNewExpression();
@@ -1549,25 +1666,25 @@ Node* Parser::ParseValueExpression() {
         return ParseStringConstant();
     default:
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_EXPRESSION_INVALID_TOKEN);
     }
 }
 
-Node* Parser::ParseNamedValueExpression() {
+ParseNode* Parser::ParseNamedValueExpression() {
 
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::NAME,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::NAME,
         "Expected NAME in ParseNamedValueExpression");
 
-    if (NextToken()->type != LexerTokenType::SYMBOL) {
+    if (NextToken().type() != LexerTokenType::SYMBOL) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_EXPRESSION_INVALID_TOKEN);
     }
 
-    switch (NextToken()->symbol) {
+    switch (NextToken().symbol()) {
     case LexerSymbol::LPAREN:
         return ParseCallExpression();
     default:
@@ -1576,18 +1693,17 @@ Node* Parser::ParseNamedValueExpression() {
 }
 
 // Parses a type expression of the form GenericType<Param1, Param2, ...>
-void Parser::ParseTypeExpression(Node* parent_node) {
+void Parser::ParseTypeExpression(ParseNode* parent_node) {
 
     // This check is an assert because it is usually done by the caller
     // for a more specific error message.
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::NAME,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::NAME,
         "Parser expected NAME in ParseTypeExpression");
 
-    Node* type_node = new Node(
+    ParseNode* type_node = this->nodes_.NewParseNode(
         NodeRule::TYPE,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
-        CurrentToken()->string_const);
+        this->current_offset(),
+        CurrentToken().atom());
     parent_node->AddChild(type_node);
 
     // Check for open angle brace <
@@ -1597,15 +1713,17 @@ void Parser::ParseTypeExpression(Node* parent_node) {
         AdvanceNext();
         AdvanceNext();
 
-        int line = this->lexer_.current_line_number();
-        int column = this->lexer_.current_column_number();
+        uint32_t offset = this->current_offset();
 
         // Parse a single type argument.
-        std::function<void()> parse_argument_lambda = [this, type_node, line, column]() {
+        std::function<void()> parse_argument_lambda = [this, type_node, offset]() {
 
             // Check first param is of type name.
-            if (CurrentToken()->type != LexerTokenType::NAME) {
-                THROW_EXCEPTION(line, column, STATUS_PARSER_MALFORMED_TYPE_PARAM_MISSING_NAME);
+            if (CurrentToken().type() != LexerTokenType::NAME) {
+                THROW_EXCEPTION(
+                    this->tokens_.lines().line_number(offset),
+                    this->tokens_.lines().column_number(offset),
+                    STATUS_PARSER_MALFORMED_TYPE_PARAM_MISSING_NAME);
             }
 
             // Recursively build tree for type's first param type. Recursion is necessary
@@ -1622,8 +1740,8 @@ void Parser::ParseTypeExpression(Node* parent_node) {
             // Check for comma delimiter.
             if (!CurrentSymbol(LexerSymbol::COMMA)) {
                 THROW_EXCEPTION(
-                    this->lexer_.current_line_number(),
-                    this->lexer_.current_column_number(),
+                    this->current_line_number(),
+                    this->current_column_number(),
                     STATUS_PARSER_MALFORMED_TYPE_PARAM_MISSING_COMMA);
             }
 
@@ -1635,8 +1753,8 @@ void Parser::ParseTypeExpression(Node* parent_node) {
         // Check for close angle brace >
         if (!CurrentSymbol(LexerSymbol::GREATER)) {
             THROW_EXCEPTION(
-                this->lexer_.current_line_number(),
-                this->lexer_.current_column_number(),
+                this->current_line_number(),
+                this->current_column_number(),
                 STATUS_PARSER_MALFORMED_TYPE_PARAM_MISSING_GREATER);
         }
     }
@@ -1644,61 +1762,51 @@ void Parser::ParseTypeExpression(Node* parent_node) {
     AdvanceNext();
 }
 
-Node* Parser::ParseCallExpression() {
+ParseNode* Parser::ParseCallExpression() {
 
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::NAME,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::NAME,
         "Expected NAME in ParseCallExpression");
     GS_ASSERT_TRUE(NextSymbol(LexerSymbol::LPAREN),
         "Expected NAME in ParseCallExpression");
 
-    Node* function_node = new Node(
+    ParseNode* function_node = this->nodes_.NewParseNode(
         NodeRule::CALL,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
-    function_node->AddChild(new Node(
+        this->current_offset());
+    function_node->AddChild(this->nodes_.NewParseNode(
         NodeRule::NAME,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
-        CurrentToken()->string_const));
+        this->current_offset(),
+        CurrentToken().atom()));
 
-    try {
-        AdvanceNext();
-        AdvanceNext();
+    AdvanceNext();
+    AdvanceNext();
 
-        ParseCallParameters(function_node);
+    ParseCallParameters(function_node);
 
-        // Check closing parenthesis.
-        if (!CurrentSymbol(LexerSymbol::RPAREN)) {
-            THROW_EXCEPTION(
-                this->lexer_.current_line_number(),
-                this->lexer_.current_column_number(),
-                STATUS_PARSER_MALFORMED_FUNCTIONCALL_MISSING_RPAREN);
-        }
-        AdvanceNext();
-    }
-    catch (const Exception ex) {
-        delete function_node;
-        throw;
+    // Check closing parenthesis.
+    if (!CurrentSymbol(LexerSymbol::RPAREN)) {
+        THROW_EXCEPTION(
+            this->current_line_number(),
+            this->current_column_number(),
+            STATUS_PARSER_MALFORMED_FUNCTIONCALL_MISSING_RPAREN);
     }
+    AdvanceNext();
 
     return function_node;
 }
 
 // Parses a new SpecName() expression.
-Node* Parser::ParseNewExpression() {
+ParseNode* Parser::ParseNewExpression() {
     GS_ASSERT_TRUE(CurrentKeyword(LexerSymbol::NEW), "Expected NEW in ParseNewExpression");
 
-    Node* new_node = new Node(
+    ParseNode* new_node = this->nodes_.NewParseNode(
         NodeRule::NEW,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
 
     // Check for spec name.
-    if (AdvanceNext()->type != LexerTokenType::NAME) {
-        delete new_node;
+    if (AdvanceNext().type() != LexerTokenType::NAME) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_NEW_EXPRESSION_MISSING_NAME);
     }
 
@@ -1706,10 +1814,9 @@ Node* Parser::ParseNewExpression() {
 
     // Check for open parenthesis.
     if (!CurrentSymbol(LexerSymbol::LPAREN)) {
-        delete new_node;
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_NEW_EXPRESSION_MISSING_LPAREN);
     }
 
@@ -1720,10 +1827,9 @@ Node* Parser::ParseNewExpression() {
 
     // Check for closing parenthesis.
     if (!CurrentSymbol(LexerSymbol::RPAREN)) {
-        delete new_node;
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_NEW_EXPRESSION_MISSING_RPAREN);
     }
 
@@ -1733,26 +1839,24 @@ Node* Parser::ParseNewExpression() {
 }
 
 // Parses a default(symbol) expression.
-Node* Parser::ParseDefaultExpression() {
+ParseNode* Parser::ParseDefaultExpression() {
     GS_ASSERT_TRUE(CurrentKeyword(LexerSymbol::DEFAULT), "Expected DEFAULT in ParseDefaultExpression");
 
-    Node* default_node = new Node(
+    ParseNode* default_node = this->nodes_.NewParseNode(
         NodeRule::DEFAULT,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
 
     if (!AdvanceSymbol(LexerSymbol::LPAREN)) {
-        delete default_node;
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_DEFAULT_EXPRESSION_MISSING_LPAREN);
     }
 
-    if (AdvanceNext()->type != LexerTokenType::NAME) {
+    if (AdvanceNext().type() != LexerTokenType::NAME) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_DEFAULT_EXPRESSION_MISSING_TYPE);
     }
 
@@ -1761,10 +1865,9 @@ Node* Parser::ParseDefaultExpression() {
 
     // Check for closing parenthesis.
    if (!CurrentSymbol(LexerSymbol::RPAREN)) {
-       delete default_node;
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_DEFAULT_EXPRESSION_MISSING_RPAREN);
     }
 
@@ -1774,15 +1877,14 @@ Node* Parser::ParseDefaultExpression() {
 }
 
 
-void Parser::ParseCallParameters(Node* node) {
+void Parser::ParseCallParameters(ParseNode* node) {
 
     // Allow NEW objects as well as CALL object.
     GS_ASSERT_TRUE(node != NULL, "NULL node in ParseCallParameters");
 
-    Node* parameters_node = new Node(
+    ParseNode* parameters_node = this->nodes_.NewParseNode(
         NodeRule::CALL_PARAMETERS,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
+        this->current_offset());
     node->AddChild(parameters_node);
 
     // Keep on parsing till we reach the close parenthesis.
@@ -1794,8 +1896,8 @@ void Parser::ParseCallParameters(Node* node) {
             // Check for comma.
             if (!CurrentSymbol(LexerSymbol::COMMA)) {
                 THROW_EXCEPTION(
-                    this->lexer_.current_line_number(),
-                    this->lexer_.current_column_number(),
+                    this->current_line_number(),
+                    this->current_column_number(),
                     STATUS_PARSER_MALFORMED_FUNCTIONCALL_MISSING_COMMA);
             }
 
@@ -1805,203 +1907,217 @@ void Parser::ParseCallParameters(Node* node) {
     }
 }
 
-Node* Parser::ParseVariableExpression() {
+ParseNode* Parser::ParseVariableExpression() {
 
     // Check for variable name type.
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::NAME,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::NAME,
         "Expected NAME in ParseVariableExpression");
 
-    Node* variable_node = new Node(
+    ParseNode* variable_node = this->nodes_.NewParseNode(
         NodeRule::SYMBOL,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number());
-    variable_node->AddChild(new Node(
+        this->current_offset());
+    variable_node->AddChild(this->nodes_.NewParseNode(
         NodeRule::NAME,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
-        CurrentToken()->string_const));
-    try {
-        AdvanceNext();
-    }
-    catch (const Exception&) {
-        delete variable_node;
-        throw;
-    }
+        this->current_offset(),
+        CurrentToken().atom()));
+    AdvanceNext();
 
     return variable_node;
 }
 
-Node* Parser::ParseBoolConstant() {
+ParseNode* Parser::ParseBoolConstant() {
 
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::KEYWORD,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::KEYWORD,
         "KEYWORD Expected in ParseBoolConstant");
 
-    LexerSymbol true_false_value = CurrentToken()->symbol;
+    LexerSymbol true_false_value = CurrentToken().symbol();
     AdvanceNext();
 
     switch (true_false_value) {
     case LexerSymbol::KTRUE:
-        return new Node(
+        return this->nodes_.NewParseNode(
             NodeRule::BOOL,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(), 
+            this->current_offset(), 
             true);
     case LexerSymbol::KFALSE:
-        return new Node(
+        return this->nodes_.NewParseNode(
             NodeRule::BOOL,
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(), 
+            this->current_offset(), 
             false);
     default:
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_MALFORMED_EXPRESSION_INVALID_TOKEN);
     }
 }
 
-Node* Parser::ParseIntConstant() {
+ParseNode* Parser::ParseIntConstant() {
 
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::INT,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::INT,
         "INT Expected in ParseIntConstant");
 
-    long int_const = CurrentToken()->int_const;
+    long int_const = CurrentToken().int_const();
 
     AdvanceNext();
-    return new Node(
+    return this->nodes_.NewParseNode(
         NodeRule::INT,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(), 
+        this->current_offset(), 
         int_const);
 }
 
-Node* Parser::ParseFloatConstant() {
+ParseNode* Parser::ParseFloatConstant() {
 
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::FLOAT,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::FLOAT,
         "FLOAT Expected in ParseFloatConstant");
 
-    double float_const = CurrentToken()->float_const;
+    double float_const = CurrentToken().float_const();
 
     AdvanceNext();
 
-    return new Node(
+    return this->nodes_.NewParseNode(
         NodeRule::FLOAT, 
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
+        this->current_offset(),
         float_const);
 }
 
-Node* Parser::ParseCharConstant() {
+ParseNode* Parser::ParseCharConstant() {
 
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::CHAR,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::CHAR,
         "CHAR Expected in ParseCharConstant");
 
-    char char_const = CurrentToken()->char_const;
+    char char_const = CurrentToken().char_const();
 
     AdvanceNext();
 
-    return new Node(
+    return this->nodes_.NewParseNode(
         NodeRule::CHAR, 
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
+        this->current_offset(),
         (long)char_const);
 }
 
-Node* Parser::ParseStringConstant() {
+ParseNode* Parser::ParseStringConstant() {
 
-    GS_ASSERT_TRUE(CurrentToken()->type == LexerTokenType::STRING,
+    GS_ASSERT_TRUE(CurrentToken().type() == LexerTokenType::STRING,
         "STRING Expected in ParseStringConstant");
 
-    Node* string_node = new Node(
+    ParseNode* string_node = this->nodes_.NewParseNode(
         NodeRule::STRING,
-        this->lexer_.current_line_number(),
-        this->lexer_.current_column_number(),
-        CurrentToken()->string_const);
+        this->current_offset(),
+        CurrentToken().atom());
 
-    try {
-        AdvanceNext();
+    AdvanceNext();
+
+    return string_node;
+}
+
+// Gets the source offset of the current token, or of the end of the input
+// once the Parser has moved past the last token.
+uint32_t Parser::current_offset() const {
+    if (this->next_index_ == 0) {
+        return this->tokens_.start_offset();
     }
-    catch (const Exception&) {
-        delete string_node;
-        throw;
+
+    return this->tokens_.offset(std::min(this->next_index_ - 1, this->tokens_.size()));
+}
+
+// Gets the line number of the current token for error reporting.
+int Parser::current_line_number() const {
+    return this->tokens_.lines().line_number(this->current_offset());
+}
+
+// Gets the column number of the current token for error reporting.
+int Parser::current_column_number() const {
+    return this->tokens_.lines().column_number(this->current_offset());
+}
+
+// Moves to the next token. If lexing stopped on an error, the error is
+// thrown on reaching the last token lexed before it, just as the Lexer
+// would have thrown when lexing one token ahead.
+TokenRef Parser::AdvanceNext() {
+    if (this->next_index_ <= this->tokens_.size()) {
+        this->next_index_++;
     }
 
-    return string_node;
+    if (this->tokens_.error() != NULL && this->next_index_ >= this->tokens_.size()) {
+        throw *this->tokens_.error();
+    }
+
+    return CurrentToken();
 }
 
-const LexerToken* Parser::AdvanceNext() {
-    const LexerToken* token = this->lexer_.AdvanceNext();
-    ThrowEOFIfNull(token);
-    return token;
+TokenRef Parser::CurrentToken() {
+    return PeekToken(0);
 }
 
-const LexerToken* Parser::CurrentToken() {
-    const LexerToken* token = this->lexer_.current_token();
-    ThrowEOFIfNull(token);
-    return token;
+TokenRef Parser::NextToken() {
+    return PeekToken(1);
 }
 
-const LexerToken* Parser::NextToken() {
-    const LexerToken* token = this->lexer_.next_token();
-    ThrowEOFIfNull(token);
-    return token;
+// Looks at a token ahead of the current one without moving.
+// ahead: the number of tokens to look ahead. 0 is the current token.
+// Throws: a Parser EOF exception if there is no such token.
+TokenRef Parser::PeekToken(size_t ahead) {
+    size_t index = this->next_index_ - 1 + ahead;
+    ThrowEOFIfPastEnd(index);
+    return this->tokens_[index];
 }
 
 bool Parser::AdvanceSymbol(LexerSymbol symbol) {
-    return AdvanceNext()->type == LexerTokenType::SYMBOL &&
-        CurrentToken()->symbol == symbol;
+    return AdvanceNext().type() == LexerTokenType::SYMBOL &&
+        CurrentToken().symbol() == symbol;
 }
 
 bool Parser::CurrentSymbol(LexerSymbol symbol) {
-    return CurrentToken()->type == LexerTokenType::SYMBOL &&
-        CurrentToken()->symbol == symbol;
+    return CurrentToken().type() == LexerTokenType::SYMBOL &&
+        CurrentToken().symbol() == symbol;
 }
 
 bool Parser::NextSymbol(LexerSymbol symbol) {
-    return NextToken()->type == LexerTokenType::SYMBOL &&
-        NextToken()->symbol == symbol;
+    return NextToken().type() == LexerTokenType::SYMBOL &&
+        NextToken().symbol() == symbol;
 }
 
 bool Parser::AdvanceType(LexerSymbol type) {
-    return AdvanceNext()->type == LexerTokenType::NAME &&
-        CurrentToken()->symbol == type;
+    return AdvanceNext().type() == LexerTokenType::NAME &&
+        CurrentToken().symbol() == type;
 }
 
 bool Parser::CurrentType(LexerSymbol type) {
-    return CurrentToken()->type == LexerTokenType::NAME &&
-        CurrentToken()->symbol == type;
+    return CurrentToken().type() == LexerTokenType::NAME &&
+        CurrentToken().symbol() == type;
 }
 
 bool Parser::AdvanceKeyword(LexerSymbol keyword) {
-    return AdvanceNext()->type == LexerTokenType::KEYWORD &&
-        CurrentToken()->symbol == keyword;
+    return AdvanceNext().type() == LexerTokenType::KEYWORD &&
+        CurrentToken().symbol() == keyword;
 }
 
 bool Parser::CurrentKeyword(LexerSymbol keyword) {
-    return CurrentToken()->type == LexerTokenType::KEYWORD &&
-        CurrentToken()->symbol == keyword;
+    return CurrentToken().type() == LexerTokenType::KEYWORD &&
+        CurrentToken().symbol() == keyword;
 }
 
 bool Parser::NextKeyword(LexerSymbol symbol) {
-    return NextToken()->type == LexerTokenType::KEYWORD &&
-        NextToken()->symbol == symbol;
+    return NextToken().type() == LexerTokenType::KEYWORD &&
+        NextToken().symbol() == symbol;
 }
 
 bool Parser::AdvanceAccessModifier(LexerSymbol am) {
-    return AdvanceNext()->type == LexerTokenType::ACCESS_MODIFIER &&
-        CurrentToken()->symbol == am;
+    return AdvanceNext().type() == LexerTokenType::ACCESS_MODIFIER &&
+        CurrentToken().symbol() == am;
 }
 
 bool Parser::CurrentAccessModifier(LexerSymbol am) {
-    return CurrentToken()->type == LexerTokenType::ACCESS_MODIFIER &&
-        CurrentToken()->symbol == am;
+    return CurrentToken().type() == LexerTokenType::ACCESS_MODIFIER &&
+        CurrentToken().symbol() == am;
 }
 
-void Parser::ThrowEOFIfNull(const LexerToken* token) {
-    if (token == NULL) {
+void Parser::ThrowEOFIfPastEnd(size_t index) {
+    if (index >= this->tokens_.size()) {
         THROW_EXCEPTION(
-            this->lexer_.current_line_number(),
-            this->lexer_.current_column_number(),
+            this->current_line_number(),
+            this->current_column_number(),
             STATUS_PARSER_EOF);
     }
 }
@@ -4,10 +4,17 @@
 #ifndef GUNDERSCRIPT_PARSER__H__
 #define GUNDERSCRIPT_PARSER__H__
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "gunderscript/exceptions.h"
 #include "gunderscript/node.h"
 
 #include "lexer.h"
+#include "node_arena.h"
+#include "token_array.h"
 
 // Debug assertion checks that we have the correct node rule.
 // Not compiled in Release configuration.
@@ -19,19 +26,76 @@
 namespace gunderscript {
 namespace compiler {
 
+// A function whose body was skipped by matching braces. block_node is an
+// empty placeholder BLOCK. begin_index and end_index are the indices of the
+// body's opening and matching closing brace, plus one, which is where the
+// Parser's next token index is before and after parsing the body.
+typedef struct {
+    ParseNode* function_node;
+    ParseNode* block_node;
+    size_t begin_index;
+    size_t end_index;
+} LazyFunctionBody;
+
+// A module level function or spec whose bodies were skipped by
+// ParseDeclarations(): the run of body_count LazyFunctionBodies starting
+// at first_body.
+typedef struct {
+    ParseNode* impl_node;
+    size_t first_body;
+    size_t body_count;
+} LazyImplementation;
+
 // Accepts a Lexer and converts a stream of lexemes into an abstract syntax tree
-// that is ready to be analyzed.
+// that is ready to be analyzed. The input is lexed up front into a TokenArray
+// that the Parser indexes into, so it can look any number of tokens ahead.
+// Nodes are allocated from a NodeArena. Unless one is given, the Parser owns
+// its arena and the tree is freed along with the Parser.
+// ParseReachable() skips the bodies of module level functions by matching
+// braces and only parses the ones that can be reached from an entry point,
+// leaving the rest with empty BLOCKs whose bool_value() is true.
+// ParseParallel() skips every function body the same way and then parses
+// them all at once on a pool of threads. ParseDeclarations() skips them too
+// and leaves them for ParseImplementation() to parse one function or spec
+// at a time, each into an arena that can be freed as soon as it is compiled.
 class Parser {
 public:
-    Parser(Lexer& lexer) : lexer_(lexer) { }
+    Parser(Lexer& lexer)
+        : owned_tokens_(new TokenArray(lexer)),
+        tokens_(*owned_tokens_),
+        owned_nodes_(new NodeArena()),
+        nodes_(*owned_nodes_) { }
+    Parser(Lexer& lexer, NodeArena& nodes)
+        : owned_tokens_(new TokenArray(lexer)), tokens_(*owned_tokens_), nodes_(nodes) { }
+    Parser(const TokenArray& tokens)
+        : tokens_(tokens), owned_nodes_(new NodeArena()), nodes_(*owned_nodes_) { }
+    Parser(const TokenArray& tokens, NodeArena& nodes) : tokens_(tokens), nodes_(nodes) { }
     Node* Parse();
+    Node* ParseReachable(const std::string& entry_point);
+    Node* ParseParallel(unsigned int thread_count);
+    Node* ParseDeclarations();
+    Node* ParseImplementation(const Node* impl_node, NodeArena& nodes);
 
 private:
-    Lexer& lexer_;
-    Node* module_node_;
-    const LexerToken* AdvanceNext();
-    const LexerToken* CurrentToken();
-    const LexerToken* NextToken();
+    std::unique_ptr<TokenArray> owned_tokens_;
+    const TokenArray& tokens_;
+    std::unique_ptr<NodeArena> owned_nodes_;
+    NodeArena& nodes_;
+    size_t next_index_ = 0;
+    ParseNode* module_node_;
+    bool skip_bodies_ = false;
+    bool skip_spec_bodies_ = false;
+    std::vector<LazyFunctionBody> lazy_bodies_;
+
+    // LazyImplementations by the offset of their FUNCTION or SPEC node.
+    std::unordered_map<uint32_t, LazyImplementation> lazy_impls_;
+    uint32_t current_offset() const;
+    int current_line_number() const;
+    int current_column_number() const;
+    TokenRef AdvanceNext();
+    TokenRef CurrentToken();
+    TokenRef NextToken();
+    TokenRef PeekToken(size_t ahead);
     bool AdvanceSymbol(LexerSymbol symbol);
     bool CurrentSymbol(LexerSymbol symbol);
     bool NextSymbol(LexerSymbol symbol);
@@ -42,63 +106,62 @@ private:
     bool NextKeyword(LexerSymbol keyword);
     bool AdvanceAccessModifier(LexerSymbol am);
     bool CurrentAccessModifier(LexerSymbol am);
-    void ThrowEOFIfNull(const LexerToken* token);
-    bool has_next() { return lexer_.has_next(); }
+    void ThrowEOFIfPastEnd(size_t index);
+    bool has_next() { return this->next_index_ < this->tokens_.size(); }
 
-    Node* ParseModule();
-    void ParsePackageDeclaration(Node* node);
-    void ParseDependsStatements(Node* node);
-    void ParseDependsStatement(Node* node);
+    ParseNode* ParseModule();
+    void ParsePackageDeclaration(ParseNode* node);
+    void ParseDependsStatements(ParseNode* node);
+    void ParseDependsStatement(ParseNode* node);
     void ParseSemicolon();
-    void ParseModuleBody(Node* module_node);
-    void ParseSpecDefinition(Node* specs_node);
-    void ParseSpecBody(Node* spec_node);
-    void ParseProperty(Node* node);
-    void ParsePropertyBody(Node* property_body);
-    void ParsePropertyBodyFunction(Node* getter_node, Node* setter_node);
-    void ParseFunction(Node* node, bool in_spec);
-    void ParseFunctionParameters(Node* function_node);
-    void ParseFunctionParameter(Node* node);
-    void ParseBlockStatement(Node* node);
-    void ParseStatement(Node* node);
-    void ParseKeywordStatement(Node* node);
-    void ParseIfStatement(Node* node);
-    void ParseElIfStatement(Node* node);
-    void ParseWhileStatement(Node* node);
-    void ParseForStatement(Node* node);
-    void ParseReturnStatement(Node* node);
-    void ParseNameStatement(Node* node);
-    void ParseCallStatement(Node* node);
-    void ParseAssignStatement(Node* node);
-    void ParseExpression(Node* node);
-    Node* ParseAssignExpressionA();
-    Node* ParseAssignExpressionB(Node* left_operand_node);
-    Node* ParseOrExpression(Node* left_operand_node);
-    Node* ParseAndExpressionA();
-    Node* ParseAndExpressionB(Node* left_operand_node);
-    Node* ParseComparisonExpressionA();
-    Node* ParseComparisonExpressionB(Node* left_operand_node);
-    Node* ParsePrimaryExpressionA();
-    Node* ParsePrimaryExpressionB(Node* left_operand_node);
-    Node* ParseSecondaryExpressionA();
-    Node* ParseSecondaryExpressionB(Node* left_operand_node);
-    Node* ParseTertiaryExpressionA();
-    Node* ParseTertiaryExpressionB(Node* left_operand_node);
-    Node* ParseInvertExpression();
-    Node* ParseAtomicExpression();
-    Node* ParseValueExpression();
-    Node* ParseNamedValueExpression();
-    Node* ParseCallExpression();
-    Node* ParseNewExpression();
-    Node* ParseDefaultExpression();
-    void ParseTypeExpression(Node* parent_node);
-    void ParseCallParameters(Node* node);
-    Node* ParseVariableExpression();
-    Node* ParseBoolConstant();
-    Node* ParseIntConstant();
-    Node* ParseFloatConstant();
-    Node* ParseCharConstant();
-    Node* ParseStringConstant();
+    void ParseModuleBody(ParseNode* module_node);
+    void ParseSpecDefinition(ParseNode* specs_node);
+    void ParseSpecBody(ParseNode* spec_node);
+    void ParseProperty(ParseNode* node);
+    void ParsePropertyBody(ParseNode* property_body);
+    void ParsePropertyBodyFunction(ParseNode* getter_node, ParseNode* setter_node);
+    void ParseFunction(ParseNode* node, bool in_spec);
+    void ParseFunctionParameters(ParseNode* function_node);
+    void ParseFunctionParameter(ParseNode* node);
+    void ParseBlockStatement(ParseNode* node);
+    void ParseBlockStatements(ParseNode* block_node);
+    void SkipBlockStatement(ParseNode* function_node);
+    ParseNode* ParseReachableBodies(ParseNode* module_node, Atom entry_point);
+    ParseNode* ParseSkippedBody(size_t begin_index);
+    ParseNode* SpliceBodies(
+        const ParseNode* node,
+        const std::unordered_map<const ParseNode*, ParseNode*>& bodies);
+    Node* Reparse();
+    Node* FlattenParseTree(const ParseNode& root);
+    void ParseStatement(ParseNode* node);
+    void ParseKeywordStatement(ParseNode* node);
+    void ParseIfStatement(ParseNode* node);
+    void ParseElIfStatement(ParseNode* node);
+    void ParseWhileStatement(ParseNode* node);
+    void ParseForStatement(ParseNode* node);
+    void ParseReturnStatement(ParseNode* node);
+    void ParseNameStatement(ParseNode* node);
+    void ParseCallStatement(ParseNode* node);
+    void ParseAssignStatement(ParseNode* node);
+    void ParseExpression(ParseNode* node);
+    ParseNode* ParseAssignExpression();
+    ParseNode* ParseAssignOperation(ParseNode* left_operand_node);
+    ParseNode* ParseBinaryExpression(int min_precedence);
+    ParseNode* ParseInvertExpression();
+    ParseNode* ParseAtomicExpression();
+    ParseNode* ParseValueExpression();
+    ParseNode* ParseNamedValueExpression();
+    ParseNode* ParseCallExpression();
+    ParseNode* ParseNewExpression();
+    ParseNode* ParseDefaultExpression();
+    void ParseTypeExpression(ParseNode* parent_node);
+    void ParseCallParameters(ParseNode* node);
+    ParseNode* ParseVariableExpression();
+    ParseNode* ParseBoolConstant();
+    ParseNode* ParseIntConstant();
+    ParseNode* ParseFloatConstant();
+    ParseNode* ParseCharConstant();
+    ParseNode* ParseStringConstant();
 };
 
 // Constructor mangled function name.
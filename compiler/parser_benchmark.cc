@@ -0,0 +1,152 @@
+// Gunderscript 2 Parser Benchmark
+// (C) 2016 Christian Gunderman
+
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "benchmark_macros.h"
+
+#include "gunderscript/compiler_source.h"
+#include "gunderscript/node.h"
+
+#include "lexer.h"
+#include "node_arena.h"
+#include "parser.h"
+#include "token_array.h"
+
+using namespace gunderscript;
+using gunderscript::compiler::Lexer;
+using gunderscript::compiler::NodeArena;
+using gunderscript::compiler::Parser;
+using gunderscript::compiler::TokenArray;
+
+// Number of functions in the generated expression script.
+static const int kBenchmarkFunctionCount = 5000;
+
+// Number of timed iterations for each benchmark.
+static const int kBenchmarkIterations = 3;
+
+// Generates a script whose functions are mostly long arithmetic, comparison,
+// and logical expressions that mix every binary precedence level.
+static std::string GenerateExpressionScript(int function_count) {
+    std::ostringstream buffer;
+
+    buffer << "package \"Benchmark\";\n";
+    for (int i = 0; i < function_count; i++) {
+        buffer << "public bool function" << i << "(int32 a, int32 b, float32 c) {\n"
+            << "    x <- a * " << i << " + b / 3 - (a % 7) * (b + 1) - a * b * 2;\n"
+            << "    y <- c * 2.5 + c / 0.5 - (c - 1.0) * (c + 1.0) / 4.0;\n"
+            << "    return x + 1 >= a - b && !(x * 2 < b + " << i << ") || y / 2.0 = c"
+            << " && a != b || a + b * x - 4 <= a * b - x + 2 && x > 0;\n"
+            << "}\n";
+    }
+
+    return buffer.str();
+}
+
+// Counts the nodes in a tree.
+static int CountNodes(const Node* node) {
+    int count = 1;
+
+    for (size_t i = 0; i < node->child_count(); i++) {
+        count += CountNodes(node->child(i));
+    }
+
+    return count;
+}
+
+// Lexes and parses an expression heavy script, then parses the same script
+// again from pre-lexed tokens so that the cost of the expression parser can
+// be seen on its own.
+TEST(ParserBenchmark, ExpressionHeavyScript) {
+    std::string input = GenerateExpressionScript(kBenchmarkFunctionCount);
+
+    int lexed_nodes = 0;
+    BENCHMARK_RUN("Lex and parse expressions", kBenchmarkIterations,
+        CompilerStringSource source(input);
+        Lexer lexer(source);
+        NodeArena nodes;
+        Parser parser(lexer, nodes);
+        lexed_nodes = CountNodes(parser.Parse()));
+
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    TokenArray tokens(lexer);
+
+    int parsed_nodes = 0;
+    BENCHMARK_RUN("Parse pre-lexed expressions", kBenchmarkIterations,
+        NodeArena nodes;
+        Parser parser(tokens, nodes);
+        parsed_nodes = CountNodes(parser.Parse()));
+
+    ASSERT_EQ(lexed_nodes, parsed_nodes);
+}
+
+// Counts the module level functions whose bodies were parsed.
+static int CountParsedBodies(const Node* root) {
+    const Node* functions_node = root->child(3);
+    int parsed_bodies = 0;
+
+    for (size_t i = 0; i < functions_node->child_count(); i++) {
+        if (functions_node->child(i)->child(4)->child_count() > 0) {
+            parsed_bodies++;
+        }
+    }
+
+    return parsed_bodies;
+}
+
+// Compares parsing every function in a large library against parsing only
+// the few that are reachable from main, as when a script only uses a small
+// part of a big bundle.
+TEST(ParserBenchmark, LazyFunctionBodies) {
+    std::string input = GenerateExpressionScript(kBenchmarkFunctionCount)
+        + "public bool main() { return function1(1, 2, 3.0) && function2(4, 5, 6.0); }";
+
+    int eager_functions = 0;
+    double eager_us = BENCHMARK_RUN("Parse all functions", kBenchmarkIterations,
+        CompilerStringSource source(input);
+        Lexer lexer(source);
+        NodeArena nodes;
+        Parser parser(lexer, nodes);
+        eager_functions = (int)parser.Parse()->child(3)->child_count());
+
+    int lazy_functions = 0;
+    double lazy_us = BENCHMARK_RUN("Parse reachable functions", kBenchmarkIterations,
+        CompilerStringSource source(input);
+        Lexer lexer(source);
+        NodeArena nodes;
+        Parser parser(lexer, nodes);
+        lazy_functions = CountParsedBodies(parser.ParseReachable("main")));
+
+    BENCHMARK_REPORT_SPEEDUP(eager_us, lazy_us);
+
+    ASSERT_EQ(kBenchmarkFunctionCount + 1, eager_functions);
+    ASSERT_EQ(3, lazy_functions);
+}
+
+// Compares parsing function bodies serially against parsing them on one
+// thread per hardware thread.
+TEST(ParserBenchmark, ParallelFunctionBodies) {
+    std::string input = GenerateExpressionScript(kBenchmarkFunctionCount);
+
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    TokenArray tokens(lexer);
+
+    int serial_nodes = 0;
+    double serial_us = BENCHMARK_RUN("Parse bodies serially", kBenchmarkIterations,
+        NodeArena nodes;
+        Parser parser(tokens, nodes);
+        serial_nodes = CountNodes(parser.Parse()));
+
+    int parallel_nodes = 0;
+    double parallel_us = BENCHMARK_RUN("Parse bodies in parallel", kBenchmarkIterations,
+        NodeArena nodes;
+        Parser parser(tokens, nodes);
+        parallel_nodes = CountNodes(parser.ParseParallel(0)));
+
+    BENCHMARK_REPORT_SPEEDUP(serial_us, parallel_us);
+
+    ASSERT_EQ(serial_nodes, parallel_nodes);
+}
@@ -43,8 +43,6 @@ TEST(Parser, PackageOnly) {
     Node* specs_node = root->child(2);
     EXPECT_EQ(NodeRule::SPECS, specs_node->rule());
     EXPECT_EQ(0, specs_node->child_count());
-
-    delete root;
 }
 
 TEST(Parser, MalformedPackage) {
@@ -154,8 +152,6 @@ TEST(Parser, PackageDependsOnly) {
     EXPECT_EQ(NodeRule::NAME, dependency_node_1->rule());
     EXPECT_EQ(0, dependency_node_1->child_count());
     EXPECT_STREQ("Foo3", dependency_node_1->string_value()->c_str());
-
-    delete root;
 }
 
 // In response to Github issue #64 to prevent regression.
@@ -299,8 +295,6 @@ TEST(Parser, EmptySpec) {
     Node* spec_node_1_properties = spec_node_1->child(3);
     EXPECT_EQ(NodeRule::PROPERTIES, spec_node_1_properties->rule());
     EXPECT_EQ(0, spec_node_1_properties->child_count());
-
-    delete root;
 }
 
 TEST(Parser, ParseMalformedProperty) {
@@ -487,8 +481,6 @@ TEST(Parser, ParsePropertyAuto) {
         Node* x_setter_access_modifier_node = x_setter_node->child(0);
         EXPECT_EQ(NodeRule::ACCESS_MODIFIER, x_setter_access_modifier_node->rule());
         EXPECT_EQ(LexerSymbol::CONCEALED, x_setter_access_modifier_node->symbol_value());
-
-        delete root;
     }
 
     // Case 2: get second, set first.
@@ -517,8 +509,6 @@ TEST(Parser, ParsePropertyAuto) {
         Node* x_setter_access_modifier_node = x_setter_node->child(0);
         EXPECT_EQ(NodeRule::ACCESS_MODIFIER, x_setter_access_modifier_node->rule());
         EXPECT_EQ(LexerSymbol::CONCEALED, x_setter_access_modifier_node->symbol_value());
-
-        delete root;
     }
 }
 
@@ -579,8 +569,6 @@ TEST(Parser, ParsePropertyWithFunctionBody) {
     Node* value_node = expression_node->child(0);
     EXPECT_EQ(NodeRule::INT, value_node->rule());
     ASSERT_EQ(3, value_node->int_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseFunctionEmpty) {
@@ -621,8 +609,6 @@ TEST(Parser, ParseFunctionEmpty) {
 
     Node* foo_block_node = foo_node->child(4);
     EXPECT_EQ(0, foo_block_node->child_count());
-
-    delete root;
 }
 
 TEST(Parser, ParseConstructorEmpty) {
@@ -663,8 +649,6 @@ TEST(Parser, ParseConstructorEmpty) {
 
     Node* foo_block_node = foo_node->child(4);
     EXPECT_EQ(0, foo_block_node->child_count());
-
-    delete root;
 }
 
 TEST(Parser, ParseMultipleFunctions) {
@@ -685,7 +669,7 @@ TEST(Parser, ParseMultipleFunctions) {
     Parser parser(lexer);
 
     Node* root = parser.Parse();
-    delete root;
+    EXPECT_EQ(NodeRule::MODULE, root->rule());
 }
 
 TEST(Parser, ParseMalformedFunctions) {
@@ -840,8 +824,6 @@ TEST(Parser, ParseEmptyReturn) {
     Node* foo_return_node = foo_block_node->child(0);
     EXPECT_EQ(NodeRule::RETURN, foo_return_node->rule());
     EXPECT_EQ(0, foo_return_node->child_count());
-
-    delete root;
 }
 
 
@@ -879,8 +861,6 @@ TEST(Parser, ParseReturnWithExpression) {
     EXPECT_EQ(NodeRule::INT, foo_int_node->rule());
     EXPECT_EQ(0, foo_int_node->child_count());
     EXPECT_EQ(15, foo_int_node->int_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseMalformedReturn) {
@@ -1002,8 +982,6 @@ TEST(Parser, ParseArithmeticExpression) {
     Node* foo_denominator_node = foo_expression_root_node->child(1);
     EXPECT_EQ(NodeRule::CHAR, foo_denominator_node->rule());
     EXPECT_EQ('c', foo_denominator_node->int_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseDoubleNegative) {
@@ -1058,8 +1036,6 @@ TEST(Parser, ParseDoubleNegative) {
     EXPECT_EQ(NodeRule::INT, right_sub_child_node->rule());
     EXPECT_EQ(0, right_sub_child_node->child_count());
     EXPECT_EQ(3, right_sub_child_node->int_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseDoubleNot) {
@@ -1104,8 +1080,6 @@ TEST(Parser, ParseDoubleNot) {
     EXPECT_EQ(NodeRule::BOOL, bool_node->rule());
     EXPECT_EQ(0, bool_node->child_count());
     EXPECT_EQ(true, bool_node->bool_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseDoubleNegativeNoParens) {
@@ -1167,8 +1141,6 @@ TEST(Parser, ParseDoubleNegativeNoParens) {
     EXPECT_EQ(NodeRule::INT, right_sub_child_node->rule());
     EXPECT_EQ(0, right_sub_child_node->child_count());
     EXPECT_EQ(3, right_sub_child_node->int_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseDoubleNotNoParens) {
@@ -1220,8 +1192,6 @@ TEST(Parser, ParseDoubleNotNoParens) {
     EXPECT_EQ(NodeRule::BOOL, bool_node->rule());
     EXPECT_EQ(0, bool_node->child_count());
     EXPECT_EQ(true, bool_node->bool_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseMalformedArithmeticExpression) {
@@ -1412,8 +1382,6 @@ TEST(Parser, ParseBooleanExpression) {
     Node* foo_expression_right_child_right_node = foo_expression_right_child_node->child(1);
     EXPECT_EQ(NodeRule::BOOL, foo_expression_right_child_right_node->rule());
     ASSERT_FALSE(foo_expression_right_child_right_node->bool_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseStringExpression) {
@@ -1465,8 +1433,6 @@ TEST(Parser, ParseStringExpression) {
     Node* foo_expression_right_node = foo_expression_root_node->child(1);
     EXPECT_EQ(NodeRule::STRING, foo_expression_right_node->rule());
     EXPECT_STREQ("Improved", foo_expression_right_node->string_value()->c_str());
-
-    delete root;
 }
 
 TEST(Parser, ParseVariableExpression) {
@@ -1514,8 +1480,6 @@ TEST(Parser, ParseVariableExpression) {
     Node* foo_expression_x_node = foo_expression_right_node->child(0);
     EXPECT_EQ(NodeRule::NAME, foo_expression_x_node->rule());
     EXPECT_STREQ("x", foo_expression_x_node->string_value()->c_str());
-
-    delete root;
 }
 
 TEST(Parser, ParseFunctionExpressionWithoutArgs) {
@@ -1567,8 +1531,6 @@ TEST(Parser, ParseFunctionExpressionWithoutArgs) {
     Node* foo_expression_call_parameters_node = foo_expression_call_node->child(1);
     EXPECT_EQ(NodeRule::CALL_PARAMETERS, foo_expression_call_parameters_node->rule());
     EXPECT_EQ(0, foo_expression_call_parameters_node->child_count());
-
-    delete root;
 }
 
 TEST(Parser, ParseFunctionExpressionWithArgs) {
@@ -1652,8 +1614,6 @@ TEST(Parser, ParseFunctionExpressionWithArgs) {
     Node* foo_expression_right_node = foo_expression_root_node->child(1);
     EXPECT_EQ(NodeRule::FLOAT, foo_expression_right_node->rule());
     EXPECT_EQ(2.5, foo_expression_right_node->float_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseMemberExpression) {
@@ -1750,8 +1710,6 @@ TEST(Parser, ParseMemberExpression) {
     Node* foo_expression_fooprintname_node = foo_expression_fooprint_node->child(0);
     EXPECT_EQ(NodeRule::NAME, foo_expression_fooprintname_node->rule());
     ASSERT_STREQ("print", foo_expression_fooprintname_node->string_value()->c_str());
-
-    delete root;
 }
 
 // Ensures that member expressions don't throw when used as a statement.
@@ -1911,7 +1869,7 @@ TEST(Parser, ParseExpressionMemberExpression) {
     Lexer lexer(source);
     Parser parser(lexer);
 
-    delete parser.Parse();
+    parser.Parse();
 }
 
 TEST(Parser, ParseAssignStatement) {
@@ -1966,8 +1924,6 @@ TEST(Parser, ParseAssignStatement) {
     Node* assign_add_right_node = assign_equals_right_node->child(1);
     EXPECT_EQ(NodeRule::INT, assign_add_right_node->rule());
     ASSERT_EQ(5, assign_add_right_node->int_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseCallStatement) {
@@ -2011,8 +1967,6 @@ TEST(Parser, ParseCallStatement) {
     Node* expression_string_node = parameter1_expression_node->child(0);
     EXPECT_EQ(NodeRule::STRING, expression_string_node->rule());
     ASSERT_STREQ("Hello", expression_string_node->string_value()->c_str());
-
-    delete root;
 }
 
 TEST(Parser, ParseComparisonExpression) {
@@ -2103,8 +2057,6 @@ TEST(Parser, ParseComparisonExpression) {
     Node* lte_right_node = lte_node->child(1);
     EXPECT_EQ(NodeRule::INT, lte_right_node->rule());
     ASSERT_EQ(4, lte_right_node->int_value());
-
-    delete root;
 }
 
 TEST(Parser, ParseMalformedComparisonExpression) {
@@ -2271,8 +2223,6 @@ TEST(Parser, ParseModule) {
     EXPECT_STREQ("main", functions_node->child(0)->child(2)->string_value()->c_str());
     EXPECT_STREQ("main2", functions_node->child(1)->child(2)->string_value()->c_str());
     EXPECT_STREQ("main3", functions_node->child(2)->child(2)->string_value()->c_str());
-
-    delete root;
 }
 
 // Addresses issue #105
@@ -2730,8 +2680,6 @@ TEST(Parser, CorrectForStatementTreeNoParams) {
     Node* for_node_block = for_node->child(3);
     EXPECT_EQ(NodeRule::BLOCK, for_node_block->rule());
     EXPECT_EQ(0, for_node_block->child_count());
-
-    delete root;
 }
 
 TEST(Parser, CorrectForStatementTreeAllParams) {
@@ -2780,8 +2728,6 @@ TEST(Parser, CorrectForStatementTreeAllParams) {
     Node* for_node_block = for_node->child(3);
     EXPECT_EQ(NodeRule::BLOCK, for_node_block->rule());
     EXPECT_EQ(0, for_node_block->child_count());
-
-    delete root;
 }
 
 TEST(Parser, ParseMalformedWhileStatement) {
@@ -2852,8 +2798,6 @@ TEST(Parser, CorrectWhileTree) {
     Node* for_node_block = for_node->child(3);
     EXPECT_EQ(NodeRule::BLOCK, for_node_block->rule());
     EXPECT_EQ(0, for_node_block->child_count());
-
-    delete root;
 }
 
 TEST(Parser, ParseMalformedTypeExpression) {
@@ -3087,8 +3031,6 @@ TEST(Parser, CorrectTypeExpressionTree) {
     EXPECT_STREQ("int32", right_type_param->string_value()->c_str());
     EXPECT_EQ(NodeRule::TYPE, right_type_param->rule());
     EXPECT_EQ(0, right_type_param->child_count());
-
-    delete root;
 }
 
 TEST(Parser, ParseMalformedNewExpression) {
@@ -3304,11 +3246,7 @@ TEST(Parser, CorrectDefaultExpressionTree) {
     Lexer lexer(source);
     Parser parser(lexer);
 
-    Node* node = parser.Parse();
-
-
-
-    delete node;
+    parser.Parse();
 }
 
 // Check for no throw.
@@ -3322,9 +3260,291 @@ TEST(Parser, AssignProperty) {
     Lexer lexer(source);
     Parser parser(lexer);
 
-    Node* node = parser.Parse();
+    parser.Parse();
+}
+
+// Checks that a tree parsed into a caller's NodeArena outlives the Parser
+// and that nodes with more children than fit in the first children array
+// keep all of them in order.
+TEST(Parser, NodesAllocatedFromArena) {
+    std::string input("package \"FooPackage\";"
+        "public int32 main() {"
+        "    foo(1, 2, 3, 4, 5, 6, 7, 8, 9, 10);"
+        "}");
+
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    NodeArena nodes;
+    Node* root = NULL;
+
+    {
+        Parser parser(lexer, nodes);
+        root = parser.Parse();
+    }
+
+    EXPECT_LT(0, nodes.bytes_allocated());
+
+    Node* call_node = root->child(3)->child(0)->child(4)->child(0);
+    ASSERT_EQ(NodeRule::CALL, call_node->rule());
+
+    Node* parameters_node = call_node->child(1);
+    ASSERT_EQ(NodeRule::CALL_PARAMETERS, parameters_node->rule());
+    ASSERT_EQ(10, parameters_node->child_count());
+
+    for (size_t i = 0; i < parameters_node->child_count(); i++) {
+        Node* parameter_node = parameters_node->child(i)->child(0);
+        EXPECT_EQ(NodeRule::INT, parameter_node->rule());
+        EXPECT_EQ((long)i + 1, parameter_node->int_value());
+    }
+}
+
+// Checks that two trees have the same shape, rules, offsets, and values.
+static void ExpectSameTree(Node* expected, Node* actual) {
+    ASSERT_EQ(expected->rule(), actual->rule());
+    EXPECT_EQ(expected->offset(), actual->offset());
+    EXPECT_EQ(expected->int_value(), actual->int_value());
+    ASSERT_EQ(expected->atom().valid(), actual->atom().valid());
+
+    if (expected->atom().valid()) {
+        EXPECT_EQ(expected->atom().str(), actual->atom().str());
+    }
+
+    ASSERT_EQ(expected->child_count(), actual->child_count());
+
+    for (size_t i = 0; i < expected->child_count(); i++) {
+        ExpectSameTree(expected->child(i), actual->child(i));
+    }
+}
+
+TEST(Parser, ParseReachableSkipsUncalledFunctions) {
+    std::string input("package \"FooPackage\";"
+        "public int32 unused() { this is not { valid } code; }"
+        "public int32 main() { return foo(1); }"
+        "concealed int32 bar() { return 2; }"
+        "public int32 foo(int32 a) { return bar() + a; }"
+        "public int32 foo(float32 a) { return 3; }");
+
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    Parser parser(lexer);
+
+    Node* root = parser.ParseReachable("main");
+    Node* functions_node = root->child(3);
+    ASSERT_EQ(NodeRule::FUNCTIONS, functions_node->rule());
+    ASSERT_EQ(5, functions_node->child_count());
+
+    // Every function keeps its declaration and its place, but only the bodies
+    // of reachable functions, including every overload of a called name, are
+    // parsed.
+    const char* names[] = { "unused", "main", "bar", "foo", "foo" };
+    for (size_t i = 0; i < functions_node->child_count(); i++) {
+        EXPECT_STREQ(names[i], functions_node->child(i)->child(2)->string_value()->c_str());
+
+        Node* block_node = functions_node->child(i)->child(4);
+        ASSERT_EQ(NodeRule::BLOCK, block_node->rule());
+        EXPECT_EQ(i == 0 ? 0 : 1, block_node->child_count());
+    }
+}
+
+TEST(Parser, ParseReachableFromSpecs) {
+    std::string input("package \"FooPackage\";"
+        "public spec Foo {"
+        "    public int32 Bar() { return baz(); }"
+        "}"
+        "public int32 baz() { return 1; }"
+        "public int32 unused() { return 2; }");
+
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    Parser parser(lexer);
+
+    Node* root = parser.ParseReachable("main");
+    Node* functions_node = root->child(3);
+    ASSERT_EQ(2, functions_node->child_count());
+    EXPECT_STREQ("baz", functions_node->child(0)->child(2)->string_value()->c_str());
+    EXPECT_EQ(1, functions_node->child(0)->child(4)->child_count());
+    EXPECT_STREQ("unused", functions_node->child(1)->child(2)->string_value()->c_str());
+    EXPECT_EQ(0, functions_node->child(1)->child(4)->child_count());
+}
+
+TEST(Parser, ParseReachableMatchesParse) {
+    std::string input("package \"FooPackage\";"
+        "public spec Foo {"
+        "    int32 X { public get; concealed set; }"
+        "    public construct() { if (true) { } }"
+        "}"
+        "public int32 main() {"
+        "    if (a < 3) { return foo(a); }"
+        "    while (true) { b <- \"}\"; c <- '{'; }"
+        "    return 0;"
+        "}"
+        "public bool foo(int32 a) { return !(a = 1); }");
+
+    CompilerStringSource eager_source(input);
+    Lexer eager_lexer(eager_source);
+    Parser eager_parser(eager_lexer);
+
+    CompilerStringSource lazy_source(input);
+    Lexer lazy_lexer(lazy_source);
+    Parser lazy_parser(lazy_lexer);
+
+    ExpectSameTree(eager_parser.Parse(), lazy_parser.ParseReachable("main"));
+}
+
+TEST(Parser, ParseReachableErrors) {
+    // Errors in reachable bodies are thrown.
+    std::string invalid_body("package \"FooPackage\";"
+        "public int32 main() { return 1 }");
+
+    CompilerStringSource invalid_body_source(invalid_body);
+    Lexer invalid_body_lexer(invalid_body_source);
+    Parser invalid_body_parser(invalid_body_lexer);
+
+    EXPECT_STATUS(invalid_body_parser.ParseReachable("main"), STATUS_PARSER_EXPECTED_SEMICOLON);
+
+    // A skipped body must still be closed.
+    std::string unclosed_body("package \"FooPackage\";"
+        "public int32 main() { return 1; }"
+        "public int32 unused() { { return 1; }");
+
+    CompilerStringSource unclosed_body_source(unclosed_body);
+    Lexer unclosed_body_lexer(unclosed_body_source);
+    Parser unclosed_body_parser(unclosed_body_lexer);
+
+    EXPECT_STATUS(unclosed_body_parser.ParseReachable("main"), STATUS_PARSER_EOF);
+}
+
+TEST(Parser, ParseParallelMatchesParse) {
+    std::string input("package \"FooPackage\";"
+        "depends \"BarPackage\";"
+        "public spec Foo {"
+        "    int32 X { public get { return 1; } concealed set; }"
+        "    public construct(int32 x) { if (x > 1) { X <- x; } }"
+        "    public int32 Bar() { return baz(); }"
+        "}"
+        "public int32 main() {"
+        "    for (i <- 0; i < 3; i <- i + 1) { while (true) { b <- \"}\"; } }"
+        "    return foo(1);"
+        "}"
+        "public int32 foo(int32 a) { return a * 2; }"
+        "concealed void baz() { }");
+
+    CompilerStringSource serial_source(input);
+    Lexer serial_lexer(serial_source);
+    Parser serial_parser(serial_lexer);
+    Node* serial_root = serial_parser.Parse();
+
+    for (unsigned int thread_count = 1; thread_count <= 4; thread_count++) {
+        CompilerStringSource parallel_source(input);
+        Lexer parallel_lexer(parallel_source);
+        Parser parallel_parser(parallel_lexer);
+
+        ExpectSameTree(serial_root, parallel_parser.ParseParallel(thread_count));
+    }
+}
+
+TEST(Parser, ParseParallelErrors) {
+    // The first error in the source is thrown, even if a later body or the
+    // declarations after it also have errors.
+    std::string invalid_bodies("package \"FooPackage\";"
+        "public int32 a() { return 1; }"
+        "public int32 b() { x <- ; }"
+        "public int32 c() { return 2 }"
+        "junk");
+
+    CompilerStringSource invalid_bodies_source(invalid_bodies);
+    Lexer invalid_bodies_lexer(invalid_bodies_source);
+    Parser invalid_bodies_parser(invalid_bodies_lexer);
+
+    EXPECT_STATUS(invalid_bodies_parser.ParseParallel(4),
+        STATUS_PARSER_MALFORMED_EXPRESSION_INVALID_TOKEN);
+
+    // Errors between functions are thrown if the bodies before them are valid.
+    std::string invalid_module("package \"FooPackage\";"
+        "public int32 a() { return 1; }"
+        "junk"
+        "public int32 b() { x <- ; }");
+
+    CompilerStringSource invalid_module_source(invalid_module);
+    Lexer invalid_module_lexer(invalid_module_source);
+    Parser invalid_module_parser(invalid_module_lexer);
+
+    EXPECT_STATUS(invalid_module_parser.ParseParallel(4),
+        STATUS_PARSER_MALFORMED_SPEC_OR_FUNC_ACCESS_MODIFIER_MISSING);
+
+    // A statement missing its semicolon takes the brace after it, so the body
+    // doesn't end where its braces match. The same error as Parse() must
+    // still be thrown.
+    std::string unmatched_body("package \"FooPackage\";"
+        "public int32 a() { foo() { x <- 1; } }"
+        "public int32 b() { return 2; }");
+
+    CompilerStringSource unmatched_body_source(unmatched_body);
+    Lexer unmatched_body_lexer(unmatched_body_source);
+    Parser unmatched_body_parser(unmatched_body_lexer);
+
+    EXPECT_STATUS(unmatched_body_parser.ParseParallel(4),
+        STATUS_PARSER_MALFORMED_SPEC_OR_FUNC_ACCESS_MODIFIER_MISSING);
+}
+
+TEST(Parser, ParseImplementationMatchesParse) {
+    std::string input("package \"FooPackage\";"
+        "depends \"BarPackage\";"
+        "public int32 main() {"
+        "    for (i <- 0; i < 3; i <- i + 1) { while (true) { b <- \"}\"; } }"
+        "    return foo(1);"
+        "}"
+        "public spec Foo {"
+        "    int32 X { public get { return 1; } concealed set; }"
+        "    public construct(int32 x) { if (x > 1) { X <- x; } }"
+        "    public int32 Bar() { return baz(); }"
+        "}"
+        "public int32 foo(int32 a) { return a * 2; }"
+        "public spec Empty { }"
+        "concealed void baz() { }");
+
+    CompilerStringSource serial_source(input);
+    Lexer serial_lexer(serial_source);
+    Parser serial_parser(serial_lexer);
+    Node* serial_root = serial_parser.Parse();
+
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    Parser parser(lexer);
+    Node* root = parser.ParseDeclarations();
+
+    // The declarations have empty bodies.
+    ASSERT_EQ(3, root->child(3)->child_count());
+    EXPECT_EQ(0, root->child(3)->child(0)->child(4)->child_count());
+
+    for (size_t i = 2; i < 4; i++) {
+        ASSERT_EQ(serial_root->child(i)->child_count(), root->child(i)->child_count());
+
+        for (size_t j = 0; j < root->child(i)->child_count(); j++) {
+            NodeArena nodes;
+            ExpectSameTree(serial_root->child(i)->child(j), parser.ParseImplementation(root->child(i)->child(j), nodes));
+        }
+    }
+}
+
+TEST(Parser, ParseImplementationErrors) {
+    std::string input("package \"FooPackage\";"
+        "public int32 a() { return 1; }"
+        "public int32 b() { x <- ; }"
+        "public int32 c() { foo() { x <- 1; } }");
+
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    Parser parser(lexer);
+    Node* root = parser.ParseDeclarations();
+    NodeArena nodes;
+
+    EXPECT_FALSE(parser.ParseImplementation(root->child(3)->child(0), nodes) == NULL);
+    EXPECT_STATUS(parser.ParseImplementation(root->child(3)->child(1), nodes),
+        STATUS_PARSER_MALFORMED_EXPRESSION_INVALID_TOKEN);
 
-    delete node;
+    // A body that doesn't end on its matching brace has to be parsed with Parse().
+    EXPECT_TRUE(parser.ParseImplementation(root->child(3)->child(2), nodes) == NULL);
 }
 
 } // namespace compiler
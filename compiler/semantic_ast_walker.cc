@@ -1,12 +1,16 @@
 // Gunderscript-2 Semantic (type) Checker for Abstract Syntax Tree
 // (C) 2015-2016 Christian Gunderman
 
+#include <exception>
+#include <memory>
 #include <regex>
 
 #include "gunderscript/node.h"
 
 #include "gs_assert.h"
 #include "lexer.h"
+#include "node_arena.h"
+#include "parallel_for.h"
 #include "parser.h"
 #include "semantic_ast_walker.h"
 #include "symbolimpl.h"
@@ -17,80 +21,24 @@ namespace compiler {
 // The pattern for checking module names.
 const std::regex module_name_pattern = std::regex("^([A-Z]|[a-z])+(\\.([A-Z]|[a-z])+)?$");
 
-// Mangles function symbol name to include class name and arguments so that
-// symbol table guarantees uniqueness for functions while allowing overloads
-// with different argument types.
-static const std::string MangleFunctionSymbolName(
-    const std::string& spec_name,
-    const std::string& function_name,
-    std::vector<const SymbolBase*>& arguments_result) {
-
-    // Format the symbol name {spec}::{function}$arg1$arg2...
-    // or {function}$arg1$arg2... if there is no spec.
-    std::ostringstream name_buf;
-    name_buf << spec_name;
-    name_buf << "::";
-    name_buf << function_name;
-
-    // Append arguments to the symbol name.
-    for (size_t i = 0; i < arguments_result.size(); i++) {
-        name_buf << "$";
-        name_buf << arguments_result[i]->type_symbol()->symbol_name();
-    }
-
-    return name_buf.str();
-}
-
-// Wrapper for the other MangleFunctionSymbolName.
-static const std::string MangleFunctionSymbolName(
-    Node* spec_node,
-    Node* name_node,
-    std::vector<const SymbolBase*>& arguments_result) {
-
-    return MangleFunctionSymbolName(
-        spec_node != NULL ? spec_node->symbol()->symbol_name() : "",
-        *name_node->string_value(),
-        arguments_result);
-}
-
 // Mangles local variable symbol name to the format Local%%{variable}
 // so that they do not collide with class names in the symbol table.
-static const std::string MangleLocalVariableSymbolName(const std::string& name) {
+static Atom MangleLocalVariableSymbolName(AtomTable& atoms, const std::string& name) {
     std::ostringstream name_buf;
     name_buf << "Local%%";
     name_buf << name;
 
-    return name_buf.str();
+    return atoms.Intern(name_buf.str());
 }
 
-// Mangles a property function symbol name.
-static const std::string ManglePropertyFunctionSymbolName(
-    const std::string& spec_name,
-    const std::string& property_name,
-    PropertyFunction function) {
-
-    // Format the getter symbol name {class}<-{function}
-    std::ostringstream name_buf;
-    name_buf << spec_name;
-    name_buf << (function == PropertyFunction::SET ? "->" : "<-");
-    name_buf << property_name;
-
-    return name_buf.str();
-}
+// Mangles a Spec Template symbol name to indicate a number of generic params.
+static Atom MangleSpecTemplateSymbolName(AtomTable& atoms, Node* type_node) {
 
-// Wrapper for other overload.
-static const std::string ManglePropertyFunctionSymbolName(
-    Node* spec_node,
-    Node* name_node,
-    PropertyFunction function) {
-    return ManglePropertyFunctionSymbolName(
-        spec_node->symbol()->symbol_name(),
-        *name_node->string_value(),
-        function);
-}
+    // Non-generic types are just their name.
+    if (type_node->child_count() == 0) {
+        return type_node->atom();
+    }
 
-// Mangles a Spec Template symbol name to indicate a number of generic params.
-static const std::string MangleSpecTemplateSymbolName(Node* type_node) {
     std::ostringstream name_buf;
     name_buf << *type_node->string_value();
 
@@ -99,17 +47,89 @@ static const std::string MangleSpecTemplateSymbolName(Node* type_node) {
         name_buf << '~';
     }
 
-    return name_buf.str();
+    return atoms.Intern(name_buf.str());
 }
 
 // Constructor, populates symbol table with Types.
-SemanticAstWalker::SemanticAstWalker(Node& node) : AstWalker(node), symbol_table_() {
+// node: the root of the AST to check.
+// atoms: the AtomTable that the AST's names were interned in.
+SemanticAstWalker::SemanticAstWalker(Node& node, AtomTable& atoms, const LineTable& lines)
+    : AstWalker(node), atoms_(atoms), lines_(lines), arena_(node.arena()), symbol_table_() {
 
     // Add all default types to the Symbol table.
     for (size_t i = 0; i < BUILTIN_TYPES.size(); i++) {
         const SymbolBase* current_type = BUILTIN_TYPES[i];
 
-        this->symbol_table_.PutBottom(current_type->symbol_name(), current_type);
+        this->symbol_table_.PutBottom(this->atoms_.Intern(current_type->symbol_name()), current_type);
+    }
+}
+
+// Constructor for the implementation pass workers used by WalkParallel().
+// node: the root of the AST to check.
+// atoms: the worker's own AtomTable, layered on the one the AST's names were
+// interned in.
+// global_table: the declarations of the whole module. Read only.
+// global_overloads: the function and property declarations of the whole
+// module. Read only.
+SemanticAstWalker::SemanticAstWalker(
+    Node& node,
+    AtomTable& atoms,
+    const LineTable& lines,
+    const SymbolTable<const SymbolBase*>& global_table,
+    const OverloadIndex<const SymbolBase*>& global_overloads)
+    : AstWalker(node), atoms_(atoms), lines_(lines), arena_(node.arena()),
+    symbol_table_(&global_table), overloads_(&global_overloads) {
+}
+
+// Type checks the AST like Walk(), but checks the function and spec
+// implementations in parallel once the declarations are in the symbol table.
+// Each worker thread checks one implementation at a time with its own local
+// SymbolTable and AtomTable on top of this walker's, which no one modifies
+// until all of the workers are done. If more than one implementation has an
+// error, the one that Walk() would have found first is thrown, no matter
+// which thread found it first.
+// thread_count: the number of threads, or 0 for one per hardware thread.
+// Throws: semantic exceptions if the AST is not type correct.
+void SemanticAstWalker::WalkParallel(unsigned int thread_count) {
+    thread_count = ParallelThreadCount(thread_count);
+
+    // Declarations are walked serially since they fill the global scope.
+    WalkModuleDeclarationsChildren();
+
+    // Implementations are checked in the same order as Walk() would check them.
+    std::vector<Node*> impl_nodes = ImplementationNodes();
+
+    // Local variable and mangled names are interned into each worker's own
+    // AtomTable since the shared one isn't thread safe.
+    std::vector<std::unique_ptr<AtomTable>> worker_atoms(thread_count);
+    for (unsigned int i = 0; i < thread_count; i++) {
+        worker_atoms[i].reset(new AtomTable(&this->atoms_));
+    }
+
+    std::vector<std::exception_ptr> impl_errors(impl_nodes.size());
+
+    ParallelFor(impl_nodes.size(), thread_count, [&](unsigned int worker, size_t i) {
+        try {
+            SemanticAstWalker worker_walker(
+                this->root(),
+                *worker_atoms[worker],
+                this->lines_,
+                this->symbol_table_,
+                this->overloads_);
+
+            worker_walker.WalkImplementation(impl_nodes[i]);
+        }
+        catch (...) {
+            impl_errors[i] = std::current_exception();
+        }
+    });
+
+    // Report the first error in the order that Walk() checks the
+    // implementations so that the result doesn't depend on the thread count.
+    for (size_t i = 0; i < impl_errors.size(); i++) {
+        if (impl_errors[i]) {
+            std::rethrow_exception(impl_errors[i]);
+        }
     }
 }
 
@@ -128,8 +148,7 @@ void SemanticAstWalker::WalkModule(Node* module_node) {
 void SemanticAstWalker::WalkModuleName(Node* name_node) {
     CheckValidModuleName(
         *name_node->string_value(),
-        name_node->line(),
-        name_node->column());
+        name_node->offset());
 }
 
 // Checks that the given dependency module name is valid.
@@ -139,8 +158,7 @@ void SemanticAstWalker::WalkModuleName(Node* name_node) {
 void SemanticAstWalker::WalkModuleDependsName(Node* name_node) {
     CheckValidModuleName(
         *name_node->string_value(),
-        name_node->line(),
-        name_node->column());
+        name_node->offset());
 }
 
 void SemanticAstWalker::WalkSpecDeclarationPrescan(
@@ -148,14 +166,14 @@ void SemanticAstWalker::WalkSpecDeclarationPrescan(
     Node* access_modifier_node,
     Node* type_node) {
 
-    const std::string type_symbol_name = MangleSpecTemplateSymbolName(type_node);
+    const Atom type_symbol_name = MangleSpecTemplateSymbolName(this->atoms_, type_node);
     const TypeSymbol* spec_symbol = NULL;
 
     // Check if this is a generic type. If so, it gets a specialized symbol with params.
     if (type_node->child_count() == 0) {
-        spec_symbol = new TypeSymbol(
+        spec_symbol = this->arena_.NewSymbol<TypeSymbol>(
             access_modifier_node->symbol_value(),
-            type_symbol_name);
+            type_symbol_name.str());
     }
     else {
         std::vector<const SymbolBase*> type_params;
@@ -164,7 +182,7 @@ void SemanticAstWalker::WalkSpecDeclarationPrescan(
         // params.
         for (size_t i = 0; i < type_node->child_count(); i++) {
             Node* child_node = type_node->child(i);
-            const TypeSymbol* template_type_symbol = new TypeSymbol(
+            const TypeSymbol* template_type_symbol = this->arena_.NewSymbol<TypeSymbol>(
                 SymbolType::TYPE_TEMPLATE,
                 LexerSymbol::CONCEALED,
                 *child_node->string_value(),
@@ -175,14 +193,14 @@ void SemanticAstWalker::WalkSpecDeclarationPrescan(
             type_params.push_back(template_type_symbol);
         }
 
-        spec_symbol = new GenericTypeSymbol(
+        spec_symbol = this->arena_.NewSymbol<GenericTypeSymbol>(
             SymbolType::GENERIC_TYPE_TEMPLATE,
             access_modifier_node->symbol_value(),
-            type_symbol_name,
+            type_symbol_name.str(),
             type_params);
     }
 
-    // Store a reference to the symbol. Node will destroy symbol on cleanup.
+    // Store a reference to the symbol. The node's arena destroys it with the tree.
     spec_node->set_symbol(spec_symbol);
 
     try {
@@ -194,8 +212,8 @@ void SemanticAstWalker::WalkSpecDeclarationPrescan(
         // Rethrow as more relevant exception.
         if (ex.status() == STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL) {
             THROW_EXCEPTION(
-                type_node->line(),
-                type_node->column(),
+                this->lines_.line_number(type_node->offset()),
+                this->lines_.column_number(type_node->offset()),
                 STATUS_SEMANTIC_DUPLICATE_SPEC);
         }
 
@@ -231,15 +249,17 @@ void SemanticAstWalker::WalkSpecDeclaration(
                 const SymbolBase* template_type_symbol = type_symbol->type_params().at(i);
 
                 try {
-                    this->symbol_table_.Put(template_type_symbol->symbol_name(), template_type_symbol);
+                    this->symbol_table_.Put(
+                        this->atoms_.Intern(template_type_symbol->symbol_name()),
+                        template_type_symbol);
                 }
                 catch (const Exception& ex) {
 
                     // Rethrow as more relevant exception.
                     if (ex.status() == STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL) {
                         THROW_EXCEPTION(
-                            type_node->line(),
-                            type_node->column(),
+                            this->lines_.line_number(type_node->offset()),
+                            this->lines_.column_number(type_node->offset()),
                             STATUS_SEMANTIC_GENERIC_DUPLICATE_PARAM);
                     }
 
@@ -251,7 +271,7 @@ void SemanticAstWalker::WalkSpecDeclaration(
         // Register 'this' variable in local scope.
         try {
             this->symbol_table_.Put(
-                MangleLocalVariableSymbolName(kThisKeyword),
+                MangleLocalVariableSymbolName(this->atoms_, kThisKeyword),
                 spec_node->symbol());
         }
         catch (const Exception&) {
@@ -280,20 +300,22 @@ void SemanticAstWalker::WalkFunctionDeclaration(
     // regardless of the order in which they are declared.
     if (prescan) {
         try {
-            const std::string symbol_name = MangleFunctionSymbolName(spec_node, name_node, arguments_result);
-
-            const SymbolBase* function_symbol = new FunctionSymbol(
+            const SymbolBase* function_symbol = this->arena_.NewSymbol<FunctionSymbol>(
                 SymbolType::FUNCTION,
                 access_modifier_node->symbol_value(),
                 spec_name,
-                symbol_name,
+                *name_node->string_value(),
                 ResolveTypeNode(type_node));
 
-            // Node will destroy symbol on cleanup.
+            // The node's arena destroys the symbol with the tree.
             function_node->set_symbol(function_symbol);
 
-            this->symbol_table_.PutBottom(
-                symbol_name,
+            this->overloads_.Put(
+                OverloadKey(
+                    SpecAtom(spec_node != NULL ? spec_node->symbol() : NULL),
+                    name_node->atom(),
+                    PropertyFunction::NONE),
+                arguments_result,
                 function_symbol);
         }
         catch (const Exception& ex) {
@@ -301,8 +323,8 @@ void SemanticAstWalker::WalkFunctionDeclaration(
             // Throw a more relevant exception.
             if (ex.status() == STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL) {
                 THROW_EXCEPTION(
-                    name_node->line(),
-                    name_node->column(),
+                    this->lines_.line_number(name_node->offset()),
+                    this->lines_.column_number(name_node->offset()),
                     STATUS_SEMANTIC_DUPLICATE_FUNCTION);
             }
             else {
@@ -325,15 +347,17 @@ const SymbolBase* SemanticAstWalker::WalkSpecFunctionDeclarationParameter(
     const TypeSymbol* type_symbol = ResolveTypeNode(type_node)->type_symbol();
 
     // Disallow void type as function param.
-    if (*type_symbol == TYPE_VOID) {
+    if (type_symbol == &TYPE_VOID) {
         THROW_EXCEPTION(
-            type_node->line(),
-            type_node->column(),
+            this->lines_.line_number(type_node->offset()),
+            this->lines_.column_number(type_node->offset()),
             STATUS_SEMANTIC_VOID_USED_IN_PARAM);
     }
 
-    // Create a new symbol for the parameter.
-    const SymbolBase* param_symbol = new FunctionSymbol(
+    // Create a new symbol for the parameter. Like local variables, it lives
+    // in the arena of the function's nodes, which may be freed before the
+    // rest of the tree when functions are compiled one at a time.
+    const SymbolBase* param_symbol = function_param_node->arena().NewSymbol<FunctionSymbol>(
         SymbolType::PARAM,
         LexerSymbol::CONCEALED,
         "",
@@ -345,7 +369,7 @@ const SymbolBase* SemanticAstWalker::WalkSpecFunctionDeclarationParameter(
     try {
         // Insert the symbol into the table.
         this->symbol_table_.Put(
-            MangleLocalVariableSymbolName(*name_node->string_value()),
+            MangleLocalVariableSymbolName(this->atoms_, *name_node->string_value()),
             param_symbol);
     }
     catch (const Exception& ex) {
@@ -353,8 +377,8 @@ const SymbolBase* SemanticAstWalker::WalkSpecFunctionDeclarationParameter(
         // Throw a more relevant exception.
         if (ex.status() == STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL) {
             THROW_EXCEPTION(
-                name_node->line(),
-                name_node->column(),
+                this->lines_.line_number(name_node->offset()),
+                this->lines_.column_number(name_node->offset()),
                 STATUS_SEMANTIC_DUPLICATE_FUNCTION_PARAM);
         }
         else {
@@ -387,51 +411,52 @@ void SemanticAstWalker::WalkSpecPropertyDeclaration(
     }
 
     const std::string spec_name = spec_node->symbol()->symbol_name();
-
-    // Determine the getter function symbol name.
-    std::string get_function_symbol_name
-        = ManglePropertyFunctionSymbolName(spec_node, name_node, PropertyFunction::GET);
+    const Atom spec_atom = SpecAtom(spec_node->symbol());
 
     const SymbolBase* type_symbol = ResolveTypeNode(type_node);
 
     // Create the symbol table symbol for the getter.
-    const SymbolBase* get_function_symbol = new FunctionSymbol(
+    const SymbolBase* get_function_symbol = this->arena_.NewSymbol<FunctionSymbol>(
         SymbolType::PROPERTY,
         get_access_modifier_node->symbol_value(),
         spec_name,
-        get_function_symbol_name,
+        *name_node->string_value(),
         type_symbol);
 
     get_property_function_node->set_symbol(get_function_symbol);
 
-    // Determine the setter function symbol name.
-    std::string set_function_symbol_name
-        = ManglePropertyFunctionSymbolName(spec_node, name_node, PropertyFunction::SET);
-
     // Create the symbol table symbol for the getter.
-    const SymbolBase* set_function_symbol = new FunctionSymbol(
+    const SymbolBase* set_function_symbol = this->arena_.NewSymbol<FunctionSymbol>(
         SymbolType::FUNCTION,
         set_access_modifier_node->symbol_value(),
         spec_name,
-        set_function_symbol_name,
+        *name_node->string_value(),
         type_symbol);
 
     set_property_function_node->set_symbol(set_function_symbol);
 
     try {
+        const std::vector<const SymbolBase*> no_params;
+
         // Define the getter symbol.
-        this->symbol_table_.PutBottom(get_function_symbol_name, get_function_symbol);
+        this->overloads_.Put(
+            OverloadKey(spec_atom, name_node->atom(), PropertyFunction::GET),
+            no_params,
+            get_function_symbol);
 
         // Define the setter symbol.
-        this->symbol_table_.PutBottom(set_function_symbol_name, set_function_symbol);
+        this->overloads_.Put(
+            OverloadKey(spec_atom, name_node->atom(), PropertyFunction::SET),
+            no_params,
+            set_function_symbol);
     }
     catch (const Exception& ex) {
 
         // Rethrow as more understandable error.
         if (ex.status() == STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL) {
             THROW_EXCEPTION(
-                name_node->line(),
-                name_node->column(),
+                this->lines_.line_number(name_node->offset()),
+                this->lines_.column_number(name_node->offset()),
                 STATUS_SEMANTIC_DUPLICATE_PROPERTY);
         }
 
@@ -456,8 +481,8 @@ const SymbolBase* SemanticAstWalker::WalkFunctionCall(
         // or foo.x(). x() does not work.
         return WalkFunctionCall(
             spec_node,
-            "",
-            *name_node->string_value(),
+            NULL,
+            name_node->atom(),
             call_node,
             arguments_result);
     }
@@ -481,47 +506,42 @@ const SymbolBase* SemanticAstWalker::WalkFunctionCall(
 
 // Walks a function call and checks to make sure that the types
 // of the function matches the context.
+// spec_symbol: the type of the object the function is called on, or NULL
+// for static function calls.
 const SymbolBase* SemanticAstWalker::WalkFunctionCall(
     Node* spec_node,
-    const std::string& spec_name,
-    const std::string& function_name,
+    const SymbolBase* spec_symbol,
+    Atom function_name,
     Node* call_node,
     std::vector<const SymbolBase*>& arguments_result) {
 
-    const SymbolBase* function_symbol = NULL;
+    const SymbolBase* const* function_entry = NULL;
 
-    // Lookup the function in this class. Throws if there isn't a function with the correct arguments.
-    try {
-        function_symbol = this->symbol_table_.Get(
-            MangleFunctionSymbolName(spec_name, function_name, arguments_result));
+    // Lookup the function in this class.
+    if (spec_symbol != NULL) {
+        function_entry = this->overloads_.Find(
+            OverloadKey(SpecAtom(spec_symbol), function_name, PropertyFunction::NONE),
+            arguments_result);
     }
-    catch (const Exception& ex) {
 
-        // The symbol for this function is unknown. Let's try an out of spec (static) function.
-        if (ex.status() != STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL) {
-            throw;
-        }
-
-        try {
-            function_symbol = this->symbol_table_.Get(
-                MangleFunctionSymbolName("", function_name, arguments_result));
-        }
-        catch (const Exception& ex) {
-
-            // The symbol for this function is unknown. Either a typo or a function-like typecast.
-            if (ex.status() == STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL) {
-                THROW_EXCEPTION(
-                    call_node->line(),
-                    call_node->column(),
-                    STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
-            }
+    // The symbol for this function is unknown. Let's try an out of spec (static) function.
+    if (function_entry == NULL) {
+        function_entry = this->overloads_.Find(
+            OverloadKey(Atom(), function_name, PropertyFunction::NONE),
+            arguments_result);
+    }
 
-            throw;
-        }
+    // The symbol for this function is unknown. Either a typo or a function-like typecast.
+    if (function_entry == NULL) {
+        THROW_EXCEPTION(
+            this->lines_.line_number(call_node->offset()),
+            this->lines_.column_number(call_node->offset()),
+            STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
     }
 
-    // Copied symbol because ~Node() destroys symbol on exit.
-    call_node->set_symbol(function_symbol->Clone());
+    const SymbolBase* function_symbol = *function_entry;
+
+    call_node->set_symbol(function_symbol);
 
     // Check for access to the callee function.
     // TODO: as of the moment this does nothing because we don't support calls between classes
@@ -530,8 +550,7 @@ const SymbolBase* SemanticAstWalker::WalkFunctionCall(
         spec_node != NULL ? spec_node->symbol()->symbol_name() : "",
         function_symbol->spec_name(),
         function_symbol->access_modifier(),
-        call_node->line(),
-        call_node->column());
+        call_node->offset());
 
     return function_symbol->type_symbol();
 }
@@ -554,14 +573,14 @@ const SymbolBase* SemanticAstWalker::WalkMemberFunctionCall(
 
     const SymbolBase* result = WalkFunctionCall(
         spec_node,
-        left_result->type_symbol()->symbol_name(),
-        *name_node->string_value(),
+        left_result->type_symbol(),
+        name_node->atom(),
         right_node,
         arguments_result);
 
     // Set member node symbol to be the function call symbol since the member
     // simply resolves to a function call.
-    member_node->set_symbol(right_node->symbol()->Clone());
+    member_node->set_symbol(right_node->symbol());
 
     return result;
 }
@@ -576,35 +595,27 @@ const SymbolBase* SemanticAstWalker::TypeCheckProperty(
 
     GS_ASSERT_NODE_RULE(name_node, NodeRule::NAME);
 
-    const std::string property_symbol_name = ManglePropertyFunctionSymbolName(
-        left_result->type_symbol()->symbol_name(),
-        *name_node->string_value(),
-        property_function);
-
-    const SymbolBase* property_function_symbol = NULL;
-    try {
-        property_function_symbol = this->symbol_table_.Get(property_symbol_name);
+    const std::vector<const SymbolBase*> no_arguments;
+    const SymbolBase* const* property_function_entry = this->overloads_.Find(
+        OverloadKey(SpecAtom(left_result->type_symbol()), name_node->atom(), property_function),
+        no_arguments);
+    if (property_function_entry == NULL) {
+        THROW_EXCEPTION(
+            this->lines_.line_number(right_node->offset()),
+            this->lines_.column_number(right_node->offset()),
+            STATUS_SEMANTIC_PROPERTY_NOT_FOUND);
     }
-    catch (const Exception& ex) {
 
-        // Translate exception to more meaningful error message.
-        if (ex.status() == STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL) {
-            THROW_EXCEPTION(
-                right_node->line(),
-                right_node->column(),
-                STATUS_SEMANTIC_PROPERTY_NOT_FOUND);
-        }
-    }
+    const SymbolBase* property_function_symbol = *property_function_entry;
 
-    member_node->set_symbol(property_function_symbol->Clone());
+    member_node->set_symbol(property_function_symbol);
 
     // Ensure that we have GET access to the property in question.
     CheckAccessModifier(
         spec_node != NULL ? spec_node->symbol()->symbol_name() : "",
         property_function_symbol->spec_name(),
         property_function_symbol->access_modifier(),
-        member_node->line(),
-        member_node->column());
+        member_node->offset());
 
     return property_function_symbol;
 }
@@ -646,10 +657,10 @@ void SemanticAstWalker::WalkIfStatement(
 
     // The body of the if, else, and else_if if present are type checked automatically
     // as they are BLOCK nodes. All we need to explicitly check here is the condition type.
-    if (*condition_result != TYPE_BOOL) {
+    if (condition_result != &TYPE_BOOL) {
         THROW_EXCEPTION(
-            if_node->line(),
-            if_node->column(),
+            this->lines_.line_number(if_node->offset()),
+            this->lines_.column_number(if_node->offset()),
             STATUS_SEMANTIC_INVALID_IF_CONDITION_TYPE);
     }
 }
@@ -661,10 +672,10 @@ void SemanticAstWalker::WalkForStatement(
     const SymbolBase* condition_result) {
 
     // Check for a bool in the condition.
-    if (*condition_result != TYPE_BOOL) {
+    if (condition_result != &TYPE_BOOL) {
         THROW_EXCEPTION(
-            for_node->line(),
-            for_node->column(),
+            this->lines_.line_number(for_node->offset()),
+            this->lines_.column_number(for_node->offset()),
             STATUS_SEMANTIC_INVALID_LOOP_CONDITION_TYPE);
     }
 }
@@ -678,68 +689,64 @@ const SymbolBase* SemanticAstWalker::WalkFunctionLikeTypecast(
     const SymbolBase* argument_result) {
 
     // Disallow casting from void function.
-    if (*argument_result == TYPE_VOID) {
+    if (argument_result == &TYPE_VOID) {
         THROW_EXCEPTION(
-            call_node->line(),
-            call_node->column(),
+            this->lines_.line_number(call_node->offset()),
+            this->lines_.column_number(call_node->offset()),
             STATUS_SEMANTIC_VOID_USED_IN_EXPR);
     }
 
-    try {
-        // If this fails, user specified invalid function or typecast.
-        const TypeSymbol* cast_type_symbol = this->symbol_table_.Get(*name_node->string_value())->type_symbol();
-
-        call_node->set_symbol(cast_type_symbol->Clone());
-
-        const TypeSymbol* result_type_symbol = argument_result->type_symbol();
-
-        // Make the assumption that we support conversions between all non-pointer types.
-        // It is up the the LIRGenAstWalker to implement support for the OP codes.
-        switch (cast_type_symbol->type_format()) {
-        case TypeFormat::FVOID:
-            // Disallowed typecast.
-            break;
-        case TypeFormat::FLOAT:
-        case TypeFormat::INT:
-            // TODO: put exceptions in here if any.
-            // For now, assume all types except pointer can be cast.
-           
-            if (result_type_symbol->type_format() != TypeFormat::POINTER) {
-                return cast_type_symbol;
-            }
-            break;
-        case TypeFormat::BOOL:
-            // Although we support typecasting from INT types to BOOL which is a no-no
-            // in other languages (don't care) we aren't going to support casting from
-            // floating types because there is too much risk of trouble due to mildly
-            // different floating point representations causing near-zero values to
-            // be treated as zero and vice versa. If the user wants to cast they must
-            // use an if statement.
-            if (result_type_symbol->type_format() != TypeFormat::POINTER &&
-                result_type_symbol->type_format() != TypeFormat::FLOAT) {
-                return cast_type_symbol;
-            }
-            break;
-
-        default:
-            GS_ASSERT_FAIL("Unimplemented cast in WalkFunctionLikeTypecast");
-        }
+    // If this fails, user specified invalid function or typecast.
+    const SymbolBase* const* cast_entry = this->symbol_table_.Find(name_node->atom());
+    if (cast_entry == NULL) {
+        THROW_EXCEPTION(
+            this->lines_.line_number(name_node->offset()),
+            this->lines_.column_number(name_node->offset()),
+            STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
     }
-    catch (const Exception& ex) {
 
-        // If the symbol is undefined, this is an invalid function symbol or typecast.
-        if (ex.status() == STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL) {
-            THROW_EXCEPTION(
-                name_node->line(),
-                name_node->column(),
-                STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
+    const TypeSymbol* cast_type_symbol = (*cast_entry)->type_symbol();
+
+    call_node->set_symbol(cast_type_symbol);
+
+    const TypeSymbol* result_type_symbol = argument_result->type_symbol();
+
+    // Make the assumption that we support conversions between all non-pointer types.
+    // It is up the the LIRGenAstWalker to implement support for the OP codes.
+    switch (cast_type_symbol->type_format()) {
+    case TypeFormat::FVOID:
+        // Disallowed typecast.
+        break;
+    case TypeFormat::FLOAT:
+    case TypeFormat::INT:
+        // TODO: put exceptions in here if any.
+        // For now, assume all types except pointer can be cast.
+       
+        if (result_type_symbol->type_format() != TypeFormat::POINTER) {
+            return cast_type_symbol;
+        }
+        break;
+    case TypeFormat::BOOL:
+        // Although we support typecasting from INT types to BOOL which is a no-no
+        // in other languages (don't care) we aren't going to support casting from
+        // floating types because there is too much risk of trouble due to mildly
+        // different floating point representations causing near-zero values to
+        // be treated as zero and vice versa. If the user wants to cast they must
+        // use an if statement.
+        if (result_type_symbol->type_format() != TypeFormat::POINTER &&
+            result_type_symbol->type_format() != TypeFormat::FLOAT) {
+            return cast_type_symbol;
         }
+        break;
+
+    default:
+        GS_ASSERT_FAIL("Unimplemented cast in WalkFunctionLikeTypecast");
     }
 
     // If we reached this far then the user specified an _unsupported_ typecast.
     THROW_EXCEPTION(
-        name_node->line(),
-        name_node->column(),
+        this->lines_.line_number(name_node->offset()),
+        this->lines_.column_number(name_node->offset()),
         STATUS_SEMANTIC_UNSUPPORTED_TYPECAST);
 }
 
@@ -753,70 +760,63 @@ const SymbolBase* SemanticAstWalker::WalkAssign(
     const SymbolBase* operation_result) {
 
     // Disallow assigning result of void functions.
-    if (*operation_result->type_symbol() == TYPE_VOID) {
+    if (operation_result->type_symbol() == &TYPE_VOID) {
         THROW_EXCEPTION(
-            assign_node->line(),
-            assign_node->column(),
+            this->lines_.line_number(assign_node->offset()),
+            this->lines_.column_number(assign_node->offset()),
             STATUS_SEMANTIC_VOID_USED_IN_EXPR);
     }
 
     // Disallow assigning to 'this' keyword.
     if (*name_node->string_value() == kThisKeyword) {
         THROW_EXCEPTION(
-            assign_node->line(),
-            assign_node->column(),
+            this->lines_.line_number(assign_node->offset()),
+            this->lines_.column_number(assign_node->offset()),
             STATUS_SEMANTIC_THIS_ASSIGNED);
     }
 
-    std::string symbol_name = MangleLocalVariableSymbolName(*name_node->string_value());
+    Atom symbol_name = MangleLocalVariableSymbolName(this->atoms_, *name_node->string_value());
 
-    // Try to add the variable symbol to the top level of the symbol table
-    // (most recent scope). If the value exists in a lower scope it will
-    // be masked by this new definition until the newer scope is popped.
-    try {
-
-        SymbolBase* assign_symbol = new FunctionSymbol(
-            SymbolType::VARIABLE,
-            LexerSymbol::CONCEALED,
-            "",
-            *name_node->string_value(),
-            operation_result);
-
-        this->symbol_table_.Put(
-            symbol_name,
-            operation_result);
-        
-        assign_node->set_symbol(assign_symbol);
-
-        // Create a second copy for the other node.
-        symbol_node->set_symbol(operation_result->Clone());
-
-        return assign_symbol;
-    }
-    catch (const Exception& ex) {
-
-        // Throw exception if it's not the expected exception, we don't have handling
-        // for this case.
-        GS_ASSERT_FALSE(ex.status() != STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL, "Unhandled exception case");
-
-        // Value already exists in the current level of the symbol table
-        // so look up the existing value and its type and make sure that the new type
-        // matches the existing type.
-
-        const SymbolBase* variable_symbol = this->symbol_table_.Get(symbol_name);
-        assign_node->set_symbol(variable_symbol->Clone());
-        symbol_node->set_symbol(variable_symbol->Clone());
+    // Value already exists in the current level of the symbol table
+    // so look up the existing value and its type and make sure that the new type
+    // matches the existing type.
+    const SymbolBase* const* variable_entry = this->symbol_table_.FindTopOnly(symbol_name);
+    if (variable_entry != NULL) {
+        const SymbolBase* variable_symbol = *variable_entry;
+        assign_node->set_symbol(variable_symbol);
+        symbol_node->set_symbol(variable_symbol);
 
         // Check to make sure that type of new assignment matches original declared type.
-        if (*variable_symbol->type_symbol() != *operation_result->type_symbol()) {
+        if (variable_symbol->type_symbol() != operation_result->type_symbol()) {
             THROW_EXCEPTION(
-                name_node->line(),
-                name_node->column(),
+                this->lines_.line_number(name_node->offset()),
+                this->lines_.column_number(name_node->offset()),
                 STATUS_SEMANTIC_TYPE_MISMATCH_IN_ASSIGN);
         }
 
         return variable_symbol;
     }
+
+    // Add the variable symbol to the top level of the symbol table
+    // (most recent scope). If the value exists in a lower scope it will
+    // be masked by this new definition until the newer scope is popped.
+    const SymbolBase* assign_symbol = assign_node->arena().NewSymbol<FunctionSymbol>(
+        SymbolType::VARIABLE,
+        LexerSymbol::CONCEALED,
+        "",
+        *name_node->string_value(),
+        operation_result);
+
+    assign_node->set_symbol(assign_symbol);
+
+    this->symbol_table_.Put(
+        symbol_name,
+        operation_result);
+
+    // The symbol node refers to the variable's type.
+    symbol_node->set_symbol(operation_result);
+
+    return assign_symbol;
 }
 
 // Walks and validates a return value type for a function or property.
@@ -829,40 +829,34 @@ const SymbolBase* SemanticAstWalker::WalkReturn(
     const SymbolBase** expression_result,
     std::vector<const SymbolBase*>* arguments_result) {
 
-    Node* name_node = NULL;
-    std::string symbol_name;
-
     const SymbolBase* function_symbol;
 
     // Load the symbol for the respective function or property.
     switch (property_function) {
     case PropertyFunction::NONE: 
-        // Determine the symbol name of the function.
-        name_node = function_node->child(2);
-        symbol_name = MangleFunctionSymbolName(
-            spec_node, name_node, *arguments_result);
-        function_symbol = this->symbol_table_.Get(symbol_name);
+        // The prescan attached the function's symbol to its node.
+        function_symbol = SYMBOL_TO_FUNCTION(function_node->symbol());
         break;
     case PropertyFunction::GET:
-        // Determine the symbol name of the GETTER property function.
-        name_node = property_node->child(1);
-        symbol_name = ManglePropertyFunctionSymbolName(
-            spec_node,
-            name_node,
-            property_function);
-        function_symbol = SYMBOL_TO_PROPERTY(this->symbol_table_.Get(symbol_name));
+        // The GETTER property function has no params.
+        function_symbol = SYMBOL_TO_PROPERTY(*this->overloads_.Find(
+            OverloadKey(
+                SpecAtom(spec_node->symbol()),
+                property_node->child(1)->atom(),
+                property_function),
+            std::vector<const SymbolBase*>()));
         break;
     case PropertyFunction::SET:
         // Property setter function cannot return value.
         THROW_EXCEPTION(
-            property_node->line(),
-            property_node->column(),
+            this->lines_.line_number(property_node->offset()),
+            this->lines_.column_number(property_node->offset()),
             STATUS_SEMANTIC_RETURN_FROM_PROPERTY_SET);
     default:
         // Unhandled switch case.
         THROW_EXCEPTION(
-            property_node->line(),
-            property_node->column(),
+            this->lines_.line_number(property_node->offset()),
+            this->lines_.column_number(property_node->offset()),
             STATUS_ILLEGAL_STATE);
     }
 
@@ -873,27 +867,27 @@ const SymbolBase* SemanticAstWalker::WalkReturn(
 
     // Check to make sure that the type of the function symbol matches the type
     // of the return statement expression.
-    if (*function_symbol->type_symbol() != *(*expression_result)->type_symbol()) {
+    if (function_symbol->type_symbol() != (*expression_result)->type_symbol()) {
 
         // WalkReturn() will have either a property_node or a function_node, not both.
         Node* line_number_node = property_node != NULL ? property_node : function_node;
 
         // More informative error messages.
-        if (*function_symbol->type_symbol() == TYPE_VOID) {
+        if (function_symbol->type_symbol() == &TYPE_VOID) {
             THROW_EXCEPTION(
-                line_number_node->line(),
-                line_number_node->column(),
+                this->lines_.line_number(line_number_node->offset()),
+                this->lines_.column_number(line_number_node->offset()),
                 STATUS_SEMANTIC_RETURN_IN_VOID);
         }
-        else if ((**expression_result) == TYPE_VOID) {
+        else if (*expression_result == &TYPE_VOID) {
             THROW_EXCEPTION(
-                line_number_node->line(),
-                line_number_node->column(),
+                this->lines_.line_number(line_number_node->offset()),
+                this->lines_.column_number(line_number_node->offset()),
                 STATUS_SEMANTIC_VOID_USED_IN_EXPR);
         } else {
             THROW_EXCEPTION(
-                line_number_node->line(),
-                line_number_node->column(),
+                this->lines_.line_number(line_number_node->offset()),
+                this->lines_.column_number(line_number_node->offset()),
                 STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
         }
     }
@@ -903,11 +897,11 @@ const SymbolBase* SemanticAstWalker::WalkReturn(
 
 // Checks to see if the given module name is valid. If it is not, throws
 // an exception.
-void SemanticAstWalker::CheckValidModuleName(const std::string& module_name, int line, int column) {
+void SemanticAstWalker::CheckValidModuleName(const std::string& module_name, uint32_t offset) {
     if (!std::regex_match(module_name, module_name_pattern)) {
         THROW_EXCEPTION(
-            line,
-            column,
+            this->lines_.line_number(offset),
+            this->lines_.column_number(offset),
             STATUS_SEMANTIC_INVALID_PACKAGE);
     }
 }
@@ -926,21 +920,19 @@ const SymbolBase* SemanticAstWalker::WalkAdd(
     // Only allow numeric and string types.
     if (left_symbol->type_format() != TypeFormat::INT &&
         left_symbol->type_format() != TypeFormat::FLOAT &&
-        *left_symbol != TYPE_STRING) {
+        left_symbol != &TYPE_STRING) {
         THROW_EXCEPTION(
-            left_node->line(),
-            left_node->column(),
+            this->lines_.line_number(left_node->offset()),
+            this->lines_.column_number(left_node->offset()),
             STATUS_SEMANTIC_INVALID_TYPE_IN_ADD);
     }
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    add_node->set_symbol(left_result->Clone());
+    add_node->set_symbol(left_result);
 
     return CalculateResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        right_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_ADD);
 }
 
@@ -953,16 +945,14 @@ const SymbolBase* SemanticAstWalker::WalkSub(
     const SymbolBase* left_result,
     const SymbolBase* right_result) {
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
     // HACK: unary negative numbers use ANY_TYPE to bypass typechecking, be sure
     // this symbol always pulls from the right side.
-    sub_node->set_symbol(right_node->symbol()->Clone());
+    sub_node->set_symbol(right_node->symbol());
 
     return CalculateNumericResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_SUB);
 }
 
@@ -975,14 +965,12 @@ const SymbolBase* SemanticAstWalker::WalkMul(
     const SymbolBase* left_result,
     const SymbolBase* right_result) {
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    mul_node->set_symbol(left_node->symbol()->Clone());
+    mul_node->set_symbol(left_node->symbol());
 
     return CalculateNumericResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_MUL);
 }
 
@@ -995,14 +983,12 @@ const SymbolBase* SemanticAstWalker::WalkDiv(
     const SymbolBase* left_result,
     const SymbolBase* right_result) {
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    div_node->set_symbol(left_node->symbol()->Clone());
+    div_node->set_symbol(left_node->symbol());
 
     return CalculateNumericResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_DIV);
 }
 // Walks the MOD node and calculates it's return type.
@@ -1014,14 +1000,12 @@ const SymbolBase* SemanticAstWalker::WalkMod(
     const SymbolBase* left_result,
     const SymbolBase* right_result) {
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    mod_node->set_symbol(left_node->symbol()->Clone());
+    mod_node->set_symbol(left_node->symbol());
 
     return CalculateNumericResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_MOD);
 }
 
@@ -1033,15 +1017,14 @@ const SymbolBase* SemanticAstWalker::WalkLogNot(
     const SymbolBase* child_result) {
 
     // Check for boolean type. NOT works only with booleans.
-    if (*child_result->type_symbol() != TYPE_BOOL) {
+    if (child_result->type_symbol() != &TYPE_BOOL) {
         THROW_EXCEPTION(
-            child_node->line(),
-            child_node->column(),
+            this->lines_.line_number(child_node->offset()),
+            this->lines_.column_number(child_node->offset()),
             STATUS_SEMANTIC_NONBOOL_IN_LOGNOT);
     }
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    log_not_node->set_symbol(child_node->symbol()->Clone());
+    log_not_node->set_symbol(child_node->symbol());
 
     return child_result;
 }
@@ -1055,14 +1038,12 @@ const SymbolBase* SemanticAstWalker::WalkLogAnd(
     const SymbolBase* left_result,
     const SymbolBase* right_result) {
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    log_and_node->set_symbol(left_node->symbol()->Clone());
+    log_and_node->set_symbol(left_node->symbol());
 
     return CalculateBoolResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_LOGAND);
 }
 
@@ -1075,14 +1056,12 @@ const SymbolBase* SemanticAstWalker::WalkLogOr(
     const SymbolBase* left_result,
     const SymbolBase* right_result) {
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    log_or_node->set_symbol(left_node->symbol()->Clone());
+    log_or_node->set_symbol(left_node->symbol());
 
     return CalculateBoolResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_LOGOR);
 }
 
@@ -1100,12 +1079,10 @@ const SymbolBase* SemanticAstWalker::WalkGreater(
     CalculateNumericResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_GREATER);
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    greater_node->set_symbol(left_node->symbol()->Clone());
+    greater_node->set_symbol(left_node->symbol());
 
     // Resultant type is a TYPE_BOOL telling whether comparision is true or false.
     return &TYPE_BOOL;
@@ -1125,12 +1102,10 @@ const SymbolBase* SemanticAstWalker::WalkEquals(
     CalculateResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_EQUALS);
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    equals_node->set_symbol(left_node->symbol()->Clone());
+    equals_node->set_symbol(left_node->symbol());
 
     // Resultant type is a TYPE_BOOL telling whether comparision is true or false.
     return &TYPE_BOOL;
@@ -1150,12 +1125,10 @@ const SymbolBase* SemanticAstWalker::WalkNotEquals(
     CalculateResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_NOT_EQUALS);
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    not_equals_node->set_symbol(left_node->symbol()->Clone());
+    not_equals_node->set_symbol(left_node->symbol());
 
     // Resultant type is a TYPE_BOOL telling whether comparision is true or false.
     return &TYPE_BOOL;
@@ -1175,12 +1148,10 @@ const SymbolBase* SemanticAstWalker::WalkLess(
     CalculateNumericResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_LESS);
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    less_node->set_symbol(left_node->symbol()->Clone());
+    less_node->set_symbol(left_node->symbol());
 
     // Resultant type is a TYPE_BOOL telling whether comparision is true or false.
     return &TYPE_BOOL;
@@ -1200,13 +1171,11 @@ const SymbolBase* SemanticAstWalker::WalkGreaterEquals(
     CalculateNumericResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_GREATER_EQUALS);
 
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    greater_equals_node->set_symbol(left_node->symbol()->Clone());
+    greater_equals_node->set_symbol(left_node->symbol());
 
     // Resultant type is a TYPE_BOOL telling whether comparision is true or false.
     return &TYPE_BOOL;
@@ -1226,13 +1195,11 @@ const SymbolBase* SemanticAstWalker::WalkLessEquals(
     CalculateNumericResultantType(
         left_result,
         right_result,
-        left_node->line(),
-        left_node->column(),
+        left_node->offset(),
         STATUS_SEMANTIC_UNMATCHING_TYPE_IN_LESS_EQUALS);
 
 
-    // Alloc a new copy of the symbol because the node frees its own symbol.
-    less_equals_node->set_symbol(left_node->symbol()->Clone());
+    less_equals_node->set_symbol(left_node->symbol());
 
     // Resultant type is a TYPE_BOOL telling whether comparision is true or false.
     return &TYPE_BOOL;
@@ -1246,8 +1213,7 @@ const SymbolBase* SemanticAstWalker::WalkBool(
     PropertyFunction property_function,
     Node* bool_node) {
 
-    // Alloc copy because ~Node() frees it's symbol on destroy.
-    bool_node->set_symbol(TYPE_BOOL.Clone());
+    bool_node->set_symbol(&TYPE_BOOL);
     return &TYPE_BOOL;
 }
 
@@ -1259,8 +1225,7 @@ const SymbolBase* SemanticAstWalker::WalkInt(
     PropertyFunction property_function,
     Node* int_node) {
 
-    // Alloc copy because ~Node() frees it's symbol on destroy.
-    int_node->set_symbol(TYPE_INT.Clone());
+    int_node->set_symbol(&TYPE_INT);
     return &TYPE_INT;
 }
 
@@ -1272,7 +1237,7 @@ const SymbolBase* SemanticAstWalker::WalkFloat(
     PropertyFunction property_function,
     Node* float_node) {
 
-    float_node->set_symbol(TYPE_FLOAT.Clone());
+    float_node->set_symbol(&TYPE_FLOAT);
     return &TYPE_FLOAT;
 }
 
@@ -1284,8 +1249,7 @@ const SymbolBase* SemanticAstWalker::WalkString(
     PropertyFunction property_function,
     Node* string_node) {
 
-    // Alloc copy because ~Node() destroys the symbol when done.
-    string_node->set_symbol(TYPE_STRING.Clone());
+    string_node->set_symbol(&TYPE_STRING);
     return &TYPE_STRING;
 }
 
@@ -1298,8 +1262,7 @@ const SymbolBase* SemanticAstWalker::WalkChar(
     Node* char_node) {
 
     // Store the symbol in the char node:
-    // Alloc copy because ~Node() destroys the symbol when done.
-    char_node->set_symbol(TYPE_INT.Clone());
+    char_node->set_symbol(&TYPE_INT);
 
     return &TYPE_INT8;
 }
@@ -1314,30 +1277,21 @@ const SymbolBase* SemanticAstWalker::WalkVariable(
     Node* variable_node,
     Node* name_node) {
 
-    const std::string symbol_name = MangleLocalVariableSymbolName(*name_node->string_value());
-
-    try {
-        const SymbolBase* symbol = this->symbol_table_.Get(symbol_name);
+    const Atom symbol_name = MangleLocalVariableSymbolName(this->atoms_, *name_node->string_value());
 
-        // Store the symbol in the variable node:
-        // Alloc copy because ~Node() destroys the symbol when done.
-        variable_node->set_symbol(symbol->Clone());
-
-        // Looks up the variable in the SymbolTable and returns its type.
-        // Throws if the symbol is undefined.
-        return symbol;
-    }
-    catch (const Exception& ex) {
-        if (ex.status() != STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL) {
-            throw;
-        }
-
-        // Throw more relevant exception.
+    // Looks up the variable in the SymbolTable and returns its type.
+    const SymbolBase* const* symbol_entry = this->symbol_table_.Find(symbol_name);
+    if (symbol_entry == NULL) {
         THROW_EXCEPTION(
-            variable_node->column(),
-            variable_node->line(),
+            this->lines_.line_number(variable_node->offset()),
+            this->lines_.column_number(variable_node->offset()),
             STATUS_SEMANTIC_UNDEFINED_VARIABLE);
     }
+
+    // Store the symbol in the variable node:
+    variable_node->set_symbol((*symbol_entry));
+
+    return *symbol_entry;
 }
 
 // Walks the ANY_TYPE node and returns the type for it.
@@ -1357,8 +1311,7 @@ void SemanticAstWalker::CheckAccessModifier(
     const std::string& caller_class,
     const std::string& callee_class,
     LexerSymbol callee_access_modifier,
-    int line,
-    int column) {
+    uint32_t offset) {
 
     switch (callee_access_modifier) {
     case LexerSymbol::PUBLIC:
@@ -1366,8 +1319,8 @@ void SemanticAstWalker::CheckAccessModifier(
     case LexerSymbol::CONCEALED:
         if (caller_class != callee_class) {
             THROW_EXCEPTION(
-                line,
-                column,
+                this->lines_.line_number(offset),
+                this->lines_.column_number(offset),
                 STATUS_SEMANTIC_NOT_ACCESSIBLE);
         }
         break;
@@ -1460,7 +1413,7 @@ const SymbolBase* SemanticAstWalker::WalkExpressionChildren(
         expression_node);
 
     // TODO: cleaner.
-    expression_node->set_symbol(expression_node->child(0)->symbol()->Clone());
+    expression_node->set_symbol(expression_node->child(0)->symbol());
 
     return expression_type;
 }
@@ -1473,32 +1426,23 @@ const SymbolBase* SemanticAstWalker::WalkNewExpression(
 
     // Lookup type of new statement.
     const SymbolBase* type_symbol = ResolveTypeNode(type_node);
-    type_node->set_symbol(type_symbol->Clone());
+    type_node->set_symbol(type_symbol);
 
     // Lookup constructor function.
-    const std::string constructor_name = MangleFunctionSymbolName(
-        MangleSpecTemplateSymbolName(type_node),
-        kConstructorName,
+    const SymbolBase* const* constructor_entry = this->overloads_.Find(
+        OverloadKey(
+            MangleSpecTemplateSymbolName(this->atoms_, type_node),
+            this->atoms_.Find(kConstructorName),
+            PropertyFunction::NONE),
         arguments_result);
-
-    const SymbolBase* constructor_symbol = NULL;
-    try {
-        constructor_symbol = this->symbol_table_.Get(constructor_name);
-    }
-    catch (const Exception& ex) {
-
-        // The symbol for this function is unknown. Either a typo or a function-like typecast.
-        if (ex.status() == STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL) {
-            THROW_EXCEPTION(
-                type_node->line(),
-                type_node->column(),
-                STATUS_SEMANTIC_CONSTRUCTOR_OVERLOAD_NOT_FOUND);
-        }
-
-        throw;
+    if (constructor_entry == NULL) {
+        THROW_EXCEPTION(
+            this->lines_.line_number(type_node->offset()),
+            this->lines_.column_number(type_node->offset()),
+            STATUS_SEMANTIC_CONSTRUCTOR_OVERLOAD_NOT_FOUND);
     }
 
-    new_node->set_symbol(constructor_symbol->Clone());
+    new_node->set_symbol((*constructor_entry));
 
     return type_symbol;
 }
@@ -1510,7 +1454,7 @@ const SymbolBase* SemanticAstWalker::WalkDefaultExpression(
 
     const SymbolBase* type_symbol = ResolveTypeNode(type_node);
 
-    default_node->set_symbol(type_symbol->Clone());
+    default_node->set_symbol(type_symbol);
 
     return type_symbol;
 }
@@ -1520,36 +1464,35 @@ const SymbolBase* SemanticAstWalker::WalkDefaultExpression(
 const SymbolBase* SemanticAstWalker::CalculateResultantType(
     const SymbolBase* left,
     const SymbolBase* right,
-    int line, 
-    int column,
+    uint32_t offset,
     ExceptionStatus type_mismatch_error) {
 
     // We're going to take a stickler model in Gunderscript:
     // you must explicitly typecast everything. There are absolutely no
     // auto conversions between types.
-    if (*left->type_symbol() == *right->type_symbol()) {
+    if (left->type_symbol() == right->type_symbol()) {
         return right;
     }
 
     // Accept TYPE_NONE nodes as matches for any given type.
-    if (*left == TYPE_NONE) {
+    if (left == &TYPE_NONE) {
         return right;
     }
-    if (*right == TYPE_NONE) {
+    if (right == &TYPE_NONE) {
         return left;
     }
 
-    if (*left == TYPE_VOID || *right == TYPE_VOID) {
+    if (left == &TYPE_VOID || right == &TYPE_VOID) {
         // Void function call in expression.
         THROW_EXCEPTION(
-            line, column,
+            this->lines_.line_number(offset), this->lines_.column_number(offset),
             STATUS_SEMANTIC_VOID_USED_IN_EXPR);
     }
     else {
         // Types don't match. Might require a typecast. (e.g.: float to int).
         THROW_EXCEPTION(
-            line,
-            column,
+            this->lines_.line_number(offset),
+            this->lines_.column_number(offset),
             type_mismatch_error);
     }
 
@@ -1561,20 +1504,19 @@ const SymbolBase* SemanticAstWalker::CalculateResultantType(
 const SymbolBase* SemanticAstWalker::CalculateNumericResultantType(
     const SymbolBase* left,
     const SymbolBase* right,
-    int line,
-    int column,
+    uint32_t offset,
     ExceptionStatus type_mismatch_error) {
 
     // Do other checks.
     const TypeSymbol* resultant_type
-        = CalculateResultantType(left, right, line, column, type_mismatch_error)->type_symbol();
+        = CalculateResultantType(left, right, offset, type_mismatch_error)->type_symbol();
 
     // Disallow non-numerical operands.
     if (resultant_type->type_format() != TypeFormat::INT &&
         resultant_type->type_format() != TypeFormat::FLOAT) {
         THROW_EXCEPTION(
-            line,
-            column,
+            this->lines_.line_number(offset),
+            this->lines_.column_number(offset),
             STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
     }
 
@@ -1586,15 +1528,14 @@ const SymbolBase* SemanticAstWalker::CalculateNumericResultantType(
 const SymbolBase* SemanticAstWalker::CalculateBoolResultantType(
     const SymbolBase* left,
     const SymbolBase* right,
-    int line,
-    int column,
+    uint32_t offset,
     ExceptionStatus type_mismatch_error) {
 
     // Both operands must be TYPE_BOOL.
-    if (*left->type_symbol() != TYPE_BOOL || *right->type_symbol() != TYPE_BOOL) {
+    if (left->type_symbol() != &TYPE_BOOL || right->type_symbol() != &TYPE_BOOL) {
         THROW_EXCEPTION(
-            line,
-            column,
+            this->lines_.line_number(offset),
+            this->lines_.column_number(offset),
             STATUS_SEMANTIC_NONBOOL_OPERANDS);
     }
 
@@ -1606,27 +1547,21 @@ const SymbolBase* SemanticAstWalker::CalculateBoolResultantType(
 // happens.
 const SymbolBase* SemanticAstWalker::ResolveTypeNode(Node* type_node) {
 
-    const SymbolBase* type_symbol;
-
     // Look up symbol in symbol table.
-    try {
-        type_symbol = this->symbol_table_.Get(MangleSpecTemplateSymbolName(type_node));
+    const SymbolBase* const* type_entry
+        = this->symbol_table_.Find(MangleSpecTemplateSymbolName(this->atoms_, type_node));
+    if (type_entry == NULL) {
+        THROW_EXCEPTION(
+            this->lines_.line_number(type_node->offset()),
+            this->lines_.column_number(type_node->offset()),
+            STATUS_SEMANTIC_UNDEFINED_TYPE);
     }
-    catch (const Exception& ex) {
-        // Rethrow as more relevant exception.
-        if (ex.status() == STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL) {
-            THROW_EXCEPTION(
-                type_node->line(),
-                type_node->column(),
-                STATUS_SEMANTIC_UNDEFINED_TYPE);
-        }
 
-        throw;
-    }
+    const SymbolBase* type_symbol = *type_entry;
 
     // If this is not a generic type, return the raw type.
     if (type_symbol->symbol_type() != SymbolType::GENERIC_TYPE_TEMPLATE) {
-        type_node->set_symbol(type_symbol->Clone());
+        type_node->set_symbol(type_symbol);
         return type_symbol;
     }
     // else: this is a generic type, continue on to check the type params.
@@ -1644,11 +1579,10 @@ const SymbolBase* SemanticAstWalker::ResolveTypeNode(Node* type_node) {
 
     name_buf << '>';
 
-    // Construct type from the generic type template with the concrete
-    // type params in this usage.
-    const SymbolBase* generic_type_symbol = new GenericTypeSymbol(
-        SymbolType::GENERIC_TYPE,
-        type_symbol->access_modifier(),
+    // Get the type from the generic type template with the concrete type
+    // params in this usage. Every usage with the same params shares it.
+    const SymbolBase* generic_type_symbol = this->arena_.InternGenericType(
+        type_symbol,
         name_buf.str(),
         type_params);
 
@@ -1657,5 +1591,14 @@ const SymbolBase* SemanticAstWalker::ResolveTypeNode(Node* type_node) {
     return generic_type_symbol;
 }
 
+// Gets the OverloadIndex spec key for the functions and properties declared
+// in the spec whose type is spec_symbol. Only looks the spec's name up, it
+// never interns it.
+// spec_symbol: the spec's type, or NULL for static functions.
+// Returns: the spec's name Atom, or an invalid Atom for static functions.
+Atom SemanticAstWalker::SpecAtom(const SymbolBase* spec_symbol) const {
+    return spec_symbol != NULL ? this->atoms_.Find(spec_symbol->symbol_name()) : Atom();
+}
+
 } // namespace compiler
 } // namespace gunderscript
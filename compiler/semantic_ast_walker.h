@@ -7,11 +7,14 @@
 #include <string>
 #include <vector>
 
+#include "gunderscript/atom_table.h"
 #include "gunderscript/lexer_resources.h"
 #include "gunderscript/node.h"
 #include "gunderscript/symbol.h"
 
 #include "ast_walker.h"
+#include "line_table.h"
+#include "overload_index.h"
 #include "symbol_table.h"
 
 namespace gunderscript {
@@ -19,14 +22,18 @@ namespace compiler {
 
 // Type checking abstract syntax tree walker.
 // Walks along the AST and checks for type correctness.
-class SemanticAstWalker : public AstWalker<const SymbolBase*> {
+class SemanticAstWalker : public AstWalker<SemanticAstWalker, const SymbolBase*> {
 public:
 
-    SemanticAstWalker(Node& node);
+    SemanticAstWalker(Node& node, AtomTable& atoms, const LineTable& lines);
 
+    void WalkParallel(unsigned int thread_count);
     const SymbolTable<const SymbolBase*>& symbol_table() const { return symbol_table_; }
 
 protected:
+    // AstWalker dispatches to the Walk methods directly.
+    friend class AstWalker<SemanticAstWalker, const SymbolBase*>;
+
     void WalkModule(Node* module_node);
     void WalkModuleName(Node* name_node);
     void WalkModuleDependsName(Node* name_node);
@@ -67,8 +74,8 @@ protected:
         std::vector<const SymbolBase*>& arguments_result);
     const SymbolBase* WalkFunctionCall(
         Node* spec_node,
-        const std::string& spec_name,
-        const std::string& function_name,
+        const SymbolBase* spec_symbol,
+        Atom function_name,
         Node* call_node,
         std::vector<const SymbolBase*>& arguments_result);
     const SymbolBase* WalkMemberFunctionCall(
@@ -277,34 +284,41 @@ protected:
         Node* type_node);
      
 private:
+    AtomTable& atoms_;
+    const LineTable& lines_;
+    NodeArena& arena_;
     SymbolTable<const SymbolBase*> symbol_table_;
+    OverloadIndex<const SymbolBase*> overloads_;
 
-    void CheckValidModuleName(const std::string& module_name, int line, int column);
+    SemanticAstWalker(
+        Node& node,
+        AtomTable& atoms,
+        const LineTable& lines,
+        const SymbolTable<const SymbolBase*>& global_table,
+        const OverloadIndex<const SymbolBase*>& global_overloads);
+    void CheckValidModuleName(const std::string& module_name, uint32_t offset);
     void CheckAccessModifier(
         const std::string& caller_class,
         const std::string& callee_class,
         LexerSymbol callee_access_modifier,
-        int line,
-        int column);
+        uint32_t offset);
     const SymbolBase* CalculateResultantType(
         const SymbolBase* left,
         const SymbolBase* right,
-        int line,
-        int column,
+        uint32_t offset,
         ExceptionStatus type_mismatch_error);
     const SymbolBase* CalculateNumericResultantType(
         const SymbolBase* left, 
         const SymbolBase* right,
-        int line,
-        int column,
+        uint32_t offset,
         ExceptionStatus type_mismatch_error);
     const SymbolBase* CalculateBoolResultantType(
         const SymbolBase* left,
         const SymbolBase* right,
-        int line,
-        int column,
+        uint32_t offset,
         ExceptionStatus type_mismatch_error);
     const SymbolBase* ResolveTypeNode(Node* type_node);
+    Atom SpecAtom(const SymbolBase* spec_symbol) const;
     const SymbolBase* TypeCheckProperty(
         Node* spec_node,
         Node* member_node,
@@ -15,6 +15,22 @@ using gunderscript::compiler::Lexer;
 using gunderscript::compiler::Parser;
 using gunderscript::compiler::SemanticAstWalker;
 
+// Checks that two type checked trees have the same symbols on the same nodes.
+static void ExpectSameSymbols(const Node* expected, const Node* actual) {
+    ASSERT_EQ(expected->rule(), actual->rule());
+    ASSERT_EQ(expected->child_count(), actual->child_count());
+    ASSERT_EQ(expected->symbol() == NULL, actual->symbol() == NULL);
+
+    if (expected->symbol() != NULL) {
+        EXPECT_EQ(expected->symbol()->symbol_type(), actual->symbol()->symbol_type());
+        EXPECT_EQ(expected->symbol()->symbol_name(), actual->symbol()->symbol_name());
+    }
+
+    for (size_t i = 0; i < expected->child_count(); i++) {
+        ExpectSameSymbols(expected->child(i), actual->child(i));
+    }
+}
+
 // This module tests the semantic checker layer for Gunderscript 2.
 // The tests cover only the expected positive and negative cases from
 // ASTs generated by the parser and do not check for the STATUS_ILLEGAL_STATE
@@ -29,11 +45,9 @@ TEST(SemanticAstWalker, ModuleNameTrailingPeriodThrows) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_PACKAGE);
-
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModuleNameEmptyThrows) {
@@ -45,11 +59,9 @@ TEST(SemanticAstWalker, ModuleNameEmptyThrows) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_PACKAGE);
-
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModuleNameOnlyPeriodThrows) {
@@ -60,11 +72,9 @@ TEST(SemanticAstWalker, ModuleNameOnlyPeriodThrows) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_PACKAGE);
-
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModuleNameStartsWithPeriodThrows) {
@@ -75,11 +85,9 @@ TEST(SemanticAstWalker, ModuleNameStartsWithPeriodThrows) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_PACKAGE);
-
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModuleDependsNameTrailingPeriodThrows) {
@@ -92,11 +100,9 @@ TEST(SemanticAstWalker, ModuleDependsNameTrailingPeriodThrows) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_PACKAGE);
-
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModuleDependsNameEmptyThrows) {
@@ -109,11 +115,9 @@ TEST(SemanticAstWalker, ModuleDependsNameEmptyThrows) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_PACKAGE);
-
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModuleDependsNameOnlyPeriodThrows) {
@@ -126,11 +130,9 @@ TEST(SemanticAstWalker, ModuleDependsNameOnlyPeriodThrows) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_PACKAGE);
-
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModuleDependsNameStartsWithPeriodThrows) {
@@ -143,11 +145,9 @@ TEST(SemanticAstWalker, ModuleDependsNameStartsWithPeriodThrows) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_PACKAGE);
-
-    delete root;
 }
 
 TEST(SemanticAstWalker, SpecDuplicateDefinition) {
@@ -161,10 +161,9 @@ TEST(SemanticAstWalker, SpecDuplicateDefinition) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_DUPLICATE_SPEC);
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionDuplicateDefinition) {
@@ -180,10 +179,9 @@ TEST(SemanticAstWalker, FunctionDuplicateDefinition) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_DUPLICATE_FUNCTION);
-    delete root;
 }
 
 TEST(SemanticAstWalker, StaticFunctionDuplicateDefinition) {
@@ -197,10 +195,9 @@ TEST(SemanticAstWalker, StaticFunctionDuplicateDefinition) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_DUPLICATE_FUNCTION);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AutoPropertyDuplicateDefinition) {
@@ -216,10 +213,9 @@ TEST(SemanticAstWalker, AutoPropertyDuplicateDefinition) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_DUPLICATE_PROPERTY);
-    delete root;
 }
 
 TEST(SemanticAstWalker, PropertyWithBodyDuplicateDefinition) {
@@ -235,10 +231,9 @@ TEST(SemanticAstWalker, PropertyWithBodyDuplicateDefinition) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
     
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_DUPLICATE_PROPERTY);
-    delete root;
 }
 
 TEST(SemanticAstWalker, MixedAutoAndExpandedProperties) {
@@ -255,10 +250,9 @@ TEST(SemanticAstWalker, MixedAutoAndExpandedProperties) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 
     // Case 2:
@@ -274,10 +268,9 @@ TEST(SemanticAstWalker, MixedAutoAndExpandedProperties) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 }
 
@@ -293,10 +286,9 @@ TEST(SemanticAstWalker, FunctionCallWithInvalidParameter) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionCallWithInvalidParameterStatic) {
@@ -309,10 +301,9 @@ TEST(SemanticAstWalker, FunctionCallWithInvalidParameterStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionCallNeedingTypecastedParameter) {
@@ -328,10 +319,9 @@ TEST(SemanticAstWalker, FunctionCallNeedingTypecastedParameter) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionCallNeedingTypecastedParameterStatic) {
@@ -345,10 +335,9 @@ TEST(SemanticAstWalker, FunctionCallNeedingTypecastedParameterStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionOverloads) {
@@ -364,10 +353,9 @@ TEST(SemanticAstWalker, FunctionOverloads) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionOverloadsStatic) {
@@ -381,10 +369,9 @@ TEST(SemanticAstWalker, FunctionOverloadsStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, DuplicateFunctions) {
@@ -402,10 +389,9 @@ TEST(SemanticAstWalker, DuplicateFunctions) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_DUPLICATE_FUNCTION);
-        delete root;
     }
 
     // Case 2: different same params AND return type.
@@ -422,10 +408,9 @@ TEST(SemanticAstWalker, DuplicateFunctions) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_DUPLICATE_FUNCTION);
-        delete root;
     }
 }
 
@@ -442,10 +427,9 @@ TEST(SemanticAstWalker, DuplicateFunctionsStatic) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_DUPLICATE_FUNCTION);
-        delete root;
     }
 
     // Case 2: different same params AND return type.
@@ -460,10 +444,9 @@ TEST(SemanticAstWalker, DuplicateFunctionsStatic) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_DUPLICATE_FUNCTION);
-        delete root;
     }
 }
 
@@ -483,10 +466,9 @@ TEST(SemanticAstWalker, FunctionAndPropertyAndVariableShareName) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionParamTypeSymbols) {
@@ -504,10 +486,9 @@ TEST(SemanticAstWalker, FunctionParamTypeSymbols) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionParamTypeSymbolsStatic) {
@@ -523,10 +504,9 @@ TEST(SemanticAstWalker, FunctionParamTypeSymbolsStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionParamSymbolTypeReassign) {
@@ -545,10 +525,9 @@ TEST(SemanticAstWalker, FunctionParamSymbolTypeReassign) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionParamSymbolTypeReassignStatic) {
@@ -565,10 +544,9 @@ TEST(SemanticAstWalker, FunctionParamSymbolTypeReassignStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, AttemptCrossTypeOperations) {
@@ -587,10 +565,9 @@ TEST(SemanticAstWalker, AttemptCrossTypeOperations) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNMATCHING_TYPE_IN_ADD);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AttemptCrossTypeOperationsStatic) {
@@ -607,10 +584,9 @@ TEST(SemanticAstWalker, AttemptCrossTypeOperationsStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNMATCHING_TYPE_IN_ADD);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AttemptTypeReassignment) {
@@ -630,10 +606,9 @@ TEST(SemanticAstWalker, AttemptTypeReassignment) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_TYPE_MISMATCH_IN_ASSIGN);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AttemptTypeReassignmentStatic) {
@@ -651,10 +626,9 @@ TEST(SemanticAstWalker, AttemptTypeReassignmentStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_TYPE_MISMATCH_IN_ASSIGN);
-    delete root;
 }
 
 TEST(SemanticAstWalker, MemberFunctionsOutOfOrder) {
@@ -678,10 +652,9 @@ TEST(SemanticAstWalker, MemberFunctionsOutOfOrder) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionsOutOfOrderStatic) {
@@ -703,10 +676,9 @@ TEST(SemanticAstWalker, FunctionsOutOfOrderStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionCorrectReturnStatement) {
@@ -724,10 +696,9 @@ TEST(SemanticAstWalker, FunctionCorrectReturnStatement) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionCorrectReturnStatementStatic) {
@@ -743,10 +714,9 @@ TEST(SemanticAstWalker, FunctionCorrectReturnStatementStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionIncorrectReturnStatement) {
@@ -764,10 +734,9 @@ TEST(SemanticAstWalker, FunctionIncorrectReturnStatement) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionIncorrectReturnStatementStatic) {
@@ -783,10 +752,9 @@ TEST(SemanticAstWalker, FunctionIncorrectReturnStatementStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
-    delete root;
 }
 
 TEST(SemanticAstWalker, BlockStatementScoping) {
@@ -806,10 +774,9 @@ TEST(SemanticAstWalker, BlockStatementScoping) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, BlockStatementScopingStatic) {
@@ -827,10 +794,9 @@ TEST(SemanticAstWalker, BlockStatementScopingStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, PropertyReturnCorrectly) {
@@ -849,10 +815,9 @@ TEST(SemanticAstWalker, PropertyReturnCorrectly) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, PropertyReturnFromSet) {
@@ -871,10 +836,9 @@ TEST(SemanticAstWalker, PropertyReturnFromSet) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_FROM_PROPERTY_SET);
-    delete root;
 }
 
 TEST(SemanticAstWalker, PropertyReturnInvalidType) {
@@ -893,10 +857,9 @@ TEST(SemanticAstWalker, PropertyReturnInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AddInvalidType) {
@@ -913,10 +876,9 @@ TEST(SemanticAstWalker, AddInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNMATCHING_TYPE_IN_ADD);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AddInvalidTypeStatic) {
@@ -931,10 +893,9 @@ TEST(SemanticAstWalker, AddInvalidTypeStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNMATCHING_TYPE_IN_ADD);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AddString) {
@@ -949,10 +910,9 @@ TEST(SemanticAstWalker, AddString) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, AddStringStatic) {
@@ -967,10 +927,9 @@ TEST(SemanticAstWalker, AddStringStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, AddBool) {
@@ -987,10 +946,9 @@ TEST(SemanticAstWalker, AddBool) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_TYPE_IN_ADD);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AddBoolStatic) {
@@ -1005,10 +963,9 @@ TEST(SemanticAstWalker, AddBoolStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_TYPE_IN_ADD);
-    delete root;
 }
 
 TEST(SemanticAstWalker, SubtractString) {
@@ -1025,10 +982,9 @@ TEST(SemanticAstWalker, SubtractString) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, SubtractStringStatic) {
@@ -1043,10 +999,9 @@ TEST(SemanticAstWalker, SubtractStringStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModString) {
@@ -1063,10 +1018,9 @@ TEST(SemanticAstWalker, ModString) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModStringStatic) {
@@ -1081,10 +1035,9 @@ TEST(SemanticAstWalker, ModStringStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, MulInvalidType) {
@@ -1101,10 +1054,9 @@ TEST(SemanticAstWalker, MulInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, MulInvalidTypeStatic) {
@@ -1119,10 +1071,9 @@ TEST(SemanticAstWalker, MulInvalidTypeStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, DivInvalidType) {
@@ -1139,10 +1090,9 @@ TEST(SemanticAstWalker, DivInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, DivInvalidTypeStatic) {
@@ -1157,10 +1107,9 @@ TEST(SemanticAstWalker, DivInvalidTypeStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AndInvalidType) {
@@ -1177,10 +1126,9 @@ TEST(SemanticAstWalker, AndInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONBOOL_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AndInvalidTypeStatic) {
@@ -1195,10 +1143,9 @@ TEST(SemanticAstWalker, AndInvalidTypeStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONBOOL_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, OrInvalidType) {
@@ -1215,10 +1162,9 @@ TEST(SemanticAstWalker, OrInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONBOOL_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, OrInvalidTypeStatic) {
@@ -1233,10 +1179,9 @@ TEST(SemanticAstWalker, OrInvalidTypeStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONBOOL_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, GreaterInvalidTypeStatic) {
@@ -1251,10 +1196,9 @@ TEST(SemanticAstWalker, GreaterInvalidTypeStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, LessInvalidType) {
@@ -1271,10 +1215,9 @@ TEST(SemanticAstWalker, LessInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, LessInvalidTypeStatic) {
@@ -1289,10 +1232,9 @@ TEST(SemanticAstWalker, LessInvalidTypeStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, GreaterEqualsInvalidType) {
@@ -1309,10 +1251,9 @@ TEST(SemanticAstWalker, GreaterEqualsInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, GreaterEqualsInvalidTypeStatic) {
@@ -1327,10 +1268,9 @@ TEST(SemanticAstWalker, GreaterEqualsInvalidTypeStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 
@@ -1346,10 +1286,9 @@ TEST(SemanticAstWalker, LessEqualsInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NONNUMERIC_OPERANDS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionInAssign) {
@@ -1367,10 +1306,9 @@ TEST(SemanticAstWalker, FunctionInAssign) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionInAssignStatic) {
@@ -1385,10 +1323,9 @@ TEST(SemanticAstWalker, FunctionInAssignStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastIntToInt) {
@@ -1405,10 +1342,9 @@ TEST(SemanticAstWalker, TypecastIntToInt) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastIntToIntStatic) {
@@ -1423,10 +1359,9 @@ TEST(SemanticAstWalker, TypecastIntToIntStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastIntToFloat) {
@@ -1443,10 +1378,9 @@ TEST(SemanticAstWalker, TypecastIntToFloat) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastIntToChar) {
@@ -1463,10 +1397,9 @@ TEST(SemanticAstWalker, TypecastIntToChar) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastIntToBool) {
@@ -1483,10 +1416,9 @@ TEST(SemanticAstWalker, TypecastIntToBool) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastFloatToFloat) {
@@ -1503,10 +1435,9 @@ TEST(SemanticAstWalker, TypecastFloatToFloat) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastFloatToInt) {
@@ -1523,10 +1454,9 @@ TEST(SemanticAstWalker, TypecastFloatToInt) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastFloatToBool) {
@@ -1543,10 +1473,9 @@ TEST(SemanticAstWalker, TypecastFloatToBool) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNSUPPORTED_TYPECAST);
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastFloatToChar) {
@@ -1563,10 +1492,9 @@ TEST(SemanticAstWalker, TypecastFloatToChar) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastBoolToBool) {
@@ -1583,10 +1511,9 @@ TEST(SemanticAstWalker, TypecastBoolToBool) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastBoolToFloat) {
@@ -1603,10 +1530,9 @@ TEST(SemanticAstWalker, TypecastBoolToFloat) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastBoolToChar) {
@@ -1623,10 +1549,9 @@ TEST(SemanticAstWalker, TypecastBoolToChar) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastBoolToInt) {
@@ -1643,10 +1568,9 @@ TEST(SemanticAstWalker, TypecastBoolToInt) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastCharToBool) {
@@ -1663,10 +1587,9 @@ TEST(SemanticAstWalker, TypecastCharToBool) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastCharToFloat) {
@@ -1683,10 +1606,9 @@ TEST(SemanticAstWalker, TypecastCharToFloat) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastCharToInt) {
@@ -1703,10 +1625,9 @@ TEST(SemanticAstWalker, TypecastCharToInt) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, TypecastCharToChar) {
@@ -1723,10 +1644,9 @@ TEST(SemanticAstWalker, TypecastCharToChar) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 // TODO: support this in the future, but not yet.
@@ -1744,10 +1664,9 @@ TEST(SemanticAstWalker, TypecastStringToInt) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNSUPPORTED_TYPECAST);
-    delete root;
 }
 
 TEST(SemanticAstWalker, Combined) {
@@ -1765,10 +1684,9 @@ TEST(SemanticAstWalker, Combined) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, CombinedStatic) {
@@ -1783,10 +1701,9 @@ TEST(SemanticAstWalker, CombinedStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, AddChars) {
@@ -1803,10 +1720,9 @@ TEST(SemanticAstWalker, AddChars) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, SubChars) {
@@ -1823,10 +1739,9 @@ TEST(SemanticAstWalker, SubChars) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, MulChars) {
@@ -1843,10 +1758,9 @@ TEST(SemanticAstWalker, MulChars) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, DivChars) {
@@ -1863,10 +1777,9 @@ TEST(SemanticAstWalker, DivChars) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, ModChars) {
@@ -1883,10 +1796,9 @@ TEST(SemanticAstWalker, ModChars) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, StoreAndLoadChars) {
@@ -1904,10 +1816,9 @@ TEST(SemanticAstWalker, StoreAndLoadChars) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, StoreAndLoadCharsStatic) {
@@ -1923,10 +1834,9 @@ TEST(SemanticAstWalker, StoreAndLoadCharsStatic) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, CallStaticFromMember) {
@@ -1949,10 +1859,9 @@ TEST(SemanticAstWalker, CallStaticFromMember) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 
     // Case 2: Function comes before spec.
@@ -1974,10 +1883,9 @@ TEST(SemanticAstWalker, CallStaticFromMember) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 }
 
@@ -1993,10 +1901,9 @@ TEST(SemanticAstWalker, IfStatementCorrectConditionType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, IfStatementIncorrectConditionType) {
@@ -2011,10 +1918,9 @@ TEST(SemanticAstWalker, IfStatementIncorrectConditionType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_IF_CONDITION_TYPE);
-    delete root;
 }
 
 // Checks to make sure that return type is still checked in if/else body, and by
@@ -2033,10 +1939,9 @@ TEST(SemanticAstWalker, IfStatementReturnTypeChecking) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
-        delete root;
     }
     
     // Case 2: Bad return type in else.
@@ -2054,10 +1959,9 @@ TEST(SemanticAstWalker, IfStatementReturnTypeChecking) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
-        delete root;
     }
 }
 
@@ -2074,10 +1978,9 @@ TEST(SemanticAstWalker, ForStatementInitSemanticError) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_TYPE_MISMATCH_IN_ASSIGN);
-    delete root;
 }
 
 TEST(SemanticAstWalker, ForStatementCondInvalidType) {
@@ -2093,10 +1996,9 @@ TEST(SemanticAstWalker, ForStatementCondInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_LOOP_CONDITION_TYPE);
-    delete root;
 }
 
 TEST(SemanticAstWalker, ForStatementCondSemanticError) {
@@ -2112,10 +2014,9 @@ TEST(SemanticAstWalker, ForStatementCondSemanticError) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNMATCHING_TYPE_IN_LESS);
-    delete root;
 }
 
 TEST(SemanticAstWalker, ForStatementUpdateSemanticError) {
@@ -2131,10 +2032,9 @@ TEST(SemanticAstWalker, ForStatementUpdateSemanticError) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_TYPE_MISMATCH_IN_ASSIGN);
-    delete root;
 }
 
 TEST(SemanticAstWalker, ForStatementInvalidReturnType) {
@@ -2149,10 +2049,9 @@ TEST(SemanticAstWalker, ForStatementInvalidReturnType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
-    delete root;
 }
 
 TEST(SemanticAstWalker, CorrectForStatement) {
@@ -2169,10 +2068,9 @@ TEST(SemanticAstWalker, CorrectForStatement) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 
     // Case 2: Init only.
@@ -2188,10 +2086,9 @@ TEST(SemanticAstWalker, CorrectForStatement) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 
     // Case 3: Condition only.
@@ -2208,10 +2105,9 @@ TEST(SemanticAstWalker, CorrectForStatement) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 
     // Case 4: Update only.
@@ -2228,10 +2124,9 @@ TEST(SemanticAstWalker, CorrectForStatement) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 
     // Case 5: Init and condition.
@@ -2247,10 +2142,9 @@ TEST(SemanticAstWalker, CorrectForStatement) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 
     // Case 6: Condition and update.
@@ -2267,10 +2161,9 @@ TEST(SemanticAstWalker, CorrectForStatement) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 
     // Case 7: Init and update.
@@ -2286,10 +2179,9 @@ TEST(SemanticAstWalker, CorrectForStatement) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 
     // Case 8: All.
@@ -2305,10 +2197,9 @@ TEST(SemanticAstWalker, CorrectForStatement) {
 
         Node* root = parser.Parse();
 
-        SemanticAstWalker semantic_walker(*root);
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
         EXPECT_NO_THROW(semantic_walker.Walk());
-        delete root;
     }
 }
 
@@ -2324,10 +2215,9 @@ TEST(SemanticAstWalker, UndefinedVariable) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNDEFINED_VARIABLE);
-    delete root;
 }
 
 TEST(SemanticAstWalker, CorrectOutOfOrderSpec) {
@@ -2350,10 +2240,9 @@ TEST(SemanticAstWalker, CorrectOutOfOrderSpec) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, CorrectOutOfOrderSpecWithGenerics) {
@@ -2369,10 +2258,9 @@ TEST(SemanticAstWalker, CorrectOutOfOrderSpecWithGenerics) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, SpecGenericMissingParam) {
@@ -2388,10 +2276,9 @@ TEST(SemanticAstWalker, SpecGenericMissingParam) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNDEFINED_TYPE);
-    delete root;
 }
 
 TEST(SemanticAstWalker, SpecGenericExtraParam) {
@@ -2407,10 +2294,9 @@ TEST(SemanticAstWalker, SpecGenericExtraParam) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNDEFINED_TYPE);
-    delete root;
 }
 
 TEST(SemanticAstWalker, SpecGenericParamCollidesWithType) {
@@ -2425,10 +2311,9 @@ TEST(SemanticAstWalker, SpecGenericParamCollidesWithType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, SpecGenericDuplicateParam) {
@@ -2442,10 +2327,9 @@ TEST(SemanticAstWalker, SpecGenericDuplicateParam) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_GENERIC_DUPLICATE_PARAM);
-    delete root;
 }
 
 // Ensures that generic params don't live beyond their specs.
@@ -2461,10 +2345,9 @@ TEST(SemanticAstWalker, SpecGenericParamLifetime) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNDEFINED_TYPE);
-    delete root;
 }
 
 TEST(SemanticAstWalker, EndToEndNewGenericTestFailure) {
@@ -2484,10 +2367,9 @@ TEST(SemanticAstWalker, EndToEndNewGenericTestFailure) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
-    delete root;
 }
 
 TEST(SemanticAstWalker, NestedTypeGenericTestFailure) {
@@ -2506,10 +2388,9 @@ TEST(SemanticAstWalker, NestedTypeGenericTestFailure) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
-    delete root;
 }
 
 TEST(SemanticAstWalker, InvalidConstructorOverload) {
@@ -2526,10 +2407,9 @@ TEST(SemanticAstWalker, InvalidConstructorOverload) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_CONSTRUCTOR_OVERLOAD_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, EndToEndNewGenericTestPass) {
@@ -2560,10 +2440,9 @@ TEST(SemanticAstWalker, EndToEndNewGenericTestPass) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, VoidFunctionCall) {
@@ -2581,10 +2460,9 @@ TEST(SemanticAstWalker, VoidFunctionCall) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, VoidFunctionCallAttemptedReturn) {
@@ -2602,10 +2480,9 @@ TEST(SemanticAstWalker, VoidFunctionCallAttemptedReturn) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_IN_VOID);
-    delete root;
 }
 
 TEST(SemanticAstWalker, VoidFunctionCallUsedInReturn) {
@@ -2623,10 +2500,9 @@ TEST(SemanticAstWalker, VoidFunctionCallUsedInReturn) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_VOID_USED_IN_EXPR);
-    delete root;
 }
 
 TEST(SemanticAstWalker, VoidFunctionCallUsedInExpr) {
@@ -2644,10 +2520,9 @@ TEST(SemanticAstWalker, VoidFunctionCallUsedInExpr) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_VOID_USED_IN_EXPR);
-    delete root;
 }
 
 TEST(SemanticAstWalker, VoidFunctionCallAttemptedAssign) {
@@ -2665,10 +2540,9 @@ TEST(SemanticAstWalker, VoidFunctionCallAttemptedAssign) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_VOID_USED_IN_EXPR);
-    delete root;
 }
 
 TEST(SemanticAstWalker, VoidFunctionCallUsedInCast) {
@@ -2686,10 +2560,9 @@ TEST(SemanticAstWalker, VoidFunctionCallUsedInCast) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_VOID_USED_IN_EXPR);
-    delete root;
 }
 
 TEST(SemanticAstWalker, VoidParamType) {
@@ -2705,10 +2578,9 @@ TEST(SemanticAstWalker, VoidParamType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_VOID_USED_IN_PARAM);
-    delete root;
 }
 
 TEST(SemanticAstWalker, NewExprNonSpec) {
@@ -2726,10 +2598,9 @@ TEST(SemanticAstWalker, NewExprNonSpec) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_CONSTRUCTOR_OVERLOAD_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, NewExprInvalidType) {
@@ -2747,10 +2618,9 @@ TEST(SemanticAstWalker, NewExprInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNDEFINED_TYPE);
-    delete root;
 }
 
 TEST(SemanticAstWalker, DefaultExprCorrectUsage) {
@@ -2770,10 +2640,9 @@ TEST(SemanticAstWalker, DefaultExprCorrectUsage) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, DefaultExprInvalidType) {
@@ -2793,10 +2662,9 @@ TEST(SemanticAstWalker, DefaultExprInvalidType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_TYPE_MISMATCH_IN_ASSIGN);
-    delete root;
 }
 
 TEST(SemanticAstWalker, FunctionAsType) {
@@ -2811,10 +2679,9 @@ TEST(SemanticAstWalker, FunctionAsType) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_UNDEFINED_TYPE);
-    delete root;
 }
 
 TEST(SemanticAstWalker, MemberFunctionCall) {
@@ -2838,10 +2705,9 @@ TEST(SemanticAstWalker, MemberFunctionCall) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, MemberFunctionCallInvalidOverload) {
@@ -2865,10 +2731,9 @@ TEST(SemanticAstWalker, MemberFunctionCallInvalidOverload) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, MemberFunctionCallInvalidName) {
@@ -2892,10 +2757,9 @@ TEST(SemanticAstWalker, MemberFunctionCallInvalidName) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_FUNCTION_OVERLOAD_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, AttemptToAssignThis) {
@@ -2914,10 +2778,9 @@ TEST(SemanticAstWalker, AttemptToAssignThis) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_THIS_ASSIGNED);
-    delete root;
 }
 
 TEST(SemanticAstWalker, ValidGetSetProperty) {
@@ -2939,10 +2802,9 @@ TEST(SemanticAstWalker, ValidGetSetProperty) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, ValidGetPropertyWithConcealedSetter) {
@@ -2964,10 +2826,9 @@ TEST(SemanticAstWalker, ValidGetPropertyWithConcealedSetter) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, ValidSetPropertyWithConcealedGetter) {
@@ -2989,10 +2850,9 @@ TEST(SemanticAstWalker, ValidSetPropertyWithConcealedGetter) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_NO_THROW(semantic_walker.Walk());
-    delete root;
 }
 
 TEST(SemanticAstWalker, InaccessibleSetProperty) {
@@ -3014,10 +2874,9 @@ TEST(SemanticAstWalker, InaccessibleSetProperty) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NOT_ACCESSIBLE);
-    delete root;
 }
 
 TEST(SemanticAstWalker, InaccessibleGetProperty) {
@@ -3039,10 +2898,9 @@ TEST(SemanticAstWalker, InaccessibleGetProperty) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_NOT_ACCESSIBLE);
-    delete root;
 }
 
 TEST(SemanticAstWalker, NonexistentGetProperty) {
@@ -3064,10 +2922,9 @@ TEST(SemanticAstWalker, NonexistentGetProperty) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_PROPERTY_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, NonExistentSetProperty) {
@@ -3089,10 +2946,9 @@ TEST(SemanticAstWalker, NonExistentSetProperty) {
 
     Node* root = parser.Parse();
 
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_PROPERTY_NOT_FOUND);
-    delete root;
 }
 
 TEST(SemanticAstWalker, InvalidWhileType) {
@@ -3106,11 +2962,9 @@ TEST(SemanticAstWalker, InvalidWhileType) {
     Parser parser(lexer);
 
     Node* root = parser.Parse();
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_INVALID_LOOP_CONDITION_TYPE);
-
-    delete root;
 }
 
 TEST(SemanticAstWalker, InvalidWhileReturnType) {
@@ -3124,9 +2978,94 @@ TEST(SemanticAstWalker, InvalidWhileReturnType) {
     Parser parser(lexer);
 
     Node* root = parser.Parse();
-    SemanticAstWalker semantic_walker(*root);
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
 
     EXPECT_STATUS(semantic_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
+}
 
-    delete root;
-}
\ No newline at end of file
+TEST(SemanticAstWalker, WalkParallelMatchesWalk) {
+    std::string input("package \"FooPackage\";"
+        "public int32 main() {"
+        "    x <- new Foo(2);"
+        "    for (i <- 0; i < 3; i <- i + 1) { x.X <- x.X + i; }"
+        "    return x.Bar() + foo(x.X);"
+        "}"
+        "public spec Foo {"
+        "    int32 X { public get; public set; }"
+        "    public construct(int32 x) { if (x > 1) { this.X <- x; } }"
+        "    public int32 Bar() { y <- new Baz<Foo>(); return this.X * 2; }"
+        "}"
+        "public spec Baz<T> {"
+        "    public construct() { y <- default(T); z <- default(Baz<T>); }"
+        "}"
+        "public int32 foo(int32 a) { b <- float32(a) / 2.0; return int32(b); }"
+        "concealed void baz() { }");
+
+    CompilerStringSource serial_source(input);
+    Lexer serial_lexer(serial_source);
+    Parser serial_parser(serial_lexer);
+    Node* serial_root = serial_parser.Parse();
+    SemanticAstWalker serial_walker(*serial_root, serial_lexer.atoms(), serial_lexer.lines());
+    serial_walker.Walk();
+
+    for (unsigned int thread_count = 1; thread_count <= 4; thread_count++) {
+        CompilerStringSource parallel_source(input);
+        Lexer parallel_lexer(parallel_source);
+        Parser parallel_parser(parallel_lexer);
+        Node* parallel_root = parallel_parser.Parse();
+        SemanticAstWalker parallel_walker(*parallel_root, parallel_lexer.atoms(), parallel_lexer.lines());
+
+        EXPECT_NO_THROW(parallel_walker.WalkParallel(thread_count));
+        ExpectSameSymbols(serial_root, parallel_root);
+    }
+}
+
+TEST(SemanticAstWalker, WalkParallelReportsFirstErrorLikeWalk) {
+    // Walk() checks functions before specs, so both report the error in foo()
+    // even though the one in the spec comes first in the source.
+    std::string input("package \"FooPackage\";"
+        "public spec Foo {"
+        "    public construct() { z <- true; z <- 1; }"
+        "}"
+        "public int32 main() {"
+        "    return 0;"
+        "}"
+        "public int32 foo() {"
+        "    return false;"
+        "}");
+
+    CompilerStringSource serial_source(input);
+    Lexer serial_lexer(serial_source);
+    Parser serial_parser(serial_lexer);
+    Node* serial_root = serial_parser.Parse();
+    SemanticAstWalker serial_walker(*serial_root, serial_lexer.atoms(), serial_lexer.lines());
+
+    EXPECT_STATUS(serial_walker.Walk(), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
+
+    for (unsigned int thread_count = 1; thread_count <= 4; thread_count++) {
+        CompilerStringSource source(input);
+        Lexer lexer(source);
+        Parser parser(lexer);
+        Node* root = parser.Parse();
+        SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
+
+        EXPECT_STATUS(semantic_walker.WalkParallel(thread_count), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
+    }
+}
+
+TEST(SemanticAstWalker, WalkParallelDeclarationErrors) {
+    // Declarations are checked before any implementation.
+    std::string input("package \"FooPackage\";"
+        "public int32 main() {"
+        "    while (3) { }"
+        "}"
+        "public void foo(void x) { }");
+
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    Parser parser(lexer);
+    Node* root = parser.Parse();
+    SemanticAstWalker semantic_walker(*root, lexer.atoms(), lexer.lines());
+
+    EXPECT_STATUS(semantic_walker.WalkParallel(2), STATUS_SEMANTIC_VOID_USED_IN_PARAM);
+}
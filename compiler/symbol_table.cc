@@ -19,10 +19,28 @@ template class SymbolTable<std::tuple<const SymbolBase*, LIns*, int>>;
 template class SymbolTable<std::string>;
 template class SymbolTable<const SymbolBase*>;
 
+// Initial number of hash slots in a SymbolTable. Must be a power of two.
+static const size_t kSymbolTableInitialSlots = 64;
+
 // Default Constructor, creates empty SymbolTable with
 // automatic minimum depth of 1.
 template <typename ValueType>
-SymbolTable<ValueType>::SymbolTable() {
+SymbolTable<ValueType>::SymbolTable()
+    : slots_(kSymbolTableInitialSlots, Slot()),
+    key_count_(0),
+    global_table_(NULL) {
+    this->Push();
+}
+
+// Constructor, creates empty SymbolTable that looks up symbols that it
+// doesn't define in global_table.
+// global_table: the table to fall back on. It is never modified through this
+// table and must outlive it.
+template <typename ValueType>
+SymbolTable<ValueType>::SymbolTable(const SymbolTable* global_table)
+    : slots_(kSymbolTableInitialSlots, Slot()),
+    key_count_(0),
+    global_table_(global_table) {
     this->Push();
 }
 
@@ -31,8 +49,7 @@ SymbolTable<ValueType>::SymbolTable() {
 // block of code.
 template <typename ValueType>
 void SymbolTable<ValueType>::Push() {
-    this->map_vector_.push_back(
-        std::unordered_map<std::string, ValueType, std::hash<std::string> >());
+    this->scope_marks_.push_back(this->bindings_.size());
 }
 
 // Pops a level of scope off of the SymbolTable. This is
@@ -43,7 +60,7 @@ template <typename ValueType>
 void SymbolTable<ValueType>::Pop() {
 
     // Check that there are items left to pop.
-    if (this->map_vector_.size() == 1) {
+    if (this->scope_marks_.size() == 1) {
         // Never thrown in normal operation, the numbers are arbitrary.
         THROW_EXCEPTION(
             1,
@@ -51,7 +68,18 @@ void SymbolTable<ValueType>::Pop() {
             STATUS_SYMBOLTABLE_BOTTOM_OF_STACK);
     }
 
-    this->map_vector_.pop_back();
+    // Unwind the scope's definitions newest first. Each one is the innermost
+    // definition of its key, so unmasking what it shadowed restores the key
+    // to how it was before the scope was pushed.
+    while (this->bindings_.size() > this->scope_marks_.back()) {
+        Binding& binding = this->bindings_.back();
+        Slot* slot = const_cast<Slot*>(this->FindSlot(binding.key));
+
+        slot->top = binding.shadowed;
+        this->bindings_.pop_back();
+    }
+
+    this->scope_marks_.pop_back();
 }
 
 // Puts the given key in the topmost level of the SymbolTable
@@ -61,18 +89,19 @@ void SymbolTable<ValueType>::Pop() {
 // Throws: subclass of SymbolTableException if symbol was already
 // defined.
 template <typename ValueType>
-void SymbolTable<ValueType>::Put(const std::string& key, ValueType value) {
+void SymbolTable<ValueType>::Put(Atom key, ValueType value) {
+    Slot* slot = this->InternSlot(key);
 
-    std::pair<typename std::unordered_map<std::string, ValueType>::iterator, bool> result
-        = this->map_vector_.back().insert(std::make_pair(key, value));
-
-    // Result of operation is second tuple entry.
-    if (!result.second) {
+    if (slot->top != NULL && slot->top->depth == this->depth()) {
         THROW_EXCEPTION(
             1,
             1,
             STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL);
     }
+
+    Binding binding = { key, value, this->depth(), slot->top };
+    this->bindings_.push_back(binding);
+    slot->top = &this->bindings_.back();
 }
 
 // Puts the given key in the bottommost level of the SymbolTable
@@ -82,13 +111,16 @@ void SymbolTable<ValueType>::Put(const std::string& key, ValueType value) {
 // Throws: subclass of SymbolTableException if symbol was already
 // defined.
 template <typename ValueType>
-void SymbolTable<ValueType>::PutBottom(const std::string& key, ValueType value) {
+void SymbolTable<ValueType>::PutBottom(Atom key, ValueType value) {
+    Slot* slot = this->InternSlot(key);
 
-    std::pair<typename std::unordered_map<std::string, ValueType>::iterator, bool> result
-        = this->map_vector_.front().insert(std::make_pair(key, value));
+    // Find the outermost definition of key. The new one goes beneath it.
+    Binding* outermost = slot->top;
+    while (outermost != NULL && outermost->shadowed != NULL) {
+        outermost = outermost->shadowed;
+    }
 
-    // Result of operation is second tuple entry.
-    if (!result.second) {
+    if (outermost != NULL && outermost->depth == 1) {
         // These are incorrect line numbers but this exception should ALWAYS be caught
         // and never bubble up so it doesn't matter.
         THROW_EXCEPTION(
@@ -96,37 +128,38 @@ void SymbolTable<ValueType>::PutBottom(const std::string& key, ValueType value)
             1,
             STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL);
     }
+
+    Binding binding = { key, value, 1, NULL };
+    this->bottom_bindings_.push_back(binding);
+
+    if (outermost != NULL) {
+        outermost->shadowed = &this->bottom_bindings_.back();
+    }
+    else {
+        slot->top = &this->bottom_bindings_.back();
+    }
 }
 
 // Gets the most recently declared value associated with the given
-// key by selecting the definition of value from the top most table.
+// key by selecting the definition of value from the top most table,
+// and then from the global table, if any.
 // key: the symbol to look up.
 // Returns: the value most recently associated with key.
 // Throws: SymbolTable exception subclass if symbol is undefined.
 template <typename ValueType>
-const ValueType& SymbolTable<ValueType>::Get(const std::string& key) const {
-
-    // size_t is the correct type to use when indexing the map_vector_ since
-    // we can't a have a negative index, however, it is unsigned and so i
-    // less than zero is an invalid loop termination because if i is zero and
-    // we subtract one, it wraps around. To combat this, i is equal to the
-    // desired index + 1 and the termination condition is i == 0. i = 1 maps
-    // maps to the zero-th index.
-    for (size_t i = this->map_vector_.size(); i > 0; i--) {
-        try {
-            return this->map_vector_[i-1].at(key);
-        }
-        catch (const std::out_of_range&) {
-            // do nothing
-        }
+const ValueType& SymbolTable<ValueType>::Get(Atom key) const {
+    const ValueType* value = this->Find(key);
+
+    if (value == NULL) {
+        // These are incorrect line numbers but this exception should ALWAYS be caught
+        // and never bubble up so it doesn't matter.
+        THROW_EXCEPTION(
+            1,
+            1,
+            STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
     }
 
-    // These are incorrect line numbers but this exception should ALWAYS be caught
-    // and never bubble up so it doesn't matter.
-    THROW_EXCEPTION(
-        1,
-        1,
-        STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    return *value;
 }
 
 // Gets the value associated with the given symbol, if one was Put
@@ -135,16 +168,122 @@ const ValueType& SymbolTable<ValueType>::Get(const std::string& key) const {
 // Returns: the value associated with key since last call to Push().
 // Throws: SymbolTableException if key does not exist.
 template <typename ValueType>
-const ValueType& SymbolTable<ValueType>::GetTopOnly(const std::string& key) const {
-    try {
-        return this->map_vector_.back().at(key);
-    }
-    catch (const std::out_of_range&) {
+const ValueType& SymbolTable<ValueType>::GetTopOnly(Atom key) const {
+    const ValueType* value = this->FindTopOnly(key);
+
+    if (value == NULL) {
         THROW_EXCEPTION(
             1,
             1,
             STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
     }
+
+    return *value;
+}
+
+// Looks up key the same way as Get() but without throwing.
+// key: the symbol to look up.
+// Returns: the value most recently associated with key, or NULL if key is
+// undefined. The pointer is valid until the value's scope is popped.
+template <typename ValueType>
+const ValueType* SymbolTable<ValueType>::Find(Atom key) const {
+    const Slot* slot = this->FindSlot(key);
+
+    if (slot != NULL && slot->top != NULL) {
+        return &slot->top->value;
+    }
+
+    if (this->global_table_ != NULL) {
+        return this->global_table_->Find(key);
+    }
+
+    return NULL;
+}
+
+// Looks up key the same way as GetTopOnly() but without throwing.
+// key: the symbol to look up.
+// Returns: the value associated with key since last call to Push(), or NULL
+// if there isn't one. The pointer is valid until the value's scope is popped.
+template <typename ValueType>
+const ValueType* SymbolTable<ValueType>::FindTopOnly(Atom key) const {
+    const Slot* slot = this->FindSlot(key);
+
+    if (slot != NULL && slot->top != NULL && slot->top->depth == this->depth()) {
+        return &slot->top->value;
+    }
+
+    return NULL;
+}
+
+// Linear probes for key's slot.
+// Returns: the slot, or NULL if key was never Put in this table.
+template <typename ValueType>
+const typename SymbolTable<ValueType>::Slot* SymbolTable<ValueType>::FindSlot(Atom key) const {
+    size_t mask = this->slots_.size() - 1;
+
+    for (size_t i = key.id() & mask; ; i = (i + 1) & mask) {
+        const Slot* slot = &this->slots_[i];
+
+        if (!slot->key.valid()) {
+            return NULL;
+        }
+
+        if (slot->key == key) {
+            return slot;
+        }
+    }
+}
+
+// Finds key's slot, claiming an empty one for it if it has none.
+// Returns: the slot for key. Pointers to slots are invalidated by the next
+// call to InternSlot().
+template <typename ValueType>
+typename SymbolTable<ValueType>::Slot* SymbolTable<ValueType>::InternSlot(Atom key) {
+    Slot* slot = const_cast<Slot*>(this->FindSlot(key));
+
+    if (slot != NULL) {
+        return slot;
+    }
+
+    // Keep the load factor at or below 1/2.
+    if ((this->key_count_ + 1) * 2 > this->slots_.size()) {
+        this->Grow();
+    }
+
+    size_t mask = this->slots_.size() - 1;
+    size_t i = key.id() & mask;
+    while (this->slots_[i].key.valid()) {
+        i = (i + 1) & mask;
+    }
+
+    this->key_count_++;
+    this->slots_[i].key = key;
+    this->slots_[i].top = NULL;
+
+    return &this->slots_[i];
+}
+
+// Doubles the number of slots and rehashes all existing keys.
+template <typename ValueType>
+void SymbolTable<ValueType>::Grow() {
+    std::vector<Slot> new_slots(this->slots_.size() * 2, Slot());
+    size_t mask = new_slots.size() - 1;
+
+    for (size_t i = 0; i < this->slots_.size(); i++) {
+        const Slot& slot = this->slots_[i];
+
+        if (!slot.key.valid()) {
+            continue;
+        }
+
+        size_t new_slot = slot.key.id() & mask;
+        while (new_slots[new_slot].key.valid()) {
+            new_slot = (new_slot + 1) & mask;
+        }
+        new_slots[new_slot] = slot;
+    }
+
+    this->slots_.swap(new_slots);
 }
 
 } // namespace compiler
@@ -4,29 +4,83 @@
 #ifndef GUNDERSCRIPT_SYMBOL_TABLE__H__
 #define GUNDERSCRIPT_SYMBOL_TABLE__H__
 
+#include <deque>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "gunderscript/atom_table.h"
 #include "gunderscript/exceptions.h"
 
 namespace gunderscript {
 namespace compiler {
 
+// Scoped symbol table keyed by interned Atoms so that lookups hash and
+// compare integers rather than strings. All scopes share one open addressed
+// hash table that maps each key to its innermost definition, so a lookup is
+// a single probe no matter how deep the scopes are. Each definition points to
+// the one it shadows, and Pop() undoes the definitions made since the
+// matching Push() by putting the shadowed ones back. A table may be given a read only
+// global table that Get() falls back on below its own bottom scope. Many
+// tables may share one global table across threads as long as no one
+// modifies it. Find() and FindTopOnly() are the non-throwing forms of Get()
+// and GetTopOnly() for callers that expect misses.
 template <typename ValueType>
 class SymbolTable {
 public:
     SymbolTable();
+    explicit SymbolTable(const SymbolTable* global_table);
     void Push();
     void Pop();
-    void Put(const std::string& key, ValueType value);
-    void PutBottom(const std::string& key, ValueType value);
-    const ValueType& Get(const std::string& key) const;
-    const ValueType& GetTopOnly(const std::string& key) const;
-    size_t depth() const { return this->map_vector_.size(); };
+    void Put(Atom key, ValueType value);
+    void PutBottom(Atom key, ValueType value);
+    const ValueType& Get(Atom key) const;
+    const ValueType& GetTopOnly(Atom key) const;
+    const ValueType* Find(Atom key) const;
+    const ValueType* FindTopOnly(Atom key) const;
+    size_t depth() const { return this->scope_marks_.size(); };
 
 private:
-    std::vector< std::unordered_map<std::string, ValueType, std::hash<std::string> > > map_vector_;
+    // A definition of key in the scope at depth, and the definition of the
+    // same key in an enclosing scope that it masks, or NULL.
+    struct Binding {
+        Atom key;
+        ValueType value;
+        size_t depth;
+        Binding* shadowed;
+    };
+
+    // Hash table slot. Keys are never removed so that probing needs no
+    // tombstones, top is just set to NULL when the key's last scope pops.
+    struct Slot {
+        Atom key;
+        Binding* top;
+    };
+
+    // Undo log of Put() definitions, innermost scope last. Deques keep the
+    // Bindings, and the values returned by Find(), in place as they grow.
+    std::deque<Binding> bindings_;
+
+    // PutBottom() definitions. The bottom scope is never popped so these are
+    // kept out of the undo log.
+    std::deque<Binding> bottom_bindings_;
+
+    // Size of bindings_ when each scope was pushed.
+    std::vector<size_t> scope_marks_;
+
+    // Open addressed by Atom id. Capacity is always a power of two and at
+    // most half full.
+    std::vector<Slot> slots_;
+    size_t key_count_;
+
+    const SymbolTable* global_table_;
+
+    const Slot* FindSlot(Atom key) const;
+    Slot* InternSlot(Atom key);
+    void Grow();
+
+    // Bindings point into each other and must not be copied.
+    SymbolTable(const SymbolTable&);
+    SymbolTable& operator=(const SymbolTable&);
 };
 
 } // namespace library
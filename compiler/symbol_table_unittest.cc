@@ -23,130 +23,212 @@ TEST(SymbolTable, DefaultConditions) {
 // Puts and gets items in a single level of the SymbolTable and
 // checks to make sure that the correct values are read.
 TEST(SymbolTable, SingleLevelPutGet) {
+    AtomTable atoms;
     SymbolTable<std::string> table;
 
-    EXPECT_STATUS(table.Get("Item1"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.GetTopOnly("Item1"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.Get(atoms.Intern("Item1")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item1")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
     ASSERT_EQ(1, table.depth());
 
-    table.Put("Item1", "value1");
+    table.Put(atoms.Intern("Item1"), "value1");
 
-    ASSERT_STREQ("value1", table.Get("Item1").c_str());
-    ASSERT_STREQ("value1", table.GetTopOnly("Item1").c_str());
-    EXPECT_STATUS(table.Get("Item2"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.GetTopOnly("Item2"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    ASSERT_STREQ("value1", table.Get(atoms.Intern("Item1")).c_str());
+    ASSERT_STREQ("value1", table.GetTopOnly(atoms.Intern("Item1")).c_str());
+    EXPECT_STATUS(table.Get(atoms.Intern("Item2")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item2")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
     ASSERT_EQ(1, table.depth());
 
-    table.Put("Item2", "value2");
-    ASSERT_STREQ("value1", table.Get("Item1").c_str());
-    ASSERT_STREQ("value1", table.GetTopOnly("Item1").c_str());
-    ASSERT_STREQ("value2", table.Get("Item2").c_str());
-    ASSERT_STREQ("value2", table.GetTopOnly("Item2").c_str());
+    table.Put(atoms.Intern("Item2"), "value2");
+    ASSERT_STREQ("value1", table.Get(atoms.Intern("Item1")).c_str());
+    ASSERT_STREQ("value1", table.GetTopOnly(atoms.Intern("Item1")).c_str());
+    ASSERT_STREQ("value2", table.Get(atoms.Intern("Item2")).c_str());
+    ASSERT_STREQ("value2", table.GetTopOnly(atoms.Intern("Item2")).c_str());
     ASSERT_EQ(1, table.depth());
 }
 
 // Tries to put duplicate values in single level of SymbolTable
 // and checks for failure and correct value.
 TEST(SymbolTable, SingleLevelPutDuplicate) {
+    AtomTable atoms;
     SymbolTable<std::string> table;
 
-    EXPECT_STATUS(table.Get("Item1"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.Get(atoms.Intern("Item1")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
 
-    table.Put("Item1", "value1");
-    ASSERT_STREQ("value1", table.Get("Item1").c_str());
+    table.Put(atoms.Intern("Item1"), "value1");
+    ASSERT_STREQ("value1", table.Get(atoms.Intern("Item1")).c_str());
 
-    EXPECT_STATUS(table.Put("Item1", "value2"), STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL);
-    ASSERT_STREQ("value1", table.Get("Item1").c_str());
+    EXPECT_STATUS(table.Put(atoms.Intern("Item1"), "value2"), STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL);
+    ASSERT_STREQ("value1", table.Get(atoms.Intern("Item1")).c_str());
 }
 
 // Checks to make sure values put in lower levels in the SymbolTable
 // can still be accessed through the Get method.
 TEST(SymbolTable, MultiLevelPutGet) {
+    AtomTable atoms;
     SymbolTable<std::string> table;
 
-    EXPECT_STATUS(table.Get("Item1"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.GetTopOnly("Item1"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.Get("Item2"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.GetTopOnly("Item2"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.Get("Item3"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.GetTopOnly("Item3"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.Get(atoms.Intern("Item1")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item1")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.Get(atoms.Intern("Item2")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item2")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.Get(atoms.Intern("Item3")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item3")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
 
     // Put Item1 and Item2, leaving Item3 undefined.
-    table.Put("Item1", "value1");
-    table.Put("Item2", "value2");
+    table.Put(atoms.Intern("Item1"), "value1");
+    table.Put(atoms.Intern("Item2"), "value2");
 
     // Add a level to the SymbolTable.
     table.Push();
 
     // Make sure the values haven't changed, except for GetTopOnly
     // since they are no longer stored in top.
-    ASSERT_STREQ("value1", table.Get("Item1").c_str());
-    EXPECT_STATUS(table.GetTopOnly("Item1"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    ASSERT_STREQ("value2", table.Get("Item2").c_str());
-    EXPECT_STATUS(table.GetTopOnly("Item2"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.Get("Item3"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.GetTopOnly("Item3"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    ASSERT_STREQ("value1", table.Get(atoms.Intern("Item1")).c_str());
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item1")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    ASSERT_STREQ("value2", table.Get(atoms.Intern("Item2")).c_str());
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item2")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.Get(atoms.Intern("Item3")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item3")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
 
     // Set new value for Item1 and add Item3 in new level.
-    table.Put("Item1", "value3");
-    table.Put("Item3", "value4");
+    table.Put(atoms.Intern("Item1"), "value3");
+    table.Put(atoms.Intern("Item3"), "value4");
 
     // Make sure only Item1 values have changed.
-    ASSERT_STREQ("value3", table.Get("Item1").c_str());
-    ASSERT_STREQ("value3", table.GetTopOnly("Item1").c_str());
-    ASSERT_STREQ("value2", table.Get("Item2").c_str());
-    EXPECT_STATUS(table.GetTopOnly("Item2"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    ASSERT_STREQ("value4", table.Get("Item3").c_str());
-    ASSERT_STREQ("value4", table.GetTopOnly("Item3").c_str());
+    ASSERT_STREQ("value3", table.Get(atoms.Intern("Item1")).c_str());
+    ASSERT_STREQ("value3", table.GetTopOnly(atoms.Intern("Item1")).c_str());
+    ASSERT_STREQ("value2", table.Get(atoms.Intern("Item2")).c_str());
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item2")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    ASSERT_STREQ("value4", table.Get(atoms.Intern("Item3")).c_str());
+    ASSERT_STREQ("value4", table.GetTopOnly(atoms.Intern("Item3")).c_str());
 
     // Remove second level.
     table.Pop();
 
     // Check for values restored to where they were before.
-    ASSERT_STREQ("value1", table.Get("Item1").c_str());
-    ASSERT_STREQ("value1", table.GetTopOnly("Item1").c_str());
-    ASSERT_STREQ("value2", table.Get("Item2").c_str());
-    ASSERT_STREQ("value2", table.GetTopOnly("Item2").c_str());
-    EXPECT_STATUS(table.Get("Item3"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.GetTopOnly("Item3"), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    ASSERT_STREQ("value1", table.Get(atoms.Intern("Item1")).c_str());
+    ASSERT_STREQ("value1", table.GetTopOnly(atoms.Intern("Item1")).c_str());
+    ASSERT_STREQ("value2", table.Get(atoms.Intern("Item2")).c_str());
+    ASSERT_STREQ("value2", table.GetTopOnly(atoms.Intern("Item2")).c_str());
+    EXPECT_STATUS(table.Get(atoms.Intern("Item3")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Item3")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
 }
 
 // Checks to make sure we can put an item in the bottom most level
 // of symbol table with PutBottom.
 TEST(SymbolTable, PutBottom) {
+    AtomTable atoms;
     SymbolTable<std::string> table;
 
     // Item 1.
-    table.Put("Item1", "Value1");
+    table.Put(atoms.Intern("Item1"), "Value1");
 
     // Push second table and item 2.
     table.Push();
-    table.Put("Item2", "Value2");
+    table.Put(atoms.Intern("Item2"), "Value2");
 
     // Push third table and item 3.
     table.Push();
-    table.Put("Item3", "Value3");
-    table.PutBottom("Item4", "Value4");
+    table.Put(atoms.Intern("Item3"), "Value3");
+    table.PutBottom(atoms.Intern("Item4"), "Value4");
 
     // Check all items are in.
-    ASSERT_STREQ("Value1", table.Get("Item1").c_str());
-    ASSERT_STREQ("Value2", table.Get("Item2").c_str());
-    ASSERT_STREQ("Value3", table.Get("Item3").c_str());
-    ASSERT_STREQ("Value4", table.Get("Item4").c_str());
+    ASSERT_STREQ("Value1", table.Get(atoms.Intern("Item1")).c_str());
+    ASSERT_STREQ("Value2", table.Get(atoms.Intern("Item2")).c_str());
+    ASSERT_STREQ("Value3", table.Get(atoms.Intern("Item3")).c_str());
+    ASSERT_STREQ("Value4", table.Get(atoms.Intern("Item4")).c_str());
 
     // Pop table 3 and validate.
     table.Pop();
-    ASSERT_STREQ("Value1", table.Get("Item1").c_str());
-    ASSERT_STREQ("Value2", table.Get("Item2").c_str());
-    EXPECT_STATUS(table.Get("Item3").c_str(), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    ASSERT_STREQ("Value4", table.Get("Item4").c_str());
+    ASSERT_STREQ("Value1", table.Get(atoms.Intern("Item1")).c_str());
+    ASSERT_STREQ("Value2", table.Get(atoms.Intern("Item2")).c_str());
+    EXPECT_STATUS(table.Get(atoms.Intern("Item3")).c_str(), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    ASSERT_STREQ("Value4", table.Get(atoms.Intern("Item4")).c_str());
 
     // Pop table 2 and validate.
     table.Pop();
-    ASSERT_STREQ("Value1", table.Get("Item1").c_str());
-    EXPECT_STATUS(table.Get("Item2").c_str(), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    EXPECT_STATUS(table.Get("Item3").c_str(), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
-    ASSERT_STREQ("Value4", table.Get("Item4").c_str());
+    ASSERT_STREQ("Value1", table.Get(atoms.Intern("Item1")).c_str());
+    EXPECT_STATUS(table.Get(atoms.Intern("Item2")).c_str(), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.Get(atoms.Intern("Item3")).c_str(), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    ASSERT_STREQ("Value4", table.Get(atoms.Intern("Item4")).c_str());
 
     EXPECT_STATUS(table.Pop(), STATUS_SYMBOLTABLE_BOTTOM_OF_STACK);
-}
\ No newline at end of file
+}
+
+// Checks that a table falls back on its global table and never writes to it.
+TEST(SymbolTable, GlobalTable) {
+    AtomTable atoms;
+    SymbolTable<std::string> global_table;
+    global_table.Put(atoms.Intern("Global"), "GlobalValue");
+
+    SymbolTable<std::string> table(&global_table);
+    table.Put(atoms.Intern("Local"), "LocalValue");
+
+    // Locals shadow globals.
+    table.Push();
+    table.Put(atoms.Intern("Global"), "Shadowed");
+    ASSERT_STREQ("Shadowed", table.Get(atoms.Intern("Global")).c_str());
+    EXPECT_STATUS(table.GetTopOnly(atoms.Intern("Local")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    table.Pop();
+
+    ASSERT_STREQ("GlobalValue", table.Get(atoms.Intern("Global")).c_str());
+    ASSERT_STREQ("LocalValue", table.Get(atoms.Intern("Local")).c_str());
+    EXPECT_STATUS(global_table.Get(atoms.Intern("Local")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    EXPECT_STATUS(table.Get(atoms.Intern("Missing")), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+}
+
+// Checks that Find and FindTopOnly return NULL instead of throwing and see
+// the same values as Get and GetTopOnly.
+TEST(SymbolTable, Find) {
+    AtomTable atoms;
+    SymbolTable<std::string> global_table;
+    global_table.Put(atoms.Intern("Global"), "GlobalValue");
+
+    SymbolTable<std::string> table(&global_table);
+    ASSERT_TRUE(table.Find(atoms.Intern("Item1")) == NULL);
+    ASSERT_TRUE(table.FindTopOnly(atoms.Intern("Item1")) == NULL);
+
+    table.Put(atoms.Intern("Item1"), "value1");
+    table.Push();
+    table.Put(atoms.Intern("Item2"), "value2");
+
+    ASSERT_STREQ("value1", table.Find(atoms.Intern("Item1"))->c_str());
+    ASSERT_TRUE(table.FindTopOnly(atoms.Intern("Item1")) == NULL);
+    ASSERT_STREQ("value2", table.Find(atoms.Intern("Item2"))->c_str());
+    ASSERT_STREQ("value2", table.FindTopOnly(atoms.Intern("Item2"))->c_str());
+    ASSERT_STREQ("GlobalValue", table.Find(atoms.Intern("Global"))->c_str());
+    ASSERT_TRUE(table.FindTopOnly(atoms.Intern("Global")) == NULL);
+    ASSERT_TRUE(table.Find(atoms.Intern("Missing")) == NULL);
+
+    table.Pop();
+    ASSERT_TRUE(table.Find(atoms.Intern("Item2")) == NULL);
+    ASSERT_STREQ("value1", table.FindTopOnly(atoms.Intern("Item1"))->c_str());
+}
+
+// Checks that definitions shadowed across many scopes, including ones put
+// beneath them with PutBottom, come back in order as the scopes are popped.
+TEST(SymbolTable, DeepShadowing) {
+    AtomTable atoms;
+    SymbolTable<std::string> table;
+    const int depth = 100;
+
+    for (int i = 0; i < depth; i++) {
+        table.Push();
+        table.Put(atoms.Intern("Item"), std::to_string(i));
+        table.Put(atoms.Intern("Scope" + std::to_string(i)), std::to_string(i));
+    }
+
+    table.PutBottom(atoms.Intern("Item"), "Bottom");
+    EXPECT_STATUS(table.PutBottom(atoms.Intern("Item"), "Again"), STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL);
+
+    for (int i = depth - 1; i >= 0; i--) {
+        ASSERT_EQ(std::to_string(i), table.Get(atoms.Intern("Item")));
+        ASSERT_EQ(std::to_string(i), table.GetTopOnly(atoms.Intern("Item")));
+        ASSERT_EQ(std::to_string(i), table.Get(atoms.Intern("Scope" + std::to_string(i))));
+        table.Pop();
+        EXPECT_STATUS(table.Get(atoms.Intern("Scope" + std::to_string(i))), STATUS_SYMBOLTABLE_UNDEFINED_SYMBOL);
+    }
+
+    ASSERT_STREQ("Bottom", table.GetTopOnly(atoms.Intern("Item")).c_str());
+    EXPECT_STATUS(table.Put(atoms.Intern("Item"), "Dup"), STATUS_SYMBOLTABLE_DUPLICATE_SYMBOL);
+}
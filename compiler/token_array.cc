@@ -0,0 +1,73 @@
+// Gunderscript-2 Pre-Tokenized Token Array
+// (C) 2016 Christian Gunderman
+
+#include "token_array.h"
+
+namespace gunderscript {
+namespace compiler {
+
+// Lexes all remaining input from a Lexer into the array. Lexer errors are
+// not thrown here. Instead the error is saved along with every token lexed
+// before it so that the Parser can throw it at the same point that the
+// Lexer would have if it were being called one token at a time.
+// lexer: the Lexer to drain. Must outlive the TokenArray.
+TokenArray::TokenArray(Lexer& lexer) : atoms_(&lexer.atoms()), lines_(&lexer.lines()) {
+    this->start_offset_ = lexer.current_offset();
+
+    try {
+        for (const LexerToken* token = lexer.AdvanceNext(); token != NULL; token = lexer.AdvanceNext()) {
+            this->Append(*token, lexer.current_offset());
+        }
+    }
+    catch (const Exception& ex) {
+
+        // The Lexer advances its current token before lexing the one after,
+        // so the token just before the error is still valid.
+        if (lexer.current_token() != NULL) {
+            this->Append(*lexer.current_token(), lexer.current_offset());
+        }
+
+        this->error_.reset(new Exception(ex));
+    }
+
+    this->end_offset_ = lexer.current_offset();
+}
+
+// Gets the source offset of a token. Use lines() to find its line and column.
+// index: the token's index, or size() for the end of the input.
+uint32_t TokenArray::offset(size_t index) const {
+    return index < this->size() ? this->offsets_[index] : this->end_offset_;
+}
+
+// Splits a token into its columns and appends it to the array.
+void TokenArray::Append(const LexerToken& token, uint32_t offset) {
+    TokenPayload payload;
+
+    switch (token.type) {
+    case LexerTokenType::ACCESS_MODIFIER:
+    case LexerTokenType::KEYWORD:
+    case LexerTokenType::SYMBOL:
+        payload.symbol = token.symbol;
+        break;
+    case LexerTokenType::NAME:
+    case LexerTokenType::STRING:
+        payload.atom = token.atom;
+        break;
+    case LexerTokenType::INT:
+        payload.int_const = token.int_const;
+        break;
+    case LexerTokenType::FLOAT:
+        payload.float_const = token.float_const;
+        break;
+    case LexerTokenType::CHAR:
+        payload.char_const = token.char_const;
+        break;
+    }
+
+    this->types_.push_back(token.type);
+    this->payloads_.push_back(payload);
+    this->offsets_.push_back(offset);
+}
+
+} // namespace compiler
+} // namespace gunderscript
@@ -0,0 +1,100 @@
+// Gunderscript-2 Pre-Tokenized Token Array
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_TOKEN_ARRAY__H__
+#define GUNDERSCRIPT_TOKEN_ARRAY__H__
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gunderscript/atom_table.h"
+#include "gunderscript/exceptions.h"
+#include "gunderscript/lexer_resources.h"
+
+#include "lexer.h"
+#include "line_table.h"
+
+namespace gunderscript {
+namespace compiler {
+
+class TokenArray;
+
+// Payload of a single token. NAME and STRING tokens carry only their Atom
+// since the Atom already holds the chars.
+typedef union {
+    LexerSymbol symbol;
+    long int_const;
+    double float_const;
+    char char_const;
+    Atom atom;
+} TokenPayload;
+
+// Handle to one token in a TokenArray. Reads each field from its column on
+// demand so looking at a token's type never touches its payload.
+class TokenRef {
+public:
+    TokenRef(const TokenArray& tokens, size_t index) : tokens_(tokens), index_(index) { }
+
+    LexerTokenType type() const;
+    LexerSymbol symbol() const;
+    long int_const() const;
+    double float_const() const;
+    char char_const() const;
+    Atom atom() const;
+
+private:
+    const TokenArray& tokens_;
+    const size_t index_;
+};
+
+// The whole token stream of a source, lexed up front into dense columns
+// (structure of arrays). Type, payload, and source offset each live in their
+// own vector so that scanning for a particular kind of token stays in
+// cache, and any token can be looked at in constant time.
+// Tokens are only valid for the lifetime of the Lexer and AtomTable that
+// produced them.
+class TokenArray {
+public:
+    TokenArray(Lexer& lexer);
+
+    size_t size() const { return this->types_.size(); }
+    TokenRef operator[](size_t index) const { return TokenRef(*this, index); }
+    LexerTokenType type(size_t index) const { return this->types_[index]; }
+    const TokenPayload& payload(size_t index) const { return this->payloads_[index]; }
+    uint32_t offset(size_t index) const;
+    uint32_t start_offset() const { return this->start_offset_; }
+    int line_number(size_t index) const { return this->lines_->line_number(this->offset(index)); }
+    int column_number(size_t index) const { return this->lines_->column_number(this->offset(index)); }
+    const Exception* error() const { return this->error_.get(); }
+    AtomTable& atoms() const { return *this->atoms_; }
+    const LineTable& lines() const { return *this->lines_; }
+
+private:
+    std::vector<LexerTokenType> types_;
+    std::vector<TokenPayload> payloads_;
+    std::vector<uint32_t> offsets_;
+    uint32_t start_offset_;
+    uint32_t end_offset_;
+    std::unique_ptr<Exception> error_;
+    AtomTable* atoms_;
+    const LineTable* lines_;
+
+    void Append(const LexerToken& token, uint32_t offset);
+
+    // Token arrays are referenced by index from the Parser and must not be copied.
+    TokenArray(const TokenArray&);
+    TokenArray& operator=(const TokenArray&);
+};
+
+inline LexerTokenType TokenRef::type() const { return this->tokens_.type(this->index_); }
+inline LexerSymbol TokenRef::symbol() const { return this->tokens_.payload(this->index_).symbol; }
+inline long TokenRef::int_const() const { return this->tokens_.payload(this->index_).int_const; }
+inline double TokenRef::float_const() const { return this->tokens_.payload(this->index_).float_const; }
+inline char TokenRef::char_const() const { return this->tokens_.payload(this->index_).char_const; }
+inline Atom TokenRef::atom() const { return this->tokens_.payload(this->index_).atom; }
+
+} // namespace compiler
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_TOKEN_ARRAY__H__
@@ -0,0 +1,99 @@
+// Gunderscript 2 Token Array Unit Test
+// (C) 2016 Christian Gunderman
+
+#include "gtest/gtest.h"
+#include "testing_macros.h"
+
+#include "gunderscript/compiler_source.h"
+#include "gunderscript/exceptions.h"
+
+#include "lexer.h"
+#include "parser.h"
+#include "token_array.h"
+
+using namespace gunderscript;
+using namespace gunderscript::compiler;
+
+// Checks that every column of the TokenArray matches the token stream
+// from the Lexer.
+TEST(TokenArray, MatchesLexer) {
+    std::string input("package \"Foo\";\n  x <- 3 + 4.5 * 'c';\npublic");
+    CompilerStringSource streaming_source(input);
+    CompilerStringSource array_source(input);
+    Lexer streaming_lexer(streaming_source);
+    Lexer array_lexer(array_source, streaming_lexer.atoms());
+    TokenArray tokens(array_lexer);
+
+    ASSERT_TRUE(tokens.error() == NULL);
+
+    size_t i = 0;
+    for (const LexerToken* token = streaming_lexer.AdvanceNext(); token != NULL;
+        token = streaming_lexer.AdvanceNext(), i++) {
+        ASSERT_LT(i, tokens.size());
+        ASSERT_EQ(token->type, tokens[i].type());
+        ASSERT_EQ(streaming_lexer.current_line_number(), tokens.line_number(i));
+        ASSERT_EQ(streaming_lexer.current_column_number(), tokens.column_number(i));
+
+        switch (token->type) {
+        case LexerTokenType::NAME:
+        case LexerTokenType::STRING:
+            ASSERT_TRUE(token->atom == tokens[i].atom());
+            break;
+        case LexerTokenType::INT:
+            ASSERT_EQ(token->int_const, tokens[i].int_const());
+            break;
+        case LexerTokenType::FLOAT:
+            ASSERT_EQ(token->float_const, tokens[i].float_const());
+            break;
+        case LexerTokenType::CHAR:
+            ASSERT_EQ(token->char_const, tokens[i].char_const());
+            break;
+        default:
+            ASSERT_EQ(token->symbol, tokens[i].symbol());
+            break;
+        }
+    }
+
+    ASSERT_EQ(i, tokens.size());
+    ASSERT_EQ(12, tokens.size());
+    ASSERT_EQ(streaming_lexer.current_line_number(), tokens.line_number(tokens.size()));
+    ASSERT_EQ(streaming_lexer.current_column_number(), tokens.column_number(tokens.size()));
+}
+
+// Checks that a Lexer error is saved instead of thrown, along with every
+// token before it.
+TEST(TokenArray, SavesLexerError) {
+    std::string input("a b # c");
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    TokenArray tokens(lexer);
+
+    ASSERT_EQ(2, tokens.size());
+    ASSERT_STREQ("b", tokens[1].atom().str().c_str());
+    ASSERT_FALSE(tokens.error() == NULL);
+    ASSERT_EQ(STATUS_LEXER_NO_MATCH.code(), tokens.error()->status().code());
+}
+
+// Checks that a syntax error before a Lexer error is still reported first,
+// as it was when the Parser pulled tokens from the Lexer one at a time.
+TEST(TokenArray, ParserErrorBeforeLexerError) {
+    std::string input("package Foo; #");
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    Parser parser(lexer);
+
+    EXPECT_STATUS(parser.Parse(), STATUS_PARSER_INVALID_PACKAGE);
+}
+
+// Checks that a Parser can parse from a TokenArray lexed by its caller.
+TEST(TokenArray, ParseFromTokenArray) {
+    std::string input("package \"Foo\"; public int32 main() { return 1; }");
+    CompilerStringSource source(input);
+    Lexer lexer(source);
+    TokenArray tokens(lexer);
+    Parser parser(tokens);
+
+    Node* root = parser.Parse();
+    ASSERT_EQ(NodeRule::MODULE, root->rule());
+    ASSERT_STREQ("Foo", root->child(0)->string_value()->c_str());
+}
@@ -0,0 +1,100 @@
+// Gunderscript-2 Identifier Atom Table
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_ATOM_TABLE__H__
+#define GUNDERSCRIPT_ATOM_TABLE__H__
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gunderscript {
+
+class AtomTable;
+
+// An interned string. Every distinct string interned in an AtomTable maps to
+// exactly one Atom so equality is a pointer compare and hashing is free.
+// Atoms are only meaningful within the AtomTable that created them and are
+// valid for as long as that table lives. Atom is deliberately trivial so that
+// it can live inside of the LexerToken union.
+class Atom {
+public:
+    Atom() = default;
+
+    const std::string& str() const { return entry_->str; }
+    size_t id() const { return entry_->id; }
+    bool valid() const { return entry_ != NULL; }
+    bool operator==(const Atom& other) const { return entry_ == other.entry_; }
+    bool operator!=(const Atom& other) const { return entry_ != other.entry_; }
+
+private:
+    friend class AtomTable;
+
+    // Interned string and its precomputed hash and id.
+    struct Entry {
+        std::string str;
+        size_t hash;
+        size_t id;
+    };
+
+    explicit Atom(const Entry* entry) : entry_(entry) { }
+
+    const Entry* entry_;
+};
+
+// Maps each distinct identifier in a compilation to a unique Atom. An
+// AtomTable is shared by the Lexer, the AST, and the compiler's symbol tables
+// so that identifiers are hashed once when they are first seen and compared
+// by identity from then on. Not thread safe, but a table may be layered on a
+// parent table that no one is interning into anymore. The child returns the
+// parent's Atoms for strings the parent knows and makes its own for the rest,
+// so that several threads can each intern into their own child at once.
+class AtomTable {
+public:
+    AtomTable();
+    explicit AtomTable(const AtomTable* parent);
+
+    Atom Intern(const char* data, size_t length);
+    Atom Intern(const std::string& str) { return Intern(str.data(), str.length()); }
+    Atom Find(const char* data, size_t length) const;
+    Atom Find(const std::string& str) const { return Find(str.data(), str.length()); }
+    size_t size() const { return this->entries_.size(); }
+
+private:
+    // Frozen table that is searched before this one, or NULL.
+    const AtomTable* parent_;
+
+    // Id of this table's first entry. Follows on from the parent's ids so that
+    // Atoms from both tables hash differently.
+    size_t first_id_;
+
+    // Entries live in a deque so that Atoms remain valid as the table grows.
+    std::deque<Atom::Entry> entries_;
+
+    // Open addressed hash of pointers into entries_. Capacity is always a
+    // power of two and at most half full.
+    std::vector<const Atom::Entry*> slots_;
+
+    const Atom::Entry* FindEntry(const char* data, size_t length, size_t hash) const;
+    void Grow();
+
+    // Atom tables hand out pointers into themselves and must not be copied.
+    AtomTable(const AtomTable&);
+    AtomTable& operator=(const AtomTable&);
+};
+
+} // namespace gunderscript
+
+namespace std {
+
+// Hashes an Atom by its id so that Atoms can key unordered containers.
+template <>
+struct hash<gunderscript::Atom> {
+    size_t operator()(const gunderscript::Atom& atom) const { return atom.id(); }
+};
+
+} // namespace std
+
+#endif // GUNDERSCRIPT_ATOM_TABLE__H__
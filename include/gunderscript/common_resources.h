@@ -5,6 +5,7 @@
 #define GUNDERSCRIPT_COMMON_RESOURCES__H__
 
 #include <memory>
+#include <string>
 
 namespace gunderscript {
 
@@ -17,6 +18,12 @@ public:
     CommonResources();
     bool verbose_asm();
     void set_verbose_asm(bool verbose_asm);
+    bool lazy_parsing();
+    void set_lazy_parsing(bool lazy_parsing);
+    const std::string& entry_point();
+    void set_entry_point(const std::string& entry_point);
+    unsigned int compile_threads();
+    void set_compile_threads(unsigned int compile_threads);
 
     CommonResourcesImpl& pimpl() { return *(pimpl_.get()); }
 
@@ -10,6 +10,7 @@
 #include "lexer_resources.h"
 #include "module.h"
 #include "node.h"
+#include "virtual_machine.h"
 
 namespace gunderscript {
 
@@ -43,6 +44,10 @@ public:
         ParserNodeFunc parser_walk_func,
         ParserNodeFunc typecheck_walk_func);
     void Compile(CompilerSourceInterface& source, Module& compiled_module);
+    void CompileAndAssemble(
+        CompilerSourceInterface& source,
+        Module& compiled_module,
+        VirtualMachine& vm);
 
 private:
     std::shared_ptr<CompilerImpl> pimpl_;
@@ -4,6 +4,8 @@
 #ifndef GUNDERSCRIPT_COMPILER_SOURCE__H__
 #define GUNDERSCRIPT_COMPILER_SOURCE__H__
 
+#include <cstddef>
+#include <fstream>
 #include <string>
 
 namespace gunderscript {
@@ -12,12 +14,21 @@ namespace gunderscript {
 // has_next: returns false if no more input.
 // NextChar: returns -1 if no more input.
 // PeekNextChar: returns -1 if no more inpu.
+// NextSpan: consumes and returns the next run of input as a contiguous
+// span. Sources that hold all of their input in memory return a pointer
+// to the whole remainder. Streaming sources copy up to buffer_length
+// chars into buffer and return that. The default implementation does
+// this via NextChar().
+// Spans that are not in buffer must stay valid for the lifetime of
+// the source.
+// Returns: the number of chars in *span, or 0 if no more input.
 class CompilerSourceInterface {
 public:
     virtual ~CompilerSourceInterface() { };
     virtual bool has_next() = 0;
     virtual int NextChar() = 0;
     virtual int PeekNextChar() = 0;
+    virtual size_t NextSpan(const char** span, char* buffer, size_t buffer_length);
 };
 
 // Implements CompilerSourceInterface and provides front
@@ -28,6 +39,7 @@ public:
     bool has_next() { return this->index < this->input_.length(); }
     int NextChar();
     int PeekNextChar();
+    size_t NextSpan(const char** span, char* buffer, size_t buffer_length);
 private:
     std::string input_;
     size_t index = 0;
@@ -42,12 +54,42 @@ public:
     bool has_next();
     int NextChar();
     int PeekNextChar();
+    size_t NextSpan(const char** span, char* buffer, size_t buffer_length);
 private:
     const std::string& file_name_;
     std::fstream* file_stream_ = NULL;
     int next_ = 0;
 };
 
+// Implements CompilerSourceInterface and provides front
+// end for files by mapping the whole file into memory, or,
+// where mapping is unavailable, reading it in a single bulk read.
+// The entire input is available as one contiguous buffer via
+// data() and length().
+class CompilerMappedFileSource : public CompilerSourceInterface {
+public:
+    CompilerMappedFileSource(const std::string& file_name);
+    ~CompilerMappedFileSource();
+    bool has_next() { return this->index_ < this->length_; }
+    int NextChar();
+    int PeekNextChar();
+    size_t NextSpan(const char** span, char* buffer, size_t buffer_length);
+    const char* data() const { return this->data_; }
+    size_t length() const { return this->length_; }
+private:
+    const char* data_ = NULL;
+    size_t length_ = 0;
+    size_t index_ = 0;
+    bool mapped_ = false;
+
+    bool MapFile(const std::string& file_name);
+    bool ReadFile(const std::string& file_name);
+
+    // Sources own their buffer, which a copy would unmap or free twice.
+    CompilerMappedFileSource(const CompilerMappedFileSource&);
+    CompilerMappedFileSource& operator=(const CompilerMappedFileSource&);
+};
+
 } // namespace gunderscript
 
 #endif // GUNDERSCRIPT_COMPILER_SOURCE__H__
\ No newline at end of file
@@ -83,6 +83,7 @@ const ExceptionStatus STATUS_SYMBOLTABLE_BOTTOM_OF_STACK = ExceptionStatus(-4, "
 const ExceptionStatus STATUS_FILESOURCE_FILE_READ_ERROR = ExceptionStatus(-5, "Unable to read file");
 const ExceptionStatus STATUS_INVALID_CALL = ExceptionStatus(-6, "Caller performed invalid call on Gunderscript library");
 const ExceptionStatus STATUS_ASSEMBLER_DIED = ExceptionStatus(-7, "Assembler was unable to assemble code");
+const ExceptionStatus STATUS_UNPARSED_FUNCTION = ExceptionStatus(-8, "Function body was not parsed because it can't be reached from the entry point");
 
 // Lexer Exceptions 100-199:
 const ExceptionStatus STATUS_LEXER_UNTERMINATED_COMMENT = ExceptionStatus(100, "Unterminated comment");
@@ -92,6 +93,7 @@ const ExceptionStatus STATUS_LEXER_MALFORMED_NUMBER = ExceptionStatus(103, "Malf
 const ExceptionStatus STATUS_LEXER_MALFORMED_CHAR = ExceptionStatus(104, "Malformed character constant");
 const ExceptionStatus STATUS_LEXER_NO_MATCH = ExceptionStatus(105, "No matching lexer rule");
 const ExceptionStatus STATUS_LEXER_NEWLINE_IN_STRING = ExceptionStatus(106, "New line character in string constant");
+const ExceptionStatus STATUS_LEXER_SOURCE_TOO_LARGE = ExceptionStatus(107, "Source is larger than 4 GB");
 
 // Parser Exceptions 200-299:
 const ExceptionStatus STATUS_PARSER_MISSING_PACKAGE = ExceptionStatus(200, "Expected a package declaration at top of file");
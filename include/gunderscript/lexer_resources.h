@@ -4,6 +4,11 @@
 #ifndef GUNDERSCRIPT_LEXER_RESOURCES__H__
 #define GUNDERSCRIPT_LEXER_RESOURCES__H__
 
+#include <cstddef>
+#include <string>
+
+#include "atom_table.h"
+
 namespace gunderscript {
 
 // POTENTIAL BUG BUG BUG: Whenever you update this enum be sure to update
@@ -12,10 +17,10 @@ namespace gunderscript {
 // ACCESS_MODIFIER: contains LexerSymbol.
 // KEYWORD: contains LexerSymbol.
 // SYMBOL: contains LexerSymbol
-// NAME: contains string_const and represents a variable name or type name.
+// NAME: contains string_const and atom and represents a variable name or type name.
 // INT: contains int_const.
 // FLOAT: contains float_const.
-// STRING: contains string_const.
+// STRING: contains string_const and atom.
 enum class LexerTokenType {
     ACCESS_MODIFIER, KEYWORD, SYMBOL, NAME, INT, FLOAT, STRING, CHAR
 };
@@ -41,18 +46,31 @@ enum class LexerSymbol {
     ANY_TYPE
 };
 
+// Non-owning view of the chars of a NAME or STRING token. Points either
+// directly into the compiler source's input or into the Lexer's arena
+// (for escaped strings and streaming sources) and stays valid for the
+// lifetime of the Lexer that produced it. NOT null terminated.
+typedef struct {
+    const char* data;
+    size_t length;
+
+    std::string str() const { return std::string(data, length); }
+} LexerStringView;
+
 // LexerToken.
 // type: Tells the content of the token and its semantics.
 // symbol/string_const/int_const/float_const: the data.
+// atom: the interned NAME or STRING, shared with the AST and symbol tables.
 typedef struct {
     LexerTokenType type;
     union {
         LexerSymbol symbol;
-        const std::string* string_const;
+        LexerStringView string_const;
         long int_const;
         double float_const;
         char char_const;
     };
+    Atom atom;
 } LexerToken;
 
 // Maps a lexer token enum value to its string representation.
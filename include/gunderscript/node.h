@@ -4,10 +4,12 @@
 #ifndef GUNDERSCRIPT_NODE__H__
 #define GUNDERSCRIPT_NODE__H__
 
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <string>
-#include <vector>
 
+#include "atom_table.h"
 #include "lexer_resources.h"
 #include "symbol.h"
 
@@ -78,55 +80,131 @@ enum class NodeRule {
 // Maps a NodeRule enum value to its string representation.
 const std::string NodeRuleString(NodeRule rule);
 
+namespace compiler {
+class NodeArena;
+} // namespace compiler
+
+class NodeArray;
+
+// Numeric value of a node. Which member is set depends on the NodeRule.
+typedef union {
+    bool bool_value;
+    long int_value;
+    double float_value;
+    LexerSymbol symbol_value;
+} NodeValue;
+
 // The abstract syntax tree node object. Each Node is a subtree containing a single
 // language construct. Child nodes represent properties of the language constructs
-// or sub-constructs.
+// or sub-constructs. A Node is a handle to one entry of a NodeArray, which holds
+// the node's properties. Nodes are created by and belong to a
+// compiler::NodeArena, which frees the whole tree at once.
 class Node {
 public:
-    Node(NodeRule rule, int line, int column);
-    Node(NodeRule rule, int line, int column, bool value);
-    Node(NodeRule rule, int line, int column, long value);
-    Node(NodeRule rule, int line, int column, double value);
-    Node(NodeRule rule, int line, int column, LexerSymbol symbol);
-    Node(NodeRule rule, int line, int column, const std::string* value);
-    ~Node();
-
-    void AddChild(Node* child);
     Node* child(size_t child) const;
-    size_t child_count() const { return this->children_.size(); }
-    bool bool_value() const { return num_value_.bool_value; }
-    long int_value() const { return num_value_.int_value; }
-    double float_value() const { return num_value_.float_value; }
-    LexerSymbol symbol_value() const { return num_value_.symbol_value; }
-    const std::string* string_value() const { return string_value_; }
-    NodeRule rule() const { return rule_; }
-    int line() { return line_; }
-    int column() { return column_; }
-
-    void set_symbol(const SymbolBase* symbol) {
-        symbol_ = symbol;
+    size_t child_count() const;
+    bool bool_value() const;
+    long int_value() const;
+    double float_value() const;
+    LexerSymbol symbol_value() const;
+    const std::string* string_value() const;
+    Atom atom() const;
+    NodeRule rule() const;
+    uint32_t offset() const;
+    uint32_t index() const { return index_; }
+
+    void set_symbol(const SymbolBase* symbol);
+    const SymbolBase* symbol() const;
+    compiler::NodeArena& arena() const;
+
+private:
+    friend class compiler::NodeArena;
+
+    Node(NodeArray& array, uint32_t index) : array_(array), index_(index) { }
+
+    // Nodes are never deleted individually. They are freed with their arena.
+    ~Node() = default;
+
+    NodeArray& array_;
+    const uint32_t index_;
+};
+
+// A whole abstract syntax tree laid out flat in pre-order, so that a node's
+// subtree immediately follows it and walking the tree in order walks the
+// arrays front to back. Each property lives in its own column (structure of
+// arrays) so that navigating by rule and children never loads values or
+// symbols. Children are referenced by their 32 bit index in the array.
+class NodeArray {
+public:
+    uint32_t size() const { return size_; }
+    Node* root() const { return &nodes_[0]; }
+    Node* node(uint32_t index) const { return &nodes_[index]; }
+    NodeRule rule(uint32_t index) const { return rules_[index]; }
+    uint32_t offset(uint32_t index) const { return offsets_[index]; }
+    const NodeValue& value(uint32_t index) const { return values_[index]; }
+    Atom atom(uint32_t index) const { return atoms_[index]; }
+    const SymbolBase* symbol(uint32_t index) const { return symbols_[index]; }
+    uint32_t child_count(uint32_t index) const { return child_counts_[index]; }
+    uint32_t child_index(uint32_t index, size_t child) const {
+        return children_[first_children_[index] + child];
     }
-    const SymbolBase* symbol() const { return symbol_; }
 
 private:
-    std::vector<Node*> children_;
-    const std::string* string_value_;
-    const int line_;
-    const int column_;
-
-    union {
-        bool bool_value;
-        long int_value;
-        double float_value;
-        LexerSymbol symbol_value;
-    } num_value_;
-    NodeRule rule_;
+    friend class Node;
+    friend class compiler::NodeArena;
+
+    NodeArray() = default;
+    ~NodeArray() = default;
+
+    // Arena that owns the columns and the symbols created for the nodes.
+    compiler::NodeArena* arena_;
+    uint32_t size_;
+
+    // Node handles given out to the compiler stages.
+    Node* nodes_;
+
+    NodeRule* rules_;
+
+    // Offset of each node's token in the source. Compiler stages resolve it
+    // to a line and column with the source's LineTable when reporting errors.
+    uint32_t* offsets_;
+    NodeValue* values_;
+    Atom* atoms_;
+
+    // Each node's children are a contiguous run of indices in children_,
+    // starting at first_children_[index].
+    uint32_t* first_children_;
+    uint32_t* child_counts_;
+    uint32_t* children_;
 
     // Mutable Properties:
 
-    const SymbolBase* symbol_;
+    const SymbolBase** symbols_;
 };
 
+// Gets a child from this node by its index (added order). Walkers call this
+// for every node they visit, so it is inline.
+inline Node* Node::child(size_t child) const {
+    assert(child < child_count() && "Child index is out of bounds in Node");
+    return array_.node(array_.child_index(index_, child));
+}
+
+inline size_t Node::child_count() const { return array_.child_count(index_); }
+inline bool Node::bool_value() const { return array_.value(index_).bool_value; }
+inline long Node::int_value() const { return array_.value(index_).int_value; }
+inline double Node::float_value() const { return array_.value(index_).float_value; }
+inline LexerSymbol Node::symbol_value() const { return array_.value(index_).symbol_value; }
+inline Atom Node::atom() const { return array_.atom(index_); }
+inline NodeRule Node::rule() const { return array_.rule(index_); }
+inline uint32_t Node::offset() const { return array_.offset(index_); }
+inline const SymbolBase* Node::symbol() const { return array_.symbol(index_); }
+inline compiler::NodeArena& Node::arena() const { return *array_.arena_; }
+
+inline const std::string* Node::string_value() const {
+    Atom atom = array_.atom(index_);
+    return atom.valid() ? &atom.str() : NULL;
+}
+
 } // namespace gunderscript
 
 #endif // GUNDERSCRIPT_NODE__H__
@@ -59,6 +59,9 @@ public:
     virtual const SymbolBase* Clone() const { return new SymbolBase(symbol_type_, access_modifier_, spec_name_, symbol_name_); }
     virtual const TypeSymbol* type_symbol() const { assert(false); return (TypeSymbol*)(NULL); }
 
+    // Compares symbols by name. Within a compilation every symbol exists once,
+    // so the compiler compares symbol pointers instead. This is for symbols
+    // that outlive their compilation, such as a Module's exported types.
     bool operator==(const SymbolBase& other) const { return this->symbol_name() == other.symbol_name(); }
     bool operator!=(const SymbolBase& other) const { return !(*this == other); }
 
@@ -131,31 +134,25 @@ public:
     ~GenericTypeSymbol() { }
     const SymbolBase* Clone() const { return new GenericTypeSymbol(symbol_type(), access_modifier(), symbol_name(), type_params()); }
     TypeSymbol* type_symbol() const { return (GenericTypeSymbol*)this; }
-    const std::vector<const SymbolBase*> type_params() const { return type_params_; }
+    const std::vector<const SymbolBase*>& type_params() const { return type_params_; }
 
 private:
     const std::vector<const SymbolBase*> type_params_;
 };
 
-// Built in types.
-const TypeSymbol TYPE_NONE(LexerSymbol::PUBLIC, "none"); // TODO: kill this.
-const TypeSymbol TYPE_VOID(SymbolType::TYPE, LexerSymbol::PUBLIC, "void", TypeFormat::FVOID, 0);
-const TypeSymbol TYPE_FUNCTION(LexerSymbol::PUBLIC, "function");
-const TypeSymbol TYPE_BOOL(SymbolType::TYPE, LexerSymbol::PUBLIC, "bool", TypeFormat::BOOL, 4);
-const TypeSymbol TYPE_INT(SymbolType::TYPE, LexerSymbol::PUBLIC, "int32", TypeFormat::INT, 4);
-const TypeSymbol TYPE_FLOAT(SymbolType::TYPE, LexerSymbol::PUBLIC, "float32", TypeFormat::FLOAT, 4);
-const TypeSymbol TYPE_STRING(LexerSymbol::PUBLIC, "string");
-const TypeSymbol TYPE_INT8(SymbolType::TYPE, LexerSymbol::PUBLIC, "int8", TypeFormat::INT, 1);
+// Built in types. Each is defined once, in symbol.cc, so that every module
+// of the compiler and runtime shares the same symbols.
+extern const TypeSymbol TYPE_NONE; // TODO: kill this.
+extern const TypeSymbol TYPE_VOID;
+extern const TypeSymbol TYPE_FUNCTION;
+extern const TypeSymbol TYPE_BOOL;
+extern const TypeSymbol TYPE_INT;
+extern const TypeSymbol TYPE_FLOAT;
+extern const TypeSymbol TYPE_STRING;
+extern const TypeSymbol TYPE_INT8;
 
 // Vector of all builtin types.
-const std::vector<const TypeSymbol*> BUILTIN_TYPES = {
-    &TYPE_VOID,
-    &TYPE_BOOL,
-    &TYPE_INT,
-    &TYPE_FLOAT,
-    &TYPE_STRING,
-    &TYPE_INT8
-};
+extern const std::vector<const TypeSymbol*> BUILTIN_TYPES;
 
 } // namespace gunderscript
 
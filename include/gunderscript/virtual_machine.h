@@ -20,11 +20,15 @@ public:
     void AssembleModule(Module& module);
 
     // TODO: replace with universal function calling interface.
+    // Throws: STATUS_UNPARSED_FUNCTION if main's body was skipped by lazy
+    // parsing.
     int HackyRunScriptMainInt(Module& module);
     float HackyRunScriptMainFloat(Module& module);
     char HackyRunScriptMainChar(Module& module);
     bool HackyRunScriptMainBool(Module& module);
 
+    VirtualMachineImpl& pimpl() { return *(pimpl_.get()); }
+
 private:
     std::shared_ptr<VirtualMachineImpl> pimpl_;
 };
@@ -152,4 +152,144 @@ TEST(ControlFlowIntegration, ForSquareroot) {
         "   old <-new_val;"
         "}"
         "return new_val;"));
-}
\ No newline at end of file
+}
+
+TEST(ControlFlowIntegration, LazyParsingSkipsUnreachableFunctions) {
+    std::string input("package \"Foo\";"
+        "public int32 unused() { return undefined(true); }"
+        "public int32 main() { return y(3) + 1; }"
+        "public int32 y(int32 x) { return x * 2; }"
+        "public int32 broken() { this is not { valid } code }");
+    CommonResources common_resources;
+    common_resources.set_lazy_parsing(true);
+    CompilerStringSource string_source(input);
+    Compiler compiler(common_resources);
+    Module module;
+    compiler.Compile(string_source, module);
+    VirtualMachine vm(common_resources);
+
+    EXPECT_EQ(7, vm.HackyRunScriptMainInt(module));
+}
+
+TEST(ControlFlowIntegration, LazyParsingChecksUnreachableDeclarations) {
+    std::string input("package \"Foo\";"
+        "public int32 begin() { return 1; }"
+        "public void unused(void x) { }");
+    CommonResources common_resources;
+    common_resources.set_lazy_parsing(true);
+    common_resources.set_entry_point("begin");
+    CompilerStringSource string_source(input);
+    Compiler compiler(common_resources);
+    Module module;
+
+    EXPECT_STATUS(compiler.Compile(string_source, module), STATUS_SEMANTIC_VOID_USED_IN_PARAM);
+}
+
+TEST(ControlFlowIntegration, LazyParsingRefusesToRunUnparsedFunctions) {
+    std::string input("package \"Foo\";"
+        "public int32 begin() { return 1; }"
+        "public int32 main() { return 2; }");
+    CommonResources common_resources;
+    common_resources.set_lazy_parsing(true);
+    common_resources.set_entry_point("begin");
+    CompilerStringSource string_source(input);
+    Compiler compiler(common_resources);
+    Module module;
+    compiler.Compile(string_source, module);
+    VirtualMachine vm(common_resources);
+
+    EXPECT_STATUS(vm.HackyRunScriptMainInt(module), STATUS_UNPARSED_FUNCTION);
+}
+
+TEST(ControlFlowIntegration, CompileModes) {
+    std::string input("package \"Foo\";"
+        "public int32 main() { return y(3) + z(4); }"
+        "public int32 y(int32 x) { if (x > 2) { return x * 2; } return x; }"
+        "public int32 z(int32 x) { for (i <- 0; i < 3; i <- i + 1) { x <- x + 1; } return x; }");
+
+    for (TestCompileMode mode : { TestCompileMode::SERIAL, TestCompileMode::PARALLEL,
+        TestCompileMode::COMPILE_AND_ASSEMBLE }) {
+        EXPECT_EQ(13, CompileAndRunInMode(input, mode));
+    }
+}
+
+TEST(ControlFlowIntegration, CompileAndAssembleErrors) {
+    // Reports the same error as Compile(): the whole module is parsed before
+    // main() is type checked.
+    std::string input("package \"Foo\";"
+        "public int32 main() { return true; }"
+        "public int32 y(int32 x) { return x <- ; }");
+    CommonResources common_resources;
+    CompilerStringSource string_source(input);
+    Compiler compiler(common_resources);
+    Module module;
+    VirtualMachine vm(common_resources);
+
+    EXPECT_STATUS(compiler.CompileAndAssemble(string_source, module, vm),
+        STATUS_PARSER_MALFORMED_EXPRESSION_INVALID_TOKEN);
+    EXPECT_FALSE(module.compiled());
+}
+
+TEST(ControlFlowIntegration, LocalsMergeAfterIfElse) {
+    std::string input("package \"Foo\";"
+        "public int32 main() { return y(1) * 1000 + y(0); }"
+        "public int32 y(int32 x) {"
+        "    a <- 1;"
+        "    b <- 2;"
+        "    if (x > 0) {"
+        "        a <- a + 10;"
+        "        if (x > 5) { b <- 7; }"
+        "    } else {"
+        "        b <- b + 20;"
+        "        c <- 3.5;"
+        "    }"
+        "    return a * 100 + b;"
+        "}");
+
+    for (TestCompileMode mode : { TestCompileMode::SERIAL, TestCompileMode::PARALLEL,
+        TestCompileMode::COMPILE_AND_ASSEMBLE }) {
+        EXPECT_EQ(1102122, CompileAndRunInMode(input, mode));
+    }
+}
+
+TEST(ControlFlowIntegration, LocalsCarriedAroundLoops) {
+    std::string input("package \"Foo\";"
+        "public int32 main() {"
+        "    total <- 0;"
+        "    scale <- 0.5;"
+        "    for (i <- 0; i < 4; i <- i + 1) {"
+        "        for (j <- i; j < 4; j <- j + 1) {"
+        "            total <- total + j;"
+        "            if (j = 3) {"
+        "                total <- 1.5;"
+        "                scale <- scale + total;"
+        "            }"
+        "        }"
+        "    }"
+        "    return total + int32(scale) + i;"
+        "}");
+
+    for (TestCompileMode mode : { TestCompileMode::SERIAL, TestCompileMode::PARALLEL,
+        TestCompileMode::COMPILE_AND_ASSEMBLE }) {
+        EXPECT_EQ(30, CompileAndRunInMode(input, mode));
+    }
+}
+
+TEST(ControlFlowIntegration, ReassignedParams) {
+    std::string input("package \"Foo\";"
+        "public int32 main() { return y(3, 2.0, false, 'a'); }"
+        "public int32 y(int32 a, float32 b, bool d, int8 c) {"
+        "    for (i <- 0; i < a; i <- i + 1) {"
+        "        b <- b * 2.0;"
+        "        d <- !d;"
+        "        c <- c + c;"
+        "    }"
+        "    if (d && a > 0) { a <- a + 100; }"
+        "    return a + int32(b) + int32(c);"
+        "}");
+
+    for (TestCompileMode mode : { TestCompileMode::SERIAL, TestCompileMode::PARALLEL,
+        TestCompileMode::COMPILE_AND_ASSEMBLE }) {
+        EXPECT_EQ(127, CompileAndRunInMode(input, mode));
+    }
+}
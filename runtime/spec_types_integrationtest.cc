@@ -239,4 +239,149 @@ TEST(SpecTypesIntegration, EncapsulatedListSum) {
         "        this.Value <-value;"
         "    }"
         "}"));
-}
\ No newline at end of file
+}
+
+TEST(SpecTypesIntegration, CompileModes) {
+    std::string input("package \"Foo\";"
+        "public int32 main() {"
+        "    pt <- new Point(3, 4);"
+        "    return pt.Sum() + pt.Scale(2).Sum();"
+        "}"
+        "public spec Point {"
+        "    int32 X{ public get; concealed set; }"
+        "    int32 Y{ public get; concealed set; }"
+        "    public construct(int32 x, int32 y) { this.X <- x; this.Y <- y; }"
+        "    public int32 Sum() { return this.X + this.Y; }"
+        "    public Point Scale(int32 factor) { return new Point(this.X * factor, this.Y * factor); }"
+        "}");
+
+    for (TestCompileMode mode : { TestCompileMode::SERIAL, TestCompileMode::PARALLEL,
+        TestCompileMode::COMPILE_AND_ASSEMBLE }) {
+        EXPECT_EQ(21, CompileAndRunInMode(input, mode));
+    }
+}
+
+TEST(SpecTypesIntegration, ParallelCompileErrors) {
+    // The error in foo() is reported with any number of threads, even though
+    // the one in the spec comes first in the source.
+    std::string input("package \"Foo\";"
+        "public spec Point {"
+        "    public construct() { z <- true; z <- 1; }"
+        "}"
+        "public int32 main() { return 0; }"
+        "public int32 foo() { return false; }");
+
+    for (unsigned int compile_threads : { 1, 4 }) {
+        CommonResources common_resources;
+        common_resources.set_compile_threads(compile_threads);
+        CompilerStringSource string_source(input);
+        Compiler compiler(common_resources);
+        Module module;
+
+        EXPECT_STATUS(compiler.Compile(string_source, module), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
+    }
+}
+
+TEST(SpecTypesIntegration, CompileAndAssembleErrors) {
+    // main() and the spec are assembled before the error in foo() is found.
+    std::string bad_input("package \"Foo\";"
+        "public int32 main() { return new Point(3, 4).Sum(); }"
+        "public spec Point {"
+        "    int32 X{ public get; concealed set; }"
+        "    int32 Y{ public get; concealed set; }"
+        "    public construct(int32 x, int32 y) { this.X <- x; this.Y <- y; }"
+        "    public int32 Sum() { return this.X + this.Y; }"
+        "}"
+        "public int32 foo() { return false; }");
+    std::string good_input("package \"Foo\";"
+        "public int32 main() { return new Point(3, 4).Sum(); }"
+        "public spec Point {"
+        "    int32 X{ public get; concealed set; }"
+        "    int32 Y{ public get; concealed set; }"
+        "    public construct(int32 x, int32 y) { this.X <- x; this.Y <- y; }"
+        "    public int32 Sum() { return this.X + this.Y; }"
+        "}"
+        "public int32 foo() { return 0; }");
+    CommonResources common_resources;
+    Compiler compiler(common_resources);
+    VirtualMachine vm(common_resources);
+    Module module;
+    Module module_handle(module);
+
+    CompilerStringSource bad_source(bad_input);
+    EXPECT_STATUS(compiler.CompileAndAssemble(bad_source, module, vm), STATUS_SEMANTIC_RETURN_TYPE_MISMATCH);
+    EXPECT_FALSE(module.compiled());
+    EXPECT_FALSE(module.assembled());
+
+    // The module is filled in place, so every handle to it sees the result.
+    CompilerStringSource good_source(good_input);
+    compiler.CompileAndAssemble(good_source, module, vm);
+    EXPECT_TRUE(module_handle.assembled());
+    EXPECT_EQ(7, vm.HackyRunScriptMainInt(module_handle));
+}
+
+TEST(SpecTypesIntegration, RepeatedPropertyReads) {
+    std::string input("package \"Foo\";"
+        "public int32 main() {"
+        "    pt <- new Point(3, 4);"
+        "    return pt.X + pt.X * pt.Y + pt.Y;"
+        "}"
+        "public spec Point {"
+        "    int32 X{ public get; public set; }"
+        "    int32 Y{ public get; public set; }"
+        "    public construct(int32 x, int32 y) { this.X <- x; this.Y <- y; }"
+        "}");
+
+    for (TestCompileMode mode : { TestCompileMode::SERIAL, TestCompileMode::PARALLEL,
+        TestCompileMode::COMPILE_AND_ASSEMBLE }) {
+        EXPECT_EQ(19, CompileAndRunInMode(input, mode));
+    }
+}
+
+TEST(SpecTypesIntegration, PropertyReadsAfterAliasedStores) {
+    std::string input("package \"Foo\";"
+        "public int32 main() {"
+        "    a <- new Point(1, 2);"
+        "    b <- a;"
+        "    x <- a.X;"
+        "    b.X <- 5;"
+        "    b.Y <- 7;"
+        "    y <- a.X * 10 + a.Y;"
+        "    if (y > 0) { b.X <- 9; }"
+        "    return x * 10000 + y * 100 + a.X;"
+        "}"
+        "public spec Point {"
+        "    int32 X{ public get; public set; }"
+        "    int32 Y{ public get; public set; }"
+        "    public construct(int32 x, int32 y) { this.X <- x; this.Y <- y; }"
+        "}");
+
+    for (TestCompileMode mode : { TestCompileMode::SERIAL, TestCompileMode::PARALLEL,
+        TestCompileMode::COMPILE_AND_ASSEMBLE }) {
+        EXPECT_EQ(15709, CompileAndRunInMode(input, mode));
+    }
+}
+
+TEST(SpecTypesIntegration, PropertyReadsAfterCalls) {
+    std::string input("package \"Foo\";"
+        "public int32 main() {"
+        "    pt <- new Point(1, 2);"
+        "    x <- pt.X;"
+        "    pt.Bump();"
+        "    y <- pt.X;"
+        "    Bump(pt);"
+        "    return x * 10000 + y * 100 + pt.X;"
+        "}"
+        "public void Bump(Point pt) { pt.X <- pt.X + 10; }"
+        "public spec Point {"
+        "    int32 X{ public get; public set; }"
+        "    int32 Y{ public get; public set; }"
+        "    public construct(int32 x, int32 y) { this.X <- x; this.Y <- y; }"
+        "    public void Bump() { this.X <- this.X + 10; }"
+        "}");
+
+    for (TestCompileMode mode : { TestCompileMode::SERIAL, TestCompileMode::PARALLEL,
+        TestCompileMode::COMPILE_AND_ASSEMBLE }) {
+        EXPECT_EQ(11121, CompileAndRunInMode(input, mode));
+    }
+}
@@ -4,13 +4,12 @@
 #include <unordered_map>
 
 #include "gunderscript/exceptions.h"
-#include "gunderscript/virtual_machine.h"
 
 #include "gs_assert.h"
-#include "common_resourcesimpl.h"
 #include "moduleimpl.h"
 
 #include "garbage_collector.h"
+#include "virtual_machineimpl.h"
 
 #include "nanojit.h"
 
@@ -28,34 +27,6 @@ using namespace nanojit;
 
 namespace gunderscript {
 
-// Virtual Machine Private Implementation.
-class VirtualMachineImpl {
-public:
-    VirtualMachineImpl(CommonResourcesImpl& common_resources) 
-        : code_alloc_(&common_resources.config()), common_resources_(common_resources) {
-        // Setup Nanojit Log control logging if in NJ_VERBOSE (Debug configuration).
-#ifdef NJ_VERBOSE
-        this->log_control_.lcbits = common_resources.verbose_asm() ? LC_ReadLIR | LC_Native : 0;
-#else
-        this->log_control_.lcbits = 0;
-#endif
-    }
-
-    void AssembleModule(Module& module);
-    int HackyRunScriptMainInt(Module& module);
-    float HackyRunScriptMainFloat(Module& module);
-    char HackyRunScriptMainChar(Module& module);
-    bool HackyRunScriptMainBool(Module& module);
-
-private:
-    LogControl* log_control() { return &log_control_; }
-    CodeAlloc& code_alloc() { return code_alloc_; }
-
-    CommonResourcesImpl& common_resources_;
-    LogControl log_control_;
-    CodeAlloc code_alloc_;
-};
-
 // Public constructor.
 VirtualMachine::VirtualMachine(CommonResources& common_resources) 
     : pimpl_(new VirtualMachineImpl(
@@ -96,9 +67,6 @@ void VirtualMachineImpl::AssembleModule(Module& module) {
     // If assembly succeeds or fails, we don't want to allow trying again.
     module.pimpl()->set_assembled(true);
 
-    // Allow unoptimized builds in the future??
-    const bool optimize = true;
-
     // Allocate an assembler.
     Assembler assm(
         this->code_alloc_,
@@ -109,30 +77,12 @@ void VirtualMachineImpl::AssembleModule(Module& module) {
 
     // Assemble all fragments in the module.
     for (size_t i = 0; i < module.pimpl()->symbols_vector().size(); i++) {
-        Fragment* f = module.pimpl()->symbols_vector().at(i).fragment();
-
-        GS_ASSERT_FALSE(f == NULL, "NULL fragment in assembler");
-
-        // Set the ABI now to be sure that it matches the expected value.
-        f->lirbuf->abi = AbiKind::ABI_CDECL;
-
-        // Create an instruction printer if in NJ_VERBOSE (Debug Configuration).
-#ifdef NJ_VERBOSE
-        if (common_resources_.verbose_asm()) {
-            std::cout << "Symbol: "
-                << module.pimpl()->symbols_vector().at(i).symbol_name()
-                << std::endl;
-        }
-
-        LInsPrinter p(this->common_resources_.alloc(), 1024);
-        f->lirbuf->printer = &p;
-#endif
+        ModuleImplSymbol& symbol = module.pimpl()->symbols_vector().at(i);
 
-        // Assemble LIR to native code.
-        assm.compile(f, this->common_resources_.alloc(), optimize verbose_only(, &p));
+        GS_ASSERT_FALSE(symbol.fragment() == NULL, "NULL fragment in assembler");
 
         // Handle assembler errors.
-        if (assm.error() != AssmError::None) {
+        if (!AssembleSymbol(assm, this->common_resources_.alloc(), symbol)) {
 
             // Prints exact value on failure.
             GS_ASSERT_TRUE(assm.error() != AssmError::None, "Error performing assemble operation");
@@ -144,8 +94,75 @@ void VirtualMachineImpl::AssembleModule(Module& module) {
         // Store a reference to this function in the module's function lookup table.
         // This mechanism gives the generated code a place to lookup function addresses
         // to prevent the need to back patch between functions.
-        module.pimpl()->func_table()[i] = reinterpret_cast<ModuleFunc>(f->code());
+        module.pimpl()->func_table()[i] = reinterpret_cast<ModuleFunc>(symbol.fragment()->code());
+    }
+}
+
+// Assembles one function of a module that is still being compiled, so that
+// the compiler can free the function's LIR as soon as this returns. The
+// module must already be marked as assembled so that AssembleModule()
+// leaves it alone.
+// module: the module being compiled.
+// index: the index of the function in the module's symbols and function table.
+// code_alloc: the CodeAlloc that the function's native code is written to.
+// Throws: if the function fails to assemble.
+void VirtualMachineImpl::AssembleFunction(Module& module, size_t index, CodeAlloc& code_alloc) {
+    ModuleImplSymbol& symbol = module.pimpl()->symbols_vector().at(index);
+
+    GS_ASSERT_FALSE(symbol.fragment() == NULL, "NULL fragment in assembler");
+
+    // Everything that the Assembler allocates is freed along with this
+    // Allocator once the function's code is in the CodeAlloc.
+    Allocator alloc;
+    Assembler assm(
+        code_alloc,
+        this->common_resources_.alloc(),
+        alloc,
+        &this->log_control_,
+        this->common_resources_.config());
+
+    // Probably a bug if this happens.
+    if (!AssembleSymbol(assm, alloc, symbol)) {
+        THROW_EXCEPTION(1, 1, STATUS_ASSEMBLER_DIED);
     }
+
+    module.pimpl()->func_table()[index] = reinterpret_cast<ModuleFunc>(symbol.fragment()->code());
+
+    // Only the code is needed from here on.
+    symbol.fragment()->lirbuf = NULL;
+}
+
+// Assembles one function's fragment to native code.
+// assm: the Assembler to use.
+// alloc: Allocator for temporary data used while assembling.
+// symbol: the function to assemble.
+// Returns: true if the function was assembled, or false if the Assembler failed.
+bool VirtualMachineImpl::AssembleSymbol(Assembler& assm, Allocator& alloc, ModuleImplSymbol& symbol) {
+
+    // Allow unoptimized builds in the future??
+    const bool optimize = true;
+
+    Fragment* f = symbol.fragment();
+
+    // Set the ABI now to be sure that it matches the expected value.
+    f->lirbuf->abi = AbiKind::ABI_CDECL;
+
+    // Create an instruction printer if in NJ_VERBOSE (Debug Configuration).
+#ifdef NJ_VERBOSE
+    if (common_resources_.verbose_asm()) {
+        std::cout << "Symbol: "
+            << symbol.symbol_name()
+            << std::endl;
+    }
+
+    LInsPrinter p(alloc, 1024);
+    f->lirbuf->printer = &p;
+#endif
+
+    // Assemble LIR to native code.
+    assm.compile(f, alloc, optimize verbose_only(, &p));
+
+    return assm.error() == AssmError::None;
 }
 
 // TODO: replace this with a legit function call mechanism.
@@ -162,6 +179,11 @@ int VirtualMachineImpl::HackyRunScriptMainInt(Module& module) {
             // TODO: exception for this:
             GS_ASSERT_TRUE(*symbol.symbol() == TYPE_INT, "Invalid type in main function");
 
+            // Its body was skipped, so running it would return a default value.
+            if (!symbol.parsed()) {
+                THROW_EXCEPTION(1, 1, STATUS_UNPARSED_FUNCTION);
+            }
+
             // Call the hacky main function.
             typedef int(GS_CDECL *MainFunction)();
             return reinterpret_cast<MainFunction>(symbol.fragment()->code())();
@@ -187,6 +209,11 @@ float VirtualMachineImpl::HackyRunScriptMainFloat(Module& module) {
             // TODO: exception for this:
             GS_ASSERT_TRUE(*symbol.symbol() == TYPE_FLOAT, "Invalid type in main function");
 
+            // Its body was skipped, so running it would return a default value.
+            if (!symbol.parsed()) {
+                THROW_EXCEPTION(1, 1, STATUS_UNPARSED_FUNCTION);
+            }
+
             // Call the hacky main function.
             typedef float(GS_CDECL *MainFunction)();
             return reinterpret_cast<MainFunction>(symbol.fragment()->code())();
@@ -212,6 +239,11 @@ char VirtualMachineImpl::HackyRunScriptMainChar(Module& module) {
             // TODO: exception for this:
             GS_ASSERT_TRUE(*symbol.symbol() == TYPE_INT8, "Invalid type in main function");
 
+            // Its body was skipped, so running it would return a default value.
+            if (!symbol.parsed()) {
+                THROW_EXCEPTION(1, 1, STATUS_UNPARSED_FUNCTION);
+            }
+
             // Call the hacky main function.
             typedef int(GS_CDECL *MainFunction)();
             return (char)reinterpret_cast<MainFunction>(symbol.fragment()->code())();
@@ -237,6 +269,11 @@ bool VirtualMachineImpl::HackyRunScriptMainBool(Module& module) {
             // TODO: exception for this:
             GS_ASSERT_TRUE(*symbol.symbol() == TYPE_BOOL, "Invalid type in main function");
 
+            // Its body was skipped, so running it would return a default value.
+            if (!symbol.parsed()) {
+                THROW_EXCEPTION(1, 1, STATUS_UNPARSED_FUNCTION);
+            }
+
             // Call the hacky main function.
             typedef int(GS_CDECL *MainFunction)();
             return reinterpret_cast<MainFunction>(symbol.fragment()->code())();
@@ -0,0 +1,51 @@
+// Gunderscript-2 Private Virtual Machine Implementation
+// (C) 2016 Christian Gunderman
+
+#ifndef GUNDERSCRIPT_VIRTUAL_MACHINEIMPL__H__
+#define GUNDERSCRIPT_VIRTUAL_MACHINEIMPL__H__
+
+#include "gunderscript/virtual_machine.h"
+
+#include "common_resourcesimpl.h"
+#include "moduleimpl.h"
+
+#include "nanojit.h"
+
+using namespace nanojit;
+
+namespace gunderscript {
+
+// Virtual Machine Private Implementation.
+class VirtualMachineImpl {
+public:
+    VirtualMachineImpl(CommonResourcesImpl& common_resources) 
+        : code_alloc_(&common_resources.config()), common_resources_(common_resources) {
+        // Setup Nanojit Log control logging if in NJ_VERBOSE (Debug configuration).
+#ifdef NJ_VERBOSE
+        this->log_control_.lcbits = common_resources.verbose_asm() ? LC_ReadLIR | LC_Native : 0;
+#else
+        this->log_control_.lcbits = 0;
+#endif
+    }
+
+    void AssembleModule(Module& module);
+    void AssembleFunction(Module& module, size_t index, CodeAlloc& code_alloc);
+    int HackyRunScriptMainInt(Module& module);
+    float HackyRunScriptMainFloat(Module& module);
+    char HackyRunScriptMainChar(Module& module);
+    bool HackyRunScriptMainBool(Module& module);
+
+private:
+    LogControl* log_control() { return &log_control_; }
+    CodeAlloc& code_alloc() { return code_alloc_; }
+
+    bool AssembleSymbol(Assembler& assm, Allocator& alloc, ModuleImplSymbol& symbol);
+
+    CommonResourcesImpl& common_resources_;
+    LogControl log_control_;
+    CodeAlloc code_alloc_;
+};
+
+} // namespace gunderscript
+
+#endif // GUNDERSCRIPT_VIRTUAL_MACHINEIMPL__H__